@@ -1,6 +1,7 @@
 #pragma once
 
 #include <koda/ranges/views.hpp>
+#include <koda/ranges/word_bit_iterator.hpp>
 #include <koda/utils/concepts.hpp>
 #include <koda/utils/type_dummies.hpp>
 #include <koda/utils/utils.hpp>
@@ -156,9 +157,14 @@ class DecoderInterface {
     constexpr auto operator()(
         BitInputRange auto&& input,
         std::ranges::output_range<InputToken> auto&& output) {
-        return self().Decode(
-            self().Initialize(std::forward<decltype(input)>(input)),
-            std::forward<decltype(output)>(output));
+        if constexpr (WordReadableBitRange<decltype(input)>) {
+            return DecodeWords(std::forward<decltype(input)>(input),
+                               std::forward<decltype(output)>(output));
+        } else {
+            return self().Decode(
+                self().Initialize(std::forward<decltype(input)>(input)),
+                std::forward<decltype(output)>(output));
+        }
     }
 
     constexpr auto operator()(
@@ -179,6 +185,35 @@ class DecoderInterface {
    private:
     constexpr Derived& self() noexcept { return *static_cast<Derived*>(this); }
 
+    // Contiguous input is read through the buffered bit reader, the returned
+    // input range is converted back to the original bit iterators
+    constexpr auto DecodeWords(
+        WordReadableBitRange auto&& input,
+        std::ranges::output_range<InputToken> auto&& output) {
+        auto begin = std::ranges::begin(input);
+        auto end = std::ranges::end(input);
+        using BitIter = decltype(begin);
+
+        if (end.Position()) [[unlikely]] {
+            // Buffered reader cannot stop in the middle of the element
+            auto [in_range, out_range] = self().Decode(
+                self().Initialize(std::ranges::subrange{begin, end}),
+                std::forward<decltype(output)>(output));
+            return CoderResult{std::ranges::begin(in_range), std::move(end),
+                               std::move(out_range)};
+        }
+
+        auto [in_range, out_range] = self().Decode(
+            self().Initialize(std::ranges::subrange{
+                LittleEndianWordInputBitIter{begin.Base(), end.Base(),
+                                             begin.Position()},
+                std::default_sentinel}),
+            std::forward<decltype(output)>(output));
+        auto reader = std::ranges::begin(in_range);
+        return CoderResult{BitIter{reader.Base(), reader.Position()},
+                           std::move(end), std::move(out_range)};
+    }
+
     constexpr auto RemoveCountedIters(
         SpecializationOf<CoderResult> auto&& result) {
         if constexpr (std::ranges::contiguous_range<
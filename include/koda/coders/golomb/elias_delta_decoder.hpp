@@ -0,0 +1,40 @@
+#pragma once
+
+#include <koda/coders/coder.hpp>
+#include <koda/coders/golomb/golomb_token.hpp>
+
+#include <cinttypes>
+
+namespace koda {
+
+template <GolombToken Token>
+class EliasDeltaDecoder
+    : public DecoderInterface<Token, EliasDeltaDecoder<Token>> {
+   public:
+    using token_type = Token;
+
+    constexpr explicit EliasDeltaDecoder() noexcept = default;
+
+    constexpr auto Decode(BitInputRange auto&& input,
+                          std::ranges::output_range<Token> auto&& output);
+
+    constexpr auto Initialize(BitInputRange auto&& input);
+
+   private:
+    enum class Stage : uint8_t { kPrefix, kLength, kValue };
+
+    uint64_t receiver_ = 0;
+    uint8_t received_size_ = 0;
+    uint8_t zeros_ = 0;
+    uint8_t length_ = 0;
+    Stage stage_ = Stage::kPrefix;
+
+    constexpr auto DecodeToken(auto& out_iter, auto iter, const auto& sent);
+
+    constexpr bool DecodeBufferedToken(auto& out_iter,
+                                       BitWordInputIterator auto& iter);
+};
+
+}  // namespace koda
+
+#include <koda/coders/golomb/elias_delta_decoder.tpp>
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <koda/utils/utils.hpp>
+
+#include <algorithm>
+#include <bit>
+
+namespace koda {
+
+template <GolombToken Token>
+constexpr auto EliasDeltaDecoder<Token>::Decode(
+    BitInputRange auto&& input,
+    std::ranges::output_range<Token> auto&& output) {
+    auto in_iter = std::ranges::begin(input);
+    auto in_sent = std::ranges::end(input);
+
+    auto out_iter = std::ranges::begin(output);
+    auto out_sent = std::ranges::end(output);
+
+    while ((in_iter != in_sent) && (out_iter != out_sent)) {
+        if constexpr (BitWordInputIterator<decltype(in_iter)>) {
+            if (!zeros_ && (stage_ == Stage::kPrefix) &&
+                DecodeBufferedToken(out_iter, in_iter)) {
+                continue;
+            }
+        }
+        in_iter = DecodeToken(out_iter, std::move(in_iter), in_sent);
+    }
+
+    return CoderResult{std::move(in_iter), std::move(in_sent),
+                       std::move(out_iter), std::move(out_sent)};
+}
+
+template <GolombToken Token>
+constexpr auto EliasDeltaDecoder<Token>::Initialize(
+    BitInputRange auto&& input) {
+    return std::forward<decltype(input)>(input);
+}
+
+template <GolombToken Token>
+constexpr auto EliasDeltaDecoder<Token>::DecodeToken(auto& out_iter, auto iter,
+                                                     const auto& sent) {
+    for (; (stage_ == Stage::kPrefix) && (iter != sent); ++iter) {
+        if (*iter) {
+            stage_ = Stage::kLength;
+        } else {
+            ++zeros_;
+        }
+    }
+
+    if (stage_ == Stage::kLength) {
+        iter = ReadBits(std::move(iter), sent, receiver_, received_size_,
+                        zeros_);
+        if (received_size_ != zeros_) {
+            return iter;
+        }
+        length_ = (uint64_t{1} << zeros_) | ReverseBits(receiver_, zeros_);
+        receiver_ = received_size_ = 0;
+        stage_ = Stage::kValue;
+    }
+
+    if (stage_ == Stage::kValue) {
+        iter = ReadBits(std::move(iter), sent, receiver_, received_size_,
+                        length_ - 1);
+        if (received_size_ == length_ - 1) {
+            const uint64_t value = (uint64_t{1} << (length_ - 1)) |
+                                   ReverseBits(receiver_, length_ - 1);
+            *out_iter++ = static_cast<Token>(value - 1);
+            receiver_ = received_size_ = zeros_ = 0;
+            stage_ = Stage::kPrefix;
+        }
+    }
+    return iter;
+}
+
+template <GolombToken Token>
+constexpr bool EliasDeltaDecoder<Token>::DecodeBufferedToken(
+    auto& out_iter, BitWordInputIterator auto& iter) {
+    const uint8_t window = std::min(iter.Available(), iter.MaxPeekLength());
+    const uint64_t bits = iter.Peek(window);
+
+    // Code words of tokens up to 32 bits are at most 43 bits long, so the
+    // length and the value are both decoded after a single zero count
+    const uint8_t zeros = std::countr_zero(bits);
+    if (!bits || (2 * zeros + 1 > window)) {
+        return false;
+    }
+    const uint64_t length =
+        (uint64_t{1} << zeros) | ReverseBits(bits >> (zeros + 1), zeros);
+    const uint64_t size = 2 * zeros + length;
+    if (size > window) {
+        return false;
+    }
+
+    const uint64_t value =
+        (uint64_t{1} << (length - 1)) |
+        ReverseBits(bits >> (2 * zeros + 1), length - 1);
+    iter.Consume(size);
+    *out_iter++ = static_cast<Token>(value - 1);
+    return true;
+}
+
+}  // namespace koda
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <koda/coders/coder.hpp>
+#include <koda/coders/golomb/golomb_token.hpp>
+
+#include <cinttypes>
+
+namespace koda {
+
+/// Elias delta code of the token increased by one so zero is also
+/// encodable. The number of value bits is stored with the Elias gamma code
+/// and followed by the value bits without the leading one, all of them
+/// emitted from the most significant bit
+template <GolombToken Token>
+class EliasDeltaEncoder
+    : public EncoderInterface<Token, EliasDeltaEncoder<Token>> {
+   public:
+    using token_type = Token;
+
+    constexpr explicit EliasDeltaEncoder() noexcept = default;
+
+    constexpr float TokenBitSize(Token token) const;
+
+    constexpr auto Encode(InputRange<Token> auto&& input,
+                          BitOutputRange auto&& output);
+
+    constexpr auto Flush(BitOutputRange auto&& output);
+
+   private:
+    // Zeros terminated with the leading one of the length
+    uint64_t prefix_ = 0;
+    uint8_t prefix_size_ = 0;
+    uint64_t suffix_ = 0;
+    uint8_t suffix_size_ = 0;
+
+    constexpr auto EncodeTokens(InputRange<Token> auto&& input, auto iter,
+                                auto sentinel);
+
+    constexpr auto FlushEmitter(auto output_iter, const auto& output_sent);
+
+    constexpr void SetEmitter(const Token& token);
+};
+
+}  // namespace koda
+
+#include <koda/coders/golomb/elias_delta_encoder.tpp>
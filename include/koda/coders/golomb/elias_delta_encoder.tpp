@@ -0,0 +1,79 @@
+#pragma once
+
+#include <koda/utils/utils.hpp>
+
+#include <bit>
+
+namespace koda {
+
+template <GolombToken Token>
+constexpr float EliasDeltaEncoder<Token>::TokenBitSize(Token token) const {
+    const auto length = std::bit_width(static_cast<uint64_t>(token) + 1);
+    return 2 * std::bit_width(static_cast<uint64_t>(length)) + length - 2;
+}
+
+template <GolombToken Token>
+constexpr auto EliasDeltaEncoder<Token>::Encode(InputRange<Token> auto&& input,
+                                                BitOutputRange auto&& output) {
+    auto sentinel = std::ranges::end(output);
+    auto iter = FlushEmitter(std::ranges::begin(output), sentinel);
+
+    if (iter == sentinel) {
+        return CoderResult{std::forward<decltype(input)>(input),
+                           std::move(iter), std::move(sentinel)};
+    }
+
+    return EncodeTokens(std::forward<decltype(input)>(input), std::move(iter),
+                        std::move(sentinel));
+}
+
+template <GolombToken Token>
+constexpr auto EliasDeltaEncoder<Token>::Flush(BitOutputRange auto&& output) {
+    auto sentinel = std::ranges::end(output);
+    return std::ranges::subrange{
+        FlushEmitter(std::ranges::begin(output), sentinel), sentinel};
+}
+
+template <GolombToken Token>
+constexpr auto EliasDeltaEncoder<Token>::EncodeTokens(
+    InputRange<Token> auto&& input, auto iter, auto sentinel) {
+    auto input_iter = std::ranges::begin(input);
+    auto input_sent = std::ranges::end(input);
+
+    for (; (iter != sentinel) && (input_iter != input_sent); ++input_iter) {
+        SetEmitter(*input_iter);
+        iter = FlushEmitter(iter, sentinel);
+    }
+
+    return CoderResult{std::move(input_iter), std::move(input_sent),
+                       std::move(iter), std::move(sentinel)};
+}
+
+template <GolombToken Token>
+constexpr auto EliasDeltaEncoder<Token>::FlushEmitter(
+    auto output_iter, const auto& output_sent) {
+    output_iter = WriteBits(std::move(output_iter), output_sent, prefix_,
+                            prefix_size_);
+    if (prefix_size_) {
+        return output_iter;
+    }
+    return WriteBits(std::move(output_iter), output_sent, suffix_,
+                     suffix_size_);
+}
+
+template <GolombToken Token>
+constexpr void EliasDeltaEncoder<Token>::SetEmitter(const Token& token) {
+    const uint64_t value = static_cast<uint64_t>(token) + 1;
+    const uint64_t length = std::bit_width(value);
+    const uint8_t length_bits = std::bit_width(length) - 1;
+    prefix_ = uint64_t{1} << length_bits;
+    prefix_size_ = length_bits + 1;
+    // Length and value bits (both without their leading ones) are joined
+    // into a single word emitted from the most significant bit
+    suffix_size_ = length_bits + length - 1;
+    suffix_ = ReverseBits(
+        (length << (length - 1)) | (value & LowBitsMask<uint64_t>(length - 1)),
+        suffix_size_);
+}
+
+}  // namespace koda
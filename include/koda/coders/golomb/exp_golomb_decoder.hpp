@@ -0,0 +1,43 @@
+#pragma once
+
+#include <koda/coders/coder.hpp>
+#include <koda/coders/golomb/golomb_token.hpp>
+
+#include <cinttypes>
+
+namespace koda {
+
+template <GolombToken Token>
+class ExpGolombDecoder
+    : public DecoderInterface<Token, ExpGolombDecoder<Token>> {
+   public:
+    using token_type = Token;
+
+    constexpr explicit ExpGolombDecoder(uint8_t order = 0) noexcept;
+
+    constexpr auto Decode(BitInputRange auto&& input,
+                          std::ranges::output_range<Token> auto&& output);
+
+    constexpr auto Initialize(BitInputRange auto&& input);
+
+   private:
+    uint64_t receiver_ = 0;
+    uint8_t received_size_ = 0;
+    uint8_t zeros_ = 0;
+    bool prefix_read_ = false;
+    uint8_t order_;
+
+    constexpr auto DecodeToken(auto& out_iter, auto iter, const auto& sent);
+
+    constexpr bool DecodeBufferedToken(auto& out_iter,
+                                       BitWordInputIterator auto& iter);
+
+    constexpr Token MakeToken(uint64_t value_bits, uint8_t length) const;
+};
+
+template <GolombToken Token>
+using EliasGammaDecoder = ExpGolombDecoder<Token>;
+
+}  // namespace koda
+
+#include <koda/coders/golomb/exp_golomb_decoder.tpp>
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <koda/utils/utils.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+
+namespace koda {
+
+template <GolombToken Token>
+constexpr ExpGolombDecoder<Token>::ExpGolombDecoder(uint8_t order) noexcept
+    : order_{order} {
+    assert(order < 32);
+}
+
+template <GolombToken Token>
+constexpr auto ExpGolombDecoder<Token>::Decode(
+    BitInputRange auto&& input,
+    std::ranges::output_range<Token> auto&& output) {
+    auto in_iter = std::ranges::begin(input);
+    auto in_sent = std::ranges::end(input);
+
+    auto out_iter = std::ranges::begin(output);
+    auto out_sent = std::ranges::end(output);
+
+    while ((in_iter != in_sent) && (out_iter != out_sent)) {
+        if constexpr (BitWordInputIterator<decltype(in_iter)>) {
+            if (!zeros_ && !prefix_read_ &&
+                DecodeBufferedToken(out_iter, in_iter)) {
+                continue;
+            }
+        }
+        in_iter = DecodeToken(out_iter, std::move(in_iter), in_sent);
+    }
+
+    return CoderResult{std::move(in_iter), std::move(in_sent),
+                       std::move(out_iter), std::move(out_sent)};
+}
+
+template <GolombToken Token>
+constexpr auto ExpGolombDecoder<Token>::Initialize(BitInputRange auto&& input) {
+    return std::forward<decltype(input)>(input);
+}
+
+template <GolombToken Token>
+constexpr auto ExpGolombDecoder<Token>::DecodeToken(auto& out_iter, auto iter,
+                                                    const auto& sent) {
+    // Leading zeros are counted up to the leading one of the value
+    for (; !prefix_read_ && (iter != sent); ++iter) {
+        if (*iter) {
+            prefix_read_ = true;
+        } else {
+            ++zeros_;
+        }
+    }
+
+    if (prefix_read_) {
+        const uint8_t length = zeros_ + order_;
+        iter = ReadBits(std::move(iter), sent, receiver_, received_size_,
+                        length);
+        if (received_size_ == length) {
+            *out_iter++ = MakeToken(receiver_, length);
+            receiver_ = received_size_ = zeros_ = 0;
+            prefix_read_ = false;
+        }
+    }
+    return iter;
+}
+
+template <GolombToken Token>
+constexpr bool ExpGolombDecoder<Token>::DecodeBufferedToken(
+    auto& out_iter, BitWordInputIterator auto& iter) {
+    const uint8_t window = std::min(iter.Available(), iter.MaxPeekLength());
+    const uint64_t bits = iter.Peek(window);
+
+    // Prefix of the whole code word is found with a single zero count
+    const uint8_t zeros = std::countr_zero(bits);
+    const uint8_t length = zeros + order_;
+    if (!bits || (zeros + 1 + length > iter.Available())) {
+        // Code word is truncated, let the bit by bit path keep the state
+        return false;
+    }
+
+    iter.Consume(zeros + 1);
+    *out_iter++ = MakeToken(iter.ReadBits(length), length);
+    return true;
+}
+
+template <GolombToken Token>
+constexpr Token ExpGolombDecoder<Token>::MakeToken(uint64_t value_bits,
+                                                   uint8_t length) const {
+    // Value bits are stored starting from the most significant one
+    const uint64_t value =
+        (uint64_t{1} << length) | ReverseBits(value_bits, length);
+    return static_cast<Token>(value - (uint64_t{1} << order_));
+}
+
+}  // namespace koda
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <koda/coders/coder.hpp>
+#include <koda/coders/golomb/golomb_token.hpp>
+
+#include <cinttypes>
+
+namespace koda {
+
+/// Exp-Golomb code of the given order. The token increased by 2^order is
+/// preceded by as many zeros as it has bits after the leading one (not
+/// counting the order), the value bits are emitted from the most
+/// significant one
+template <GolombToken Token>
+class ExpGolombEncoder
+    : public EncoderInterface<Token, ExpGolombEncoder<Token>> {
+   public:
+    using token_type = Token;
+
+    constexpr explicit ExpGolombEncoder(uint8_t order = 0) noexcept;
+
+    constexpr float TokenBitSize(Token token) const;
+
+    constexpr auto Encode(InputRange<Token> auto&& input,
+                          BitOutputRange auto&& output);
+
+    constexpr auto Flush(BitOutputRange auto&& output);
+
+   private:
+    // Zeros terminated with the leading one of the value
+    uint64_t prefix_ = 0;
+    uint8_t prefix_size_ = 0;
+    uint64_t suffix_ = 0;
+    uint8_t suffix_size_ = 0;
+    uint8_t order_;
+
+    constexpr auto EncodeTokens(InputRange<Token> auto&& input, auto iter,
+                                auto sentinel);
+
+    constexpr auto FlushEmitter(auto output_iter, const auto& output_sent);
+
+    constexpr void SetEmitter(const Token& token);
+};
+
+/// Elias gamma code of the token increased by one so zero is also
+/// encodable, equal to the Exp-Golomb code of order zero
+template <GolombToken Token>
+using EliasGammaEncoder = ExpGolombEncoder<Token>;
+
+}  // namespace koda
+
+#include <koda/coders/golomb/exp_golomb_encoder.tpp>
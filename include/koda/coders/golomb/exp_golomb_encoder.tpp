@@ -0,0 +1,83 @@
+#pragma once
+
+#include <koda/utils/utils.hpp>
+
+#include <bit>
+#include <cassert>
+
+namespace koda {
+
+template <GolombToken Token>
+constexpr ExpGolombEncoder<Token>::ExpGolombEncoder(uint8_t order) noexcept
+    : order_{order} {
+    assert(order < 32);
+}
+
+template <GolombToken Token>
+constexpr float ExpGolombEncoder<Token>::TokenBitSize(Token token) const {
+    const auto length =
+        std::bit_width(static_cast<uint64_t>(token) + (uint64_t{1} << order_));
+    return 2 * length - 1 - order_;
+}
+
+template <GolombToken Token>
+constexpr auto ExpGolombEncoder<Token>::Encode(InputRange<Token> auto&& input,
+                                               BitOutputRange auto&& output) {
+    auto sentinel = std::ranges::end(output);
+    auto iter = FlushEmitter(std::ranges::begin(output), sentinel);
+
+    if (iter == sentinel) {
+        return CoderResult{std::forward<decltype(input)>(input),
+                           std::move(iter), std::move(sentinel)};
+    }
+
+    return EncodeTokens(std::forward<decltype(input)>(input), std::move(iter),
+                        std::move(sentinel));
+}
+
+template <GolombToken Token>
+constexpr auto ExpGolombEncoder<Token>::Flush(BitOutputRange auto&& output) {
+    auto sentinel = std::ranges::end(output);
+    return std::ranges::subrange{
+        FlushEmitter(std::ranges::begin(output), sentinel), sentinel};
+}
+
+template <GolombToken Token>
+constexpr auto ExpGolombEncoder<Token>::EncodeTokens(
+    InputRange<Token> auto&& input, auto iter, auto sentinel) {
+    auto input_iter = std::ranges::begin(input);
+    auto input_sent = std::ranges::end(input);
+
+    for (; (iter != sentinel) && (input_iter != input_sent); ++input_iter) {
+        SetEmitter(*input_iter);
+        iter = FlushEmitter(iter, sentinel);
+    }
+
+    return CoderResult{std::move(input_iter), std::move(input_sent),
+                       std::move(iter), std::move(sentinel)};
+}
+
+template <GolombToken Token>
+constexpr auto ExpGolombEncoder<Token>::FlushEmitter(auto output_iter,
+                                                     const auto& output_sent) {
+    output_iter = WriteBits(std::move(output_iter), output_sent, prefix_,
+                            prefix_size_);
+    if (prefix_size_) {
+        return output_iter;
+    }
+    return WriteBits(std::move(output_iter), output_sent, suffix_,
+                     suffix_size_);
+}
+
+template <GolombToken Token>
+constexpr void ExpGolombEncoder<Token>::SetEmitter(const Token& token) {
+    const uint64_t value =
+        static_cast<uint64_t>(token) + (uint64_t{1} << order_);
+    const uint8_t length = std::bit_width(value) - 1;
+    prefix_ = uint64_t{1} << (length - order_);
+    prefix_size_ = length - order_ + 1;
+    suffix_ = ReverseBits(value, length);
+    suffix_size_ = length;
+}
+
+}  // namespace koda
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <koda/utils/concepts.hpp>
+
+#include <cinttypes>
+
+namespace koda {
+
+/// Tokens whose Exp-Golomb and Elias code words (with the leading one
+/// stripped) always fit in a single 64-bit word
+template <typename Tp>
+concept GolombToken = UnsignedIntegral<Tp> && (sizeof(Tp) <= sizeof(uint32_t));
+
+}  // namespace koda
@@ -4,6 +4,7 @@
 #include <koda/coders/huffman/huffman_table.hpp>
 #include <koda/collections/forward_list.hpp>
 
+#include <cinttypes>
 #include <memory>
 #include <stdexcept>
 #include <variant>
@@ -16,7 +17,17 @@ class HuffmanDecoder : public DecoderInterface<Token, HuffmanDecoder<Token>> {
    public:
     using token_type = Token;
 
-    constexpr explicit HuffmanDecoder(const HuffmanTable<Token>& table);
+    static constexpr uint8_t kDefaultLookupBits = 11;
+    static constexpr uint8_t kMaxLookupBits = 16;
+
+    /// Besides the tree the decoder builds the lookup table resolving
+    /// up to lookup_bits of the buffered input at once (with the secondary
+    /// tables for codes up to twice as long). If pair_lookup is set then the
+    /// primary table entries also hold the second symbol whenever two short
+    /// code words fit into the lookup
+    constexpr explicit HuffmanDecoder(const HuffmanTable<Token>& table,
+                                      uint8_t lookup_bits = kDefaultLookupBits,
+                                      bool pair_lookup = false);
 
     constexpr HuffmanDecoder(HuffmanDecoder&& other) noexcept = default;
     constexpr HuffmanDecoder(const HuffmanDecoder& other) noexcept = delete;
@@ -41,12 +52,27 @@ class HuffmanDecoder : public DecoderInterface<Token, HuffmanDecoder<Token>> {
         NodeOrLeaf right = nullptr;
     };
 
+    enum class LookupKind : uint8_t { kInvalid, kSingle, kPair, kLink };
+
+    /// Symbols are stored as indices into the tokens table. Links point to the
+    /// secondary table and hold the number of its index bits as the length
+    struct LookupEntry {
+        uint32_t first = 0;
+        uint32_t second = 0;
+        uint8_t length = 0;
+        uint8_t first_length = 0;
+        LookupKind kind = LookupKind::kInvalid;
+    };
+
     using NodePtr = std::unique_ptr<Node>;
     using HuffmanTableEntry = typename HuffmanTable<Token>::entry_type;
     using NodeOrLeaf = Node::NodeOrLeaf;
 
     NodeOrLeaf root_;
     const Node* processed_;
+    std::vector<Token> tokens_;
+    std::vector<LookupEntry> lookup_;
+    uint8_t lookup_bits_ = 0;
 
     class TreeBuilder {
        public:
@@ -77,8 +103,24 @@ class HuffmanDecoder : public DecoderInterface<Token, HuffmanDecoder<Token>> {
         BitInputRange auto&& input,
         std::ranges::output_range<Token> auto&& output);
 
+    constexpr void DecodeWithLookup(auto& input_iter, const auto& input_sent,
+                                    auto& output_iter,
+                                    const auto& output_sent);
+
+    constexpr bool WalkCodeWord(auto& input_iter, const auto& input_sent,
+                                auto& output_iter);
+
     constexpr void ProcessBit(auto& output_iter, const NodeOrLeaf& next);
 
+    constexpr void BuildLookupTable(const HuffmanTable<Token>& table,
+                                    uint8_t lookup_bits);
+
+    constexpr void FillLookupEntries(size_t offset, uint64_t code,
+                                     uint8_t length, size_t table_bits,
+                                     const LookupEntry& entry);
+
+    constexpr void MergeLookupPairs();
+
     static constexpr NodeOrLeaf BuildTree(const HuffmanTable<Token>& table);
 };
 
@@ -1,20 +1,35 @@
 #pragma once
 
+#include <koda/utils/formatted_exception.hpp>
 #include <koda/utils/utils.hpp>
 
+#include <algorithm>
 #include <ranges>
+#include <tuple>
 
 namespace koda {
 
 template <typename Token>
 constexpr HuffmanDecoder<Token>::HuffmanDecoder(
-    const HuffmanTable<Token>& table)
+    const HuffmanTable<Token>& table, uint8_t lookup_bits, bool pair_lookup)
     : root_{BuildTree(table)}, processed_{[](NodeOrLeaf& root) -> const Node* {
           if (NodePtr* node = std::get_if<NodePtr>(&root)) {
               return node->get();
           }
           return nullptr;
-      }(root_)} {}
+      }(root_)} {
+    if (!lookup_bits || lookup_bits > kMaxLookupBits) [[unlikely]] {
+        throw FormattedException{
+            "Lookup bits ({}) have to be in the range [1, {}]", lookup_bits,
+            kMaxLookupBits};
+    }
+    if (processed_) {
+        BuildLookupTable(table, lookup_bits);
+        if (pair_lookup) {
+            MergeLookupPairs();
+        }
+    }
+}
 
 template <typename Token>
 constexpr auto HuffmanDecoder<Token>::Decode(
@@ -50,6 +65,37 @@ constexpr auto HuffmanDecoder<Token>::DecodeNonDirac(
     auto output_iter = std::ranges::begin(output);
     const auto output_sent = std::ranges::end(output);
 
+    if constexpr (BitWordInputIterator<decltype(input_iter)>) {
+        const Node* root = std::get<NodePtr>(root_).get();
+        // Code word interrupted by the previous call is finished bit by bit
+        for (; (processed_ != root) && (input_iter != input_sent) &&
+               (output_iter != output_sent);
+             ++input_iter) {
+            ProcessBit(output_iter,
+                       *input_iter ? processed_->right : processed_->left);
+        }
+        if (processed_ == root) {
+            DecodeWithLookup(input_iter, input_sent, output_iter, output_sent);
+        }
+
+        // Tree is walked over the buffered window instead of the iterator
+        while (output_iter != output_sent) {
+            const uint8_t window =
+                std::min(input_iter.Available(), input_iter.MaxPeekLength());
+            if (!window) {
+                break;
+            }
+            uint64_t bits = input_iter.Peek(window);
+            uint8_t consumed = 0;
+            for (; (consumed != window) && (output_iter != output_sent);
+                 ++consumed, bits >>= 1) {
+                ProcessBit(output_iter,
+                           (bits & 1) ? processed_->right : processed_->left);
+            }
+            input_iter.Consume(consumed);
+        }
+    }
+
     for (; (input_iter != input_sent) && (output_iter != output_sent);
          ++input_iter) {
         if (*input_iter) {
@@ -63,6 +109,58 @@ constexpr auto HuffmanDecoder<Token>::DecodeNonDirac(
                        std::move(output_iter), std::move(output_sent)};
 }
 
+template <typename Token>
+constexpr void HuffmanDecoder<Token>::DecodeWithLookup(
+    auto& input_iter, const auto& input_sent, auto& output_iter,
+    const auto& output_sent) {
+    while (output_iter != output_sent) {
+        LookupEntry entry = lookup_[input_iter.Peek(lookup_bits_)];
+        if (entry.kind == LookupKind::kLink) {
+            entry = lookup_[entry.first +
+                            (input_iter.Peek(lookup_bits_ + entry.length) >>
+                             lookup_bits_)];
+        }
+        if (entry.kind == LookupKind::kInvalid) [[unlikely]] {
+            // Code words longer than the lookup tables are resolved by
+            // walking the tree
+            if (!WalkCodeWord(input_iter, input_sent, output_iter)) {
+                return;
+            }
+            continue;
+        }
+
+        const size_t available = input_iter.Available();
+        if (entry.first_length > available) [[unlikely]] {
+            // Truncated code word is left for the bit by bit decoding
+            return;
+        }
+        *output_iter++ = tokens_[entry.first];
+        if ((entry.kind == LookupKind::kPair) && (entry.length <= available) &&
+            (output_iter != output_sent)) {
+            *output_iter++ = tokens_[entry.second];
+            input_iter.Consume(entry.length);
+        } else {
+            input_iter.Consume(entry.first_length);
+        }
+    }
+}
+
+template <typename Token>
+constexpr bool HuffmanDecoder<Token>::WalkCodeWord(auto& input_iter,
+                                                   const auto& input_sent,
+                                                   auto& output_iter) {
+    const Node* root = std::get<NodePtr>(root_).get();
+    do {
+        if (input_iter == input_sent) {
+            return false;
+        }
+        ProcessBit(output_iter,
+                   *input_iter ? processed_->right : processed_->left);
+        ++input_iter;
+    } while (processed_ != root);
+    return true;
+}
+
 template <typename Token>
 constexpr void HuffmanDecoder<Token>::ProcessBit(auto& output_iter,
                                                  const NodeOrLeaf& next) {
@@ -147,6 +245,97 @@ constexpr void HuffmanDecoder<Token>::TreeBuilder::InsertUnwindingEntry(
     hook = std::move(new_child);
 }
 
+template <typename Token>
+constexpr void HuffmanDecoder<Token>::BuildLookupTable(
+    const HuffmanTable<Token>& table, uint8_t lookup_bits) {
+    size_t max_length = 0;
+    for (const auto& [_, symbol] : table) {
+        max_length = std::max(max_length, symbol.size());
+    }
+    lookup_bits_ = std::min<size_t>(lookup_bits, max_length);
+    lookup_.resize(size_t{1} << lookup_bits_);
+    tokens_.reserve(table.size());
+
+    // Code words are stored in the reading order (first bit is the least
+    // significant one). The ones longer than the primary lookup are placed in
+    // the secondary tables after all of them are sized
+    std::vector<std::tuple<uint64_t, uint8_t, uint32_t>> long_codes;
+    for (const auto& [token, symbol] : table) {
+        const auto index = static_cast<uint32_t>(tokens_.size());
+        tokens_.push_back(token);
+        if (symbol.size() > 2 * lookup_bits_) {
+            continue;
+        }
+
+        uint64_t code = 0;
+        for (size_t i = 0; i < symbol.size(); ++i) {
+            code |= static_cast<uint64_t>(symbol[i]) << i;
+        }
+        const auto length = static_cast<uint8_t>(symbol.size());
+        if (length <= lookup_bits_) {
+            FillLookupEntries(0, code, length, lookup_bits_,
+                              LookupEntry{.first = index,
+                                          .length = length,
+                                          .first_length = length,
+                                          .kind = LookupKind::kSingle});
+            continue;
+        }
+        auto& link = lookup_[code & LowBitsMask<uint64_t>(lookup_bits_)];
+        link.kind = LookupKind::kLink;
+        link.length =
+            std::max<uint8_t>(link.length, length - lookup_bits_);
+        long_codes.emplace_back(code, length, index);
+    }
+
+    const size_t primary_size = lookup_.size();
+    for (size_t i = 0; i < primary_size; ++i) {
+        if (lookup_[i].kind == LookupKind::kLink) {
+            lookup_[i].first = static_cast<uint32_t>(lookup_.size());
+            lookup_.resize(lookup_.size() + (size_t{1} << lookup_[i].length));
+        }
+    }
+    for (const auto& [code, length, index] : long_codes) {
+        const LookupEntry link =
+            lookup_[code & LowBitsMask<uint64_t>(lookup_bits_)];
+        FillLookupEntries(link.first, code >> lookup_bits_,
+                          length - lookup_bits_, link.length,
+                          LookupEntry{.first = index,
+                                      .length = length,
+                                      .first_length = length,
+                                      .kind = LookupKind::kSingle});
+    }
+}
+
+template <typename Token>
+constexpr void HuffmanDecoder<Token>::FillLookupEntries(
+    size_t offset, uint64_t code, uint8_t length, size_t table_bits,
+    const LookupEntry& entry) {
+    // Entry is repeated for every combination of the bits following the code
+    for (size_t index = code; index < (size_t{1} << table_bits);
+         index += size_t{1} << length) {
+        lookup_[offset + index] = entry;
+    }
+}
+
+template <typename Token>
+constexpr void HuffmanDecoder<Token>::MergeLookupPairs() {
+    // Entries are visited in the descending order so the second symbol is
+    // always taken from the entry that has not been merged yet
+    for (size_t index = size_t{1} << lookup_bits_; index--;) {
+        LookupEntry& entry = lookup_[index];
+        if (entry.kind != LookupKind::kSingle) {
+            continue;
+        }
+        const LookupEntry next = lookup_[index >> entry.length];
+        if ((next.kind == LookupKind::kSingle) &&
+            (entry.length + next.length <= lookup_bits_)) {
+            entry.second = next.first;
+            entry.length += next.length;
+            entry.kind = LookupKind::kPair;
+        }
+    }
+}
+
 template <typename Token>
 /*static*/ constexpr HuffmanDecoder<Token>::NodeOrLeaf
 HuffmanDecoder<Token>::BuildTree(const HuffmanTable<Token>& table) {
@@ -3,7 +3,10 @@
 #include <koda/coders/coder.hpp>
 #include <koda/coders/huffman/huffman_table.hpp>
 
-#include <optional>
+#include <cinttypes>
+#include <limits>
+#include <variant>
+#include <vector>
 
 namespace koda {
 
@@ -12,15 +15,14 @@ class HuffmanEncoder : public EncoderInterface<Token, HuffmanEncoder<Token>> {
    public:
     using token_type = Token;
 
-    constexpr explicit HuffmanEncoder(HuffmanTable<Token> table);
+    constexpr explicit HuffmanEncoder(const HuffmanTable<Token>& table);
 
     constexpr HuffmanEncoder(HuffmanEncoder&& other) noexcept = default;
-    constexpr HuffmanEncoder(const HuffmanEncoder& other) noexcept = delete;
+    constexpr HuffmanEncoder(const HuffmanEncoder& other) = default;
 
     constexpr HuffmanEncoder& operator=(HuffmanEncoder&& other) noexcept =
         default;
-    constexpr HuffmanEncoder& operator=(const HuffmanEncoder& other) noexcept =
-        delete;
+    constexpr HuffmanEncoder& operator=(const HuffmanEncoder& other) = default;
 
     constexpr float TokenBitSize(Token token) const;
 
@@ -32,15 +34,40 @@ class HuffmanEncoder : public EncoderInterface<Token, HuffmanEncoder<Token>> {
     constexpr ~HuffmanEncoder() = default;
 
    private:
-    using BitIterator = std::ranges::iterator_t<std::vector<bool>>;
-    using BitSentinel = std::ranges::sentinel_t<std::vector<bool>>;
-    using BitRange = std::pair<BitIterator, BitSentinel>;
+    static constexpr uint8_t kMissingLength =
+        std::numeric_limits<uint8_t>::max();
+    static constexpr size_t kMaxDenseTableSize = 1 << 16;
+    static constexpr bool kHasDenseTable =
+        std::integral<Token> && !std::same_as<Token, bool>;
 
-    HuffmanTable<Token> table_;
-    std::optional<BitRange> state_;
+    /// Code word stored in the emission order so its first bit is the least
+    /// significant one
+    struct CodeWord {
+        uint64_t code = 0;
+        uint8_t length = kMissingLength;
+    };
 
-    constexpr auto EncodeToken(const Token& token, auto output_iter,
-                               const auto& output_sent);
+    using DenseOffsetTp =
+        std::conditional_t<kHasDenseTable, Token, std::monostate>;
+
+    // Integral tokens spanning a small enough range are looked up in the
+    // dense array, the map is used otherwise
+    std::vector<CodeWord> dense_codes_;
+    [[no_unique_address]] DenseOffsetTp dense_offset_ = {};
+    Map<Token, CodeWord> codes_;
+    uint64_t emitter_ = 0;
+    uint8_t emitter_size_ = 0;
+
+    constexpr bool BuildDenseTable(const HuffmanTable<Token>& table);
+
+    constexpr const CodeWord& FindCodeWord(const Token& token) const;
+
+    constexpr auto FlushEmitter(auto output_iter, const auto& output_sent);
+
+    constexpr void SetEmitter(const Token& token);
+
+    static constexpr CodeWord MakeCodeWord(const Token& token,
+                                           const std::vector<bool>& symbol);
 
     [[noreturn]] constexpr void ThrowException(Token token) const;
 };
@@ -3,74 +3,139 @@
 #include <koda/utils/formatted_exception.hpp>
 #include <koda/utils/utils.hpp>
 
+#include <stdexcept>
+
 namespace koda {
 
 template <typename Token>
-constexpr HuffmanEncoder<Token>::HuffmanEncoder(HuffmanTable<Token> table)
-    : table_{std::move(table)} {}
+constexpr HuffmanEncoder<Token>::HuffmanEncoder(
+    const HuffmanTable<Token>& table) {
+    if (BuildDenseTable(table)) {
+        return;
+    }
+    for (const auto& [token, symbol] : table) {
+        codes_.Emplace(token, MakeCodeWord(token, symbol));
+    }
+}
 
 template <typename Token>
 constexpr float HuffmanEncoder<Token>::TokenBitSize(Token token) const {
-    if (auto iter = table_.Find(token); iter != table_.end()) [[likely]] {
-        return iter->second.size();
-    }
-    ThrowException(token);
+    return FindCodeWord(token).length;
 }
 
 template <typename Token>
 constexpr auto HuffmanEncoder<Token>::Encode(InputRange<Token> auto&& input,
                                              BitOutputRange auto&& output) {
-    auto out = Flush(std::forward<decltype(output)>(output));
-    if (!state_) {
-        auto in_iter = std::ranges::begin(input);
-        auto in_sent = std::ranges::end(input);
-        auto out_iter = std::ranges::begin(out);
-        auto out_sent = std::ranges::end(out);
-
-        for (; (in_iter != in_sent) && (out_iter != out_sent); ++in_iter) {
-            out_iter = EncodeToken(*in_iter, out_iter, out_sent);
-        }
+    auto out_sent = std::ranges::end(output);
+    auto out_iter = FlushEmitter(std::ranges::begin(output), out_sent);
 
-        return CoderResult{std::move(in_iter), std::move(in_sent),
+    if (emitter_size_) {
+        return CoderResult{std::forward<decltype(input)>(input),
                            std::move(out_iter), std::move(out_sent)};
     }
-    return CoderResult{std::forward<decltype(input)>(input), std::move(out)};
+
+    auto in_iter = std::ranges::begin(input);
+    auto in_sent = std::ranges::end(input);
+
+    for (; (in_iter != in_sent) && (out_iter != out_sent); ++in_iter) {
+        SetEmitter(*in_iter);
+        out_iter = FlushEmitter(std::move(out_iter), out_sent);
+    }
+
+    return CoderResult{std::move(in_iter), std::move(in_sent),
+                       std::move(out_iter), std::move(out_sent)};
 }
 
 template <typename Token>
 constexpr auto HuffmanEncoder<Token>::Flush(BitOutputRange auto&& output) {
-    if (state_) {
-        auto& token_iter = state_->first;
-        const auto& token_sent = state_->second;
-
-        auto out_iter = std::ranges::begin(output);
-        auto out_sent = std::ranges::end(output);
-        for (; (token_iter != token_sent) && (out_iter != out_sent);
-             ++token_iter, ++out_iter) {
-            *out_iter = *token_iter;
+    auto sentinel = std::ranges::end(output);
+    return std::ranges::subrange{
+        FlushEmitter(std::ranges::begin(output), sentinel), sentinel};
+}
+
+template <typename Token>
+constexpr bool HuffmanEncoder<Token>::BuildDenseTable(
+    const HuffmanTable<Token>& table) {
+    if constexpr (kHasDenseTable) {
+        using UnsignedTp = std::make_unsigned_t<Token>;
+
+        if (table.empty()) {
+            return false;
+        }
+        const Token first = table.begin()->first;
+        const Token last = table.rbegin()->first;
+        // Map keeps the tokens sorted so the span is never negative
+        const auto span = static_cast<UnsignedTp>(
+            static_cast<UnsignedTp>(last) - static_cast<UnsignedTp>(first));
+        if (span >= kMaxDenseTableSize) {
+            return false;
         }
 
-        if (token_iter == token_sent) {
-            state_ = std::nullopt;
+        dense_offset_ = first;
+        dense_codes_.resize(static_cast<size_t>(span) + 1);
+        for (const auto& [token, symbol] : table) {
+            dense_codes_[static_cast<UnsignedTp>(
+                static_cast<UnsignedTp>(token) -
+                static_cast<UnsignedTp>(first))] = MakeCodeWord(token, symbol);
         }
-        return std::ranges::subrange{std::move(out_iter), std::move(out_sent)};
+        return true;
+    } else {
+        return false;
     }
-    return AsSubrange(std::forward<decltype(output)>(output));
 }
 
 template <typename Token>
-constexpr auto HuffmanEncoder<Token>::EncodeToken(const Token& token,
-                                                  auto output_iter,
-                                                  const auto& output_sent) {
-    auto symbol_iter = table_.Find(token);
-    if (symbol_iter == table_.end()) [[unlikely]] {
-        ThrowException(token);
+constexpr const HuffmanEncoder<Token>::CodeWord&
+HuffmanEncoder<Token>::FindCodeWord(const Token& token) const {
+    if constexpr (kHasDenseTable) {
+        using UnsignedTp = std::make_unsigned_t<Token>;
+
+        if (!dense_codes_.empty()) {
+            // Tokens preceding the offset wrap around to the large indices
+            const auto index = static_cast<UnsignedTp>(
+                static_cast<UnsignedTp>(token) -
+                static_cast<UnsignedTp>(dense_offset_));
+            if (index < dense_codes_.size() &&
+                dense_codes_[index].length != kMissingLength) [[likely]] {
+                return dense_codes_[index];
+            }
+            ThrowException(token);
+        }
+    }
+    if (auto iter = codes_.Find(token); iter != codes_.end()) [[likely]] {
+        return iter->second;
     }
-    state_ = std::pair{symbol_iter->second.begin(), symbol_iter->second.end()};
+    ThrowException(token);
+}
 
-    auto [res_iter, _] =
-        Flush(std::ranges::subrange{std::move(output_iter), output_sent});
-    return res_iter;
+template <typename Token>
+constexpr auto HuffmanEncoder<Token>::FlushEmitter(auto output_iter,
+                                                   const auto& output_sent) {
+    return WriteBits(std::move(output_iter), output_sent, emitter_,
+                     emitter_size_);
+}
+
+template <typename Token>
+constexpr void HuffmanEncoder<Token>::SetEmitter(const Token& token) {
+    const CodeWord& word = FindCodeWord(token);
+    emitter_ = word.code;
+    emitter_size_ = word.length;
+}
+
+template <typename Token>
+/*static*/ constexpr HuffmanEncoder<Token>::CodeWord
+HuffmanEncoder<Token>::MakeCodeWord(const Token& token,
+                                    const std::vector<bool>& symbol) {
+    if (symbol.size() > std::numeric_limits<uint64_t>::digits) [[unlikely]] {
+        throw FormattedException{
+            "Token ({}) code word is longer than the supported 64 bits",
+            token};
+    }
+    CodeWord word{.length = static_cast<uint8_t>(symbol.size())};
+    for (size_t i = 0; i < symbol.size(); ++i) {
+        word.code |= static_cast<uint64_t>(symbol[i]) << i;
+    }
+    return word;
 }
 
 template <typename Token>
@@ -15,6 +15,40 @@ template <typename Token, std::integral CountTp>
 [[nodiscard]] constexpr HuffmanTable<Token> MakeHuffmanTable(
     const Map<Token, CountTp>& count);
 
+/// Computes only the huffman code lengths of the tokens. Uses the linear
+/// two-queue construction over flat arrays so it is cheap enough to be run
+/// for every block of the data
+template <typename Token, std::integral CountTp>
+[[nodiscard]] constexpr Map<Token, size_t> MakeHuffmanCodeLengths(
+    const Map<Token, CountTp>& count);
+
+/// Builds the canonical huffman table whose code words are at most
+/// max_code_length bits long. If the regular huffman code exceeds the limit
+/// then the optimal limited code lengths are computed with the package-merge
+/// algorithm
+template <typename Token, std::integral CountTp>
+[[nodiscard]] constexpr HuffmanTable<Token> MakeHuffmanTable(
+    const Map<Token, CountTp>& count, size_t max_code_length);
+
+/// Returns the length of the longest code word in the table
+template <typename Token>
+[[nodiscard]] constexpr size_t HuffmanMaxCodeLength(
+    const HuffmanTable<Token>& table);
+
+/// Builds the canonical huffman table (see MakeCanonicalHuffmanTable
+/// overload below) from the code lengths given by MakeHuffmanCodeLengths
+template <typename Token, std::integral CountTp>
+[[nodiscard]] constexpr HuffmanTable<Token> MakeCanonicalHuffmanTable(
+    const Map<Token, CountTp>& count);
+
+/// Returns the canonical code with the same code lengths as the given table.
+/// Code words are ordered by their length and then by their token, each one
+/// being the successor of the previous one (extended with zeros when its
+/// length grows). Such codes are fully described by their lengths
+template <typename Token>
+[[nodiscard]] constexpr HuffmanTable<Token> MakeCanonicalHuffmanTable(
+    const HuffmanTable<Token>& table);
+
 }  // namespace koda
 
 #include <koda/coders/huffman/huffman_table.tpp>
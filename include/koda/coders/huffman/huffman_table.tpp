@@ -1,7 +1,13 @@
 #pragma once
 
 #include <koda/collections/forward_list.hpp>
+#include <koda/utils/formatted_exception.hpp>
 
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
 #include <variant>
 
 namespace koda {
@@ -216,6 +222,168 @@ class MakeHuffmanTableFn {
     }
 };
 
+/// Computes the huffman code lengths with the two-queue algorithm. Leaves
+/// are sorted once and the internal nodes are created with the nondecreasing
+/// weights, so both of them form the sorted queues and the two lightest
+/// nodes are always at their fronts. Nodes live in the flat arrays (leaves
+/// first, internal nodes in the creation order) linked only by the parent
+/// indices, therefore the depths are resolved by a single reverse pass.
+/// Lengths are returned in the map order
+template <typename Token, std::integral CountTp>
+constexpr std::vector<size_t> HuffmanCodeLengths(
+    const Map<Token, CountTp>& count) {
+    const size_t leaves = count.size();
+    std::vector<size_t> lengths(leaves, 0);
+    if (leaves < 2) {
+        return lengths;
+    }
+
+    std::vector<std::pair<CountTp, size_t>> sorted;
+    sorted.reserve(leaves);
+    for (size_t index = 0; const auto& [_, occurences] : count) {
+        sorted.emplace_back(occurences, index++);
+    }
+    std::ranges::sort(sorted);
+
+    std::vector<CountTp> weights(2 * leaves - 1);
+    std::vector<size_t> parents(2 * leaves - 1);
+    for (size_t i = 0; i < leaves; ++i) {
+        weights[i] = sorted[i].first;
+    }
+
+    size_t leaf = 0;
+    size_t node = leaves;
+    size_t next = leaves;
+    auto pop_lightest = [&]() {
+        // Leaves are preferred on ties as they result in shallower trees
+        if ((leaf < leaves) &&
+            ((node == next) || (weights[leaf] <= weights[node]))) {
+            return leaf++;
+        }
+        return node++;
+    };
+    for (; next < weights.size(); ++next) {
+        const size_t first = pop_lightest();
+        const size_t second = pop_lightest();
+        weights[next] = weights[first] + weights[second];
+        parents[first] = parents[second] = next;
+    }
+
+    // Root is the last node, every other node has its parent created later
+    std::vector<size_t> depths(weights.size(), 0);
+    for (size_t i = weights.size() - 1; i--;) {
+        depths[i] = depths[parents[i]] + 1;
+    }
+    for (size_t i = 0; i < leaves; ++i) {
+        lengths[sorted[i].second] = depths[i];
+    }
+    return lengths;
+}
+
+/// Increments the code word treating its first bit as the most significant
+/// one. Returns false if the code word consisted only of ones
+constexpr bool IncrementCodeWord(std::vector<bool>& code) {
+    for (auto bit = code.rbegin(); bit != code.rend(); ++bit) {
+        if (!*bit) {
+            *bit = true;
+            return true;
+        }
+        *bit = false;
+    }
+    return false;
+}
+
+/// Assigns the canonical codes with the given lengths to the keys of the
+/// map (lengths are given in the map order)
+template <typename Token, typename ValueTp>
+constexpr HuffmanTable<Token> AssignCanonicalCodes(
+    const Map<Token, ValueTp>& tokens, const std::vector<size_t>& lengths) {
+    // The map is already sorted by tokens so the order of equally long code
+    // words is preserved by ordering them by their position
+    std::vector<std::pair<size_t, size_t>> order;
+    order.reserve(lengths.size());
+    for (size_t i = 0; i < lengths.size(); ++i) {
+        order.emplace_back(lengths[i], i);
+    }
+    std::ranges::sort(order);
+
+    std::vector<typename Map<Token, ValueTp>::const_iterator> entries;
+    entries.reserve(tokens.size());
+    for (auto iter = tokens.begin(); iter != tokens.end(); ++iter) {
+        entries.push_back(iter);
+    }
+
+    HuffmanTable<Token> canonical;
+    std::vector<bool> code;
+    for (const auto& [length, index] : order) {
+        if (!canonical.empty() && !IncrementCodeWord(code)) [[unlikely]] {
+            throw FormattedException{
+                "Given code lengths do not describe a prefix code"};
+        }
+        code.resize(length, false);
+        canonical.Emplace(entries[index]->first, code);
+    }
+    return canonical;
+}
+
+/// Computes the optimal code lengths limited to max_code_length with the
+/// package-merge algorithm. Each level merges the sorted leaves with the
+/// packages made of pairs of the previous level items. The code length of a
+/// token is the number of times its leaf is used by the first 2n - 2 items of
+/// the last level. Since the packages are formed from the consecutive items,
+/// used items always form a prefix of each level so they are counted without
+/// keeping the package contents. Lengths are returned in the map order
+template <typename Token, std::integral CountTp>
+constexpr std::vector<size_t> PackageMergeCodeLengths(
+    const Map<Token, CountTp>& count, size_t max_code_length) {
+    struct Item {
+        CountTp weight;
+        // Index of the token or the package if it is equal to the kPackage
+        size_t leaf;
+    };
+
+    static constexpr size_t kPackage = std::numeric_limits<size_t>::max();
+
+    std::vector<Item> leaves;
+    leaves.reserve(count.size());
+    for (size_t index = 0; const auto& [_, occurences] : count) {
+        leaves.emplace_back(occurences, index++);
+    }
+    std::ranges::sort(leaves, {}, &Item::weight);
+
+    std::vector<std::vector<Item>> levels{leaves};
+    for (size_t level = 1; level < max_code_length; ++level) {
+        const auto& previous = levels.back();
+        std::vector<Item> current;
+        current.reserve(leaves.size() + previous.size() / 2);
+        auto leaf = leaves.begin();
+        for (size_t i = 0; i + 1 < previous.size(); i += 2) {
+            const CountTp weight = previous[i].weight + previous[i + 1].weight;
+            for (; (leaf != leaves.end()) && (leaf->weight <= weight); ++leaf) {
+                current.push_back(*leaf);
+            }
+            current.emplace_back(weight, kPackage);
+        }
+        current.insert(current.end(), leaf, leaves.end());
+        levels.push_back(std::move(current));
+    }
+
+    std::vector<size_t> lengths(count.size(), 0);
+    size_t used = 2 * count.size() - 2;
+    for (const auto& level : levels | std::views::reverse) {
+        size_t packages = 0;
+        for (size_t i = 0; i < used; ++i) {
+            if (level[i].leaf == kPackage) {
+                ++packages;
+            } else {
+                ++lengths[level[i].leaf];
+            }
+        }
+        used = 2 * packages;
+    }
+    return lengths;
+}
+
 }  // namespace details
 
 template <typename Token, std::integral CountTp>
@@ -227,4 +395,66 @@ template <typename Token, std::integral CountTp>
     return details::MakeHuffmanTableFn{count}.table();
 }
 
+template <typename Token, std::integral CountTp>
+[[nodiscard]] constexpr HuffmanTable<Token> MakeCanonicalHuffmanTable(
+    const Map<Token, CountTp>& count) {
+    if (count.empty()) [[unlikely]] {
+        throw std::logic_error{"Given count map is empty"};
+    }
+    return details::AssignCanonicalCodes(count,
+                                         details::HuffmanCodeLengths(count));
+}
+
+template <typename Token>
+[[nodiscard]] constexpr HuffmanTable<Token> MakeCanonicalHuffmanTable(
+    const HuffmanTable<Token>& table) {
+    std::vector<size_t> lengths;
+    lengths.reserve(table.size());
+    for (const auto& [_, symbol] : table) {
+        lengths.push_back(symbol.size());
+    }
+    return details::AssignCanonicalCodes(table, lengths);
+}
+
+template <typename Token, std::integral CountTp>
+[[nodiscard]] constexpr HuffmanTable<Token> MakeHuffmanTable(
+    const Map<Token, CountTp>& count, size_t max_code_length) {
+    if (count.empty()) [[unlikely]] {
+        throw std::logic_error{"Given count map is empty"};
+    }
+    auto lengths = details::HuffmanCodeLengths(count);
+    // Package-merge is run only if the regular code exceeds the limit
+    if (std::ranges::max(lengths) > max_code_length) {
+        if (static_cast<size_t>(std::bit_width(count.size() - 1)) >
+            max_code_length) [[unlikely]] {
+            throw FormattedException{
+                "Tokens ({}) cannot be described by codes up to {} bits long",
+                count.size(), max_code_length};
+        }
+        lengths = details::PackageMergeCodeLengths(count, max_code_length);
+    }
+    return details::AssignCanonicalCodes(count, lengths);
+}
+
+template <typename Token, std::integral CountTp>
+[[nodiscard]] constexpr Map<Token, size_t> MakeHuffmanCodeLengths(
+    const Map<Token, CountTp>& count) {
+    Map<Token, size_t> lengths;
+    auto token = count.begin();
+    for (const size_t length : details::HuffmanCodeLengths(count)) {
+        lengths.Emplace((token++)->first, length);
+    }
+    return lengths;
+}
+
+template <typename Token>
+[[nodiscard]] constexpr size_t HuffmanMaxCodeLength(
+    const HuffmanTable<Token>& table) {
+    size_t max_length = 0;
+    for (const auto& [_, symbol] : table) {
+        max_length = std::max(max_length, symbol.size());
+    }
+    return max_length;
+}
+
 }  // namespace koda
@@ -4,6 +4,7 @@
 #include <koda/coders/coder_traits.hpp>
 #include <koda/coders/lz77/lz77_intermediate_token.hpp>
 #include <koda/collections/fused_dictionary_and_buffer.hpp>
+#include <koda/collections/match_finder.hpp>
 #include <koda/collections/search_binary_tree.hpp>
 #include <koda/utils/concepts.hpp>
 
@@ -18,7 +19,7 @@ namespace details {
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
 class Lz77EncoderBase {
    public:
     constexpr explicit Lz77EncoderBase(
@@ -35,10 +36,20 @@ class Lz77EncoderBase {
 
     [[nodiscard]] constexpr auto&& auxiliary_encoder(this auto&& self);
 
+    [[nodiscard]] constexpr auto&& match_finder(this auto&& self);
+
+    /// Matches shorter than the good length are deferred by one position and
+    /// a lone symbol is encoded instead if the next position yields a longer
+    /// match. Zero (default) commits every match immediately. Has to be
+    /// chosen before the first symbol is encoded
+    constexpr void set_lazy_good_length(size_t lazy_good_length) noexcept;
+
+    [[nodiscard]] constexpr size_t lazy_good_length() const noexcept;
+
    protected:
     using SequenceView = typename FusedDictionaryAndBuffer<Token>::SequenceView;
     using IMToken = Lz77IntermediateToken<Token>;
-    using Match = typename SearchBinaryTree<Token>::RepeatitionMarker;
+    using Match = RepeatitionMarker;
     using AuxTraits = CoderTraits<AuxiliaryEncoder>;
 
     struct FusedDictAndBufferInfo {
@@ -46,15 +57,28 @@ class Lz77EncoderBase {
         std::optional<size_t> cyclic_buffer_size;
     };
 
+    struct DeferredMatch {
+        Token symbol;
+        IMToken match_token;
+    };
+
     std::variant<FusedDictionaryAndBuffer<Token>, FusedDictAndBufferInfo>
         dictionary_and_buffer_;
-    SearchBinaryTree<Token> search_tree_;
+    Finder match_finder_;
     std::optional<IMToken> queued_token_ = std::nullopt;
     uint16_t match_count_ = 0;
+    size_t lazy_good_length_ = 0;
+    std::optional<DeferredMatch> deferred_match_ = std::nullopt;
     [[no_unique_address]] AuxiliaryEncoder auxiliary_encoder_;
 
     constexpr auto InitializeBuffer(InputRange<Token> auto&& input);
 
+    // Expired strings of the lazily pruned finders still point into the
+    // window so their period cannot exceed its part retained behind the
+    // dictionary
+    constexpr void ValidateExpiryPeriod(
+        const FusedDictionaryAndBuffer<Token>& dict) const;
+
     constexpr auto FlushQueue(BitOutputRange auto&& output);
 
     constexpr auto EncodeIntermediateToken(IMToken&& token,
@@ -65,18 +89,21 @@ class Lz77EncoderBase {
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator = std::allocator<Token>>
+          typename Allocator = std::allocator<Token>,
+          MatchFinder<Token> Finder = SearchBinaryTree<Token>>
 class Lz77Encoder;
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
-class Lz77Encoder<Token, AuxiliaryEncoder, Allocator>
-    : public EncoderInterface<Token,
-                              Lz77Encoder<Token, AuxiliaryEncoder, Allocator>>,
-      private details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator> {
-    using Base = details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>;
+class Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>
+    : public EncoderInterface<
+          Token, Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>>,
+      private details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator,
+                                       Finder> {
+    using Base =
+        details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator, Finder>;
 
    public:
     using token_type = Token;
@@ -89,14 +116,19 @@ class Lz77Encoder<Token, AuxiliaryEncoder, Allocator>
     constexpr auto Flush(BitOutputRange auto&& output);
 
     using Base::auxiliary_encoder;
+    using Base::lazy_good_length;
+    using Base::match_finder;
+    using Base::set_lazy_good_length;
 
-    friend class details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>;
+    friend class details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator,
+                                          Finder>;
 
    private:
     using SequenceView = Base::SequenceView;
     using IMToken = Base::IMToken;
     using Match = Base::Match;
     using AuxTraits = Base::AuxTraits;
+    using DeferredMatch = Base::DeferredMatch;
 
     constexpr auto EncodeData(InputRange<Token> auto&& input,
                               BitOutputRange auto&& output);
@@ -106,12 +138,20 @@ class Lz77Encoder<Token, AuxiliaryEncoder, Allocator>
     constexpr auto EncodeTokenOrMatch(SequenceView buffer, const Match& match,
                                       BitOutputRange auto&& output);
 
+    constexpr auto EncodeLazily(SequenceView buffer, SequenceView look_ahead,
+                                BitOutputRange auto&& output);
+
+    constexpr auto EncodeDeferredMatch(BitOutputRange auto&& output);
+
+    constexpr IMToken MakeIntermediateToken(SequenceView buffer,
+                                            const Match& match) const;
+
     constexpr auto PeformEncodigStep(FusedDictionaryAndBuffer<Token>& dict,
                                      SequenceView buffer,
                                      SequenceView look_ahead,
                                      BitOutputRange auto&& output);
 
-    constexpr void TryToRemoveStringFromSearchTree(
+    constexpr void TryToRemoveStringFromMatchFinder(
         FusedDictionaryAndBuffer<Token>& dict);
 
     constexpr std::pair<SequenceView, SequenceView> GetBufferAndLookAhead(
@@ -120,13 +160,15 @@ class Lz77Encoder<Token, AuxiliaryEncoder, Allocator>
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
-class Lz77Encoder<Token, AuxiliaryEncoder, Allocator>
-    : public EncoderInterface<Token,
-                              Lz77Encoder<Token, AuxiliaryEncoder, Allocator>>,
-      private details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator> {
-    using Base = details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>;
+class Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>
+    : public EncoderInterface<
+          Token, Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>>,
+      private details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator,
+                                       Finder> {
+    using Base =
+        details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator, Finder>;
 
    public:
     using token_type = Token;
@@ -149,8 +191,10 @@ class Lz77Encoder<Token, AuxiliaryEncoder, Allocator>
     constexpr auto Flush(BitOutputRange auto&& output);
 
     using Base::auxiliary_encoder;
+    using Base::match_finder;
 
-    friend class details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>;
+    friend class details::Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator,
+                                          Finder>;
 
    private:
     using SequenceView = Base::SequenceView;
@@ -178,7 +222,8 @@ class Lz77Encoder<Token, AuxiliaryEncoder, Allocator>
     constexpr std::pair<const Token&, SequenceView> GetTokenAndLookAhead(
         FusedDictionaryAndBuffer<Token>& dict) const;
 
-    constexpr void AddStringToSearchTree(FusedDictionaryAndBuffer<Token>& dict);
+    constexpr void AddStringToMatchFinder(
+        FusedDictionaryAndBuffer<Token>& dict);
 
     constexpr auto FlushData(BitOutputRange auto&& output);
 };
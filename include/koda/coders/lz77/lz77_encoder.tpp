@@ -1,6 +1,7 @@
 #pragma once
 
 #include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/utils/formatted_exception.hpp>
 #include <koda/utils/utils.hpp>
 
 namespace koda {
@@ -9,20 +10,22 @@ namespace details {
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>::Lz77EncoderBase(
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator,
+                          Finder>::Lz77EncoderBase(
     size_t dictionary_size, size_t look_ahead_size,
     AuxiliaryEncoder auxiliary_encoder,
     std::optional<size_t> cyclic_buffer_size, const Allocator& allocator)
     : dictionary_and_buffer_{FusedDictAndBufferInfo{
           dictionary_size, std::move(cyclic_buffer_size)}},
-      search_tree_{look_ahead_size, allocator},
+      match_finder_{look_ahead_size, allocator},
       auxiliary_encoder_{std::move(auxiliary_encoder)} {}
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>::Lz77EncoderBase(
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator,
+                          Finder>::Lz77EncoderBase(
     size_t dictionary_size, size_t look_ahead_size,
     std::optional<size_t> cyclic_buffer_size, const Allocator& allocator)
     requires std::is_default_constructible_v<AuxiliaryEncoder>
@@ -31,46 +34,96 @@ constexpr Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>::Lz77EncoderBase(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
 [[nodiscard]] constexpr auto&&
-Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>::auxiliary_encoder(
+Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator, Finder>::auxiliary_encoder(
     this auto&& self) {
     return std::forward_like<decltype(self)>(self.auxiliary_encoder_);
 }
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
+[[nodiscard]] constexpr auto&&
+Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator, Finder>::match_finder(
+    this auto&& self) {
+    return std::forward_like<decltype(self)>(self.match_finder_);
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr void Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator, Finder>::
+    set_lazy_good_length(size_t lazy_good_length) noexcept {
+    lazy_good_length_ = lazy_good_length;
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+[[nodiscard]] constexpr size_t
+Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator, Finder>::lazy_good_length()
+    const noexcept {
+    return lazy_good_length_;
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
 constexpr auto
-Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>::InitializeBuffer(
+Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator, Finder>::InitializeBuffer(
     InputRange<Token> auto&& input) {
     // buffer also stores one suffix symbol that is not used during match lookup
     // but is used to construct an intermediate token for the longest match!
-    const size_t buffer_size = 1 + search_tree_.string_size();
+    const size_t buffer_size = 1 + match_finder_.string_size();
 
     auto [dict_size, cyclic_buffer_size] =
         std::get<FusedDictAndBufferInfo>(dictionary_and_buffer_);
 
+    // Finders keeping the nodes in slabs can have them allocated at once
+    if constexpr (requires { match_finder_.reserve(size_t{}); }) {
+        match_finder_.reserve(dict_size);
+    }
+
     if constexpr (std::ranges::sized_range<decltype(input)>) {
         dictionary_and_buffer_ = FusedDictionaryAndBuffer{
             dict_size, input | std::views::take(buffer_size),
-            std::move(cyclic_buffer_size), search_tree_.get_allocator()};
+            std::move(cyclic_buffer_size), match_finder_.get_allocator()};
     } else {
         std::vector<Token> init_view{std::from_range,
                                      input | std::views::take(buffer_size)};
 
         dictionary_and_buffer_ = FusedDictionaryAndBuffer{
             dict_size, init_view, std::move(cyclic_buffer_size),
-            search_tree_.get_allocator()};
+            match_finder_.get_allocator()};
     }
+    ValidateExpiryPeriod(
+        std::get<FusedDictionaryAndBuffer<Token>>(dictionary_and_buffer_));
 
     return input | std::views::drop(buffer_size);
 }
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr auto Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>::FlushQueue(
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr void Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator,
+                               Finder>::ValidateExpiryPeriod(
+    const FusedDictionaryAndBuffer<Token>& dict) const {
+    if constexpr (requires { match_finder_.expiry_period(); }) {
+        if (match_finder_.expiry_period() > dict.retained_size()) [[unlikely]] {
+            throw FormattedException{
+                "Expiry period ({}) exceeds the part of the window retained "
+                "behind the dictionary ({})",
+                match_finder_.expiry_period(), dict.retained_size()};
+        }
+    }
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto
+Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator, Finder>::FlushQueue(
     BitOutputRange auto&& output) {
     auto [input_range, output_range] = auxiliary_encoder_.Encode(
         std::ranges::subrange{&(*queued_token_), std::next(&(*queued_token_))},
@@ -83,10 +136,11 @@ constexpr auto Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>::FlushQueue(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
 constexpr auto
-Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>::EncodeIntermediateToken(
-    IMToken&& token, BitOutputRange auto&& output) {
+Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator,
+                Finder>::EncodeIntermediateToken(IMToken&& token,
+                                                 BitOutputRange auto&& output) {
     auto [input_range, output_range] = auxiliary_encoder_.Encode(
         std::ranges::subrange{&token, std::next(&token)}, output);
     // Token has not been encoded due to the jam in the encoder queue - enque
@@ -101,9 +155,9 @@ Lz77EncoderBase<Token, AuxiliaryEncoder, Allocator>::EncodeIntermediateToken(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
-constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Flush(
+constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::Flush(
     BitOutputRange auto&& output) {
     return this->auxiliary_encoder_.Flush(
         FlushData(std::forward<decltype(output)>(output)));
@@ -111,9 +165,9 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Flush(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
-constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Encode(
+constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::Encode(
     InputRange<Token> auto&& input, BitOutputRange auto&& output) {
     if (std::holds_alternative<typename Base::FusedDictAndBufferInfo>(
             this->dictionary_and_buffer_)) {
@@ -124,9 +178,10 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Encode(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
-constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
+constexpr auto
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeData(
     InputRange<Token> auto&& input, BitOutputRange auto&& output) {
     [[assume(std::holds_alternative<FusedDictionaryAndBuffer<Token>>(
         this->dictionary_and_buffer_))]];
@@ -150,7 +205,7 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
         auto [buffer, look_ahead] = GetBufferAndLookAhead(dict);
         out_range =
             PeformEncodigStep(dict, buffer, look_ahead, std::move(out_range));
-        this->search_tree_.AddString(look_ahead);
+        this->match_finder_.AddString(look_ahead);
         dict.AddSymbolToBuffer(*input_iter);
     }
     return CoderResult{std::move(input_iter), std::move(input_sent),
@@ -159,62 +214,127 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
 constexpr auto
-Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeTokenOrMatch(
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeTokenOrMatch(
     SequenceView buffer, const Match& match, BitOutputRange auto&& output) {
+    this->match_count_ = match.match_length;
+    return this->EncodeIntermediateToken(
+        MakeIntermediateToken(buffer, match),
+        std::forward<decltype(output)>(output));
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+    requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
+constexpr auto
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeLazily(
+    SequenceView buffer, SequenceView look_ahead,
+    BitOutputRange auto&& output) {
+    auto& deferred = this->deferred_match_;
+    const Match match = this->match_finder_.FindMatch(look_ahead);
+
+    if (deferred) {
+        if (match.match_length <= deferred->match_token.match_length()) {
+            return EncodeDeferredMatch(std::forward<decltype(output)>(output));
+        }
+        // Longer match starts at the current position so the deferred one
+        // is replaced by a lone symbol and the new match is deferred instead
+        IMToken symbol_token{deferred->symbol};
+        deferred =
+            DeferredMatch{buffer[0], MakeIntermediateToken(buffer, match)};
+        return this->EncodeIntermediateToken(
+            std::move(symbol_token), std::forward<decltype(output)>(output));
+    }
+
+    if (match.match_length && (match.match_length < this->lazy_good_length_)) {
+        deferred =
+            DeferredMatch{buffer[0], MakeIntermediateToken(buffer, match)};
+        return AsSubrange(output);
+    }
+    return EncodeTokenOrMatch(buffer, match,
+                              std::forward<decltype(output)>(output));
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+    requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
+constexpr auto
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeDeferredMatch(
+    BitOutputRange auto&& output) {
+    IMToken match_token = this->deferred_match_->match_token;
+    this->deferred_match_ = std::nullopt;
+
+    // Deferred match also covers the current position
+    this->match_count_ = match_token.match_length() - 1;
+    return this->EncodeIntermediateToken(
+        std::move(match_token), std::forward<decltype(output)>(output));
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+    requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
+constexpr typename Lz77Encoder<Token, AuxiliaryEncoder, Allocator,
+                               Finder>::IMToken
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::MakeIntermediateToken(
+    SequenceView buffer, const Match& match) const {
     // buffer is one symbol longer than the actual look-ahead buffer
-    auto suffix_token = buffer[match.match_length];
-    IMToken symbol_token{
-        suffix_token,
+    return IMToken{
+        buffer[match.match_length],
         static_cast<typename IMToken::Position>(match.match_position),
         static_cast<typename IMToken::Length>(match.match_length)};
-
-    this->match_count_ = match.match_length;
-    return this->EncodeIntermediateToken(
-        std::move(symbol_token), std::forward<decltype(output)>(output));
 }
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
 constexpr auto
-Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::PeformEncodigStep(
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::PeformEncodigStep(
     FusedDictionaryAndBuffer<Token>& dict, SequenceView buffer,
     SequenceView look_ahead, BitOutputRange auto&& output) {
+    if (this->lazy_good_length_ && !this->match_count_) {
+        auto new_output = EncodeLazily(buffer, look_ahead, std::move(output));
+        TryToRemoveStringFromMatchFinder(dict);
+        return new_output;
+    }
+
     if (!this->match_count_) {
-        auto new_output =
-            EncodeTokenOrMatch(buffer, this->search_tree_.FindMatch(look_ahead),
-                               std::move(output));
-        TryToRemoveStringFromSearchTree(dict);
+        auto new_output = EncodeTokenOrMatch(
+            buffer, this->match_finder_.FindMatch(look_ahead),
+            std::move(output));
+        TryToRemoveStringFromMatchFinder(dict);
         return new_output;
     }
 
     --this->match_count_;
-    TryToRemoveStringFromSearchTree(dict);
+    TryToRemoveStringFromMatchFinder(dict);
     return AsSubrange(output);
 }
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
-constexpr void Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::
-    TryToRemoveStringFromSearchTree(FusedDictionaryAndBuffer<Token>& dict) {
+constexpr void Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::
+    TryToRemoveStringFromMatchFinder(FusedDictionaryAndBuffer<Token>& dict) {
     if (dict.full()) {
         auto string = dict.get_oldest_dictionary_full_match();
         string.remove_suffix(1);
-        this->search_tree_.RemoveString(string);
+        this->match_finder_.RemoveString(string);
     }
 }
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
-constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::FlushData(
+constexpr auto
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::FlushData(
     BitOutputRange auto&& output) {
     [[assume(std::holds_alternative<FusedDictionaryAndBuffer<Token>>(
         this->dictionary_and_buffer_))]];
@@ -242,12 +362,14 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::FlushData(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsSymetric)
 constexpr std::pair<
-    typename Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::SequenceView,
-    typename Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::SequenceView>
-Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::GetBufferAndLookAhead(
+    typename Lz77Encoder<Token, AuxiliaryEncoder, Allocator,
+                         Finder>::SequenceView,
+    typename Lz77Encoder<Token, AuxiliaryEncoder, Allocator,
+                         Finder>::SequenceView>
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::GetBufferAndLookAhead(
     FusedDictionaryAndBuffer<Token>& dict) const {
     auto buffer = dict.get_buffer();
     auto look_ahead = buffer;
@@ -257,9 +379,9 @@ Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::GetBufferAndLookAhead(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
-constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Flush(
+constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::Flush(
     BitOutputRange auto&& output) {
     return this->auxiliary_encoder_.Flush(
         FlushData(std::forward<decltype(output)>(output)));
@@ -267,9 +389,9 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Flush(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
-constexpr Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Lz77Encoder(
+constexpr Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::Lz77Encoder(
     size_t dictionary_size, size_t look_ahead_size,
     AuxiliaryEncoder auxiliary_encoder,
     std::optional<size_t> cyclic_buffer_size, const Allocator& allocator)
@@ -278,9 +400,9 @@ constexpr Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Lz77Encoder(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
-constexpr Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Lz77Encoder(
+constexpr Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::Lz77Encoder(
     size_t dictionary_size, size_t look_ahead_size,
     std::optional<size_t> cyclic_buffer_size, const Allocator& allocator)
     requires std::is_default_constructible_v<AuxiliaryEncoder>
@@ -289,9 +411,10 @@ constexpr Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Lz77Encoder(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
-constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::InitializeDict(
+constexpr auto
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::InitializeDict(
     InputRange<Token> auto&& input) {
     [[assume(std::holds_alternative<FusedDictionaryAndBuffer<Token>>(
         this->dictionary_and_buffer_))]];
@@ -306,16 +429,16 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::InitializeDict(
     // for the repeatitions so remove it!
     auto buffer = dict.get_oldest_dictionary_full_match();
     buffer.remove_suffix(1);
-    this->search_tree_.RemoveString(buffer);
+    this->match_finder_.RemoveString(buffer);
 
     return std::ranges::subrange{std::move(iter), std::ranges::end(input)};
 }
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
-constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Encode(
+constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::Encode(
     InputRange<Token> auto&& input, BitOutputRange auto&& output) {
     if (std::holds_alternative<typename Base::FusedDictAndBufferInfo>(
             this->dictionary_and_buffer_)) {
@@ -327,9 +450,10 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::Encode(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
-constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
+constexpr auto
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeData(
     InputRange<Token> auto&& input, BitOutputRange auto&& output) {
     [[assume(std::holds_alternative<FusedDictionaryAndBuffer<Token>>(
         this->dictionary_and_buffer_))]];
@@ -352,8 +476,8 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
 
     for (; (input_iter != input_sent) && !out_range.empty(); ++input_iter) {
         auto [token, look_ahead] = GetTokenAndLookAhead(dict);
-        this->search_tree_.RemoveString(look_ahead);
-        AddStringToSearchTree(dict);
+        this->match_finder_.RemoveString(look_ahead);
+        AddStringToMatchFinder(dict);
         out_range = PeformEncodigStep(dict, token, look_ahead,
                                       std::move(out_range), false);
 
@@ -365,10 +489,10 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
 constexpr auto
-Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::PopulateDictionary(
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::PopulateDictionary(
     InputRange<Token> auto&& input, FusedDictionaryAndBuffer<Token>& dict) {
     auto input_iter = std::ranges::begin(input);
     auto input_sent = std::ranges::end(input);
@@ -376,7 +500,7 @@ Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::PopulateDictionary(
     // Asymetrical mode finds repeatitions in the future so entire dictionary
     // has to be populated before the algorithm even starts working
     for (; !dict.full() && (input_iter != input_sent); ++input_iter) {
-        AddStringToSearchTree(dict);
+        AddStringToMatchFinder(dict);
         dict.AddSymbolToBuffer(*input_iter);
     }
 
@@ -385,15 +509,15 @@ Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::PopulateDictionary(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
 constexpr auto
-Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::PeformEncodigStep(
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::PeformEncodigStep(
     FusedDictionaryAndBuffer<Token>& dict, const Token& token,
     SequenceView look_ahead, BitOutputRange auto&& output, bool tail) {
     if (!this->match_count_) {
         auto new_output = EncodeTokenOrMatch(
-            dict, token, this->search_tree_.FindMatch(look_ahead),
+            dict, token, this->match_finder_.FindMatch(look_ahead),
             std::move(output), tail);
         return new_output;
     }
@@ -404,10 +528,10 @@ Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::PeformEncodigStep(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
 constexpr auto
-Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeTokenOrMatch(
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeTokenOrMatch(
     FusedDictionaryAndBuffer<Token>& dict, const Token& token, Match&& match,
     BitOutputRange auto&& output, bool tail) {
     match.match_position =
@@ -417,7 +541,7 @@ Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeTokenOrMatch(
         match.match_position = 0;
     }
     if (tail && (match.match_length &&
-                 dict.dictionary_size() - this->search_tree_.size() == 2)) {
+                 dict.dictionary_size() - this->match_finder_.size() == 2)) {
         match.match_position -= 2;
     }
 
@@ -432,11 +556,12 @@ Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::EncodeTokenOrMatch(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
-constexpr std::pair<const Token&, typename Lz77Encoder<Token, AuxiliaryEncoder,
-                                                       Allocator>::SequenceView>
-Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::GetTokenAndLookAhead(
+constexpr std::pair<const Token&,
+                    typename Lz77Encoder<Token, AuxiliaryEncoder, Allocator,
+                                         Finder>::SequenceView>
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::GetTokenAndLookAhead(
     FusedDictionaryAndBuffer<Token>& dict) const {
     auto buffer = dict.get_oldest_dictionary_full_match();
     auto look_ahead = buffer;
@@ -446,24 +571,25 @@ Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::GetTokenAndLookAhead(
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
 constexpr void
-Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::AddStringToSearchTree(
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::AddStringToMatchFinder(
     FusedDictionaryAndBuffer<Token>& dict) {
     auto buffer = dict.get_buffer();
     if (!buffer.empty()) {
-        this->search_tree_.AddString(
+        this->match_finder_.AddString(
             {buffer.begin(),
-             std::next(buffer.begin(), this->search_tree_.string_size())});
+             std::next(buffer.begin(), this->match_finder_.string_size())});
     }
 }
 
 template <std::integral Token,
           SizeAwareEncoder<Lz77IntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
     requires(CoderTraits<AuxiliaryEncoder>::IsAsymetric)
-constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::FlushData(
+constexpr auto
+Lz77Encoder<Token, AuxiliaryEncoder, Allocator, Finder>::FlushData(
     BitOutputRange auto&& output) {
     [[assume(std::holds_alternative<FusedDictionaryAndBuffer<Token>>(
         this->dictionary_and_buffer_))]];
@@ -481,14 +607,14 @@ constexpr auto Lz77Encoder<Token, AuxiliaryEncoder, Allocator>::FlushData(
 
     // Remove front buffer
     for (size_t i = 0; !dict.full() && !dict.get_buffer().empty(); ++i) {
-        AddStringToSearchTree(dict);
+        AddStringToMatchFinder(dict);
         dict.AddEndSymbolToBuffer();
     }
 
     while (!dict.empty()) {
         auto [token, look_ahead] = GetTokenAndLookAhead(dict);
-        AddStringToSearchTree(dict);
-        this->search_tree_.RemoveString(look_ahead);
+        AddStringToMatchFinder(dict);
+        this->match_finder_.RemoveString(look_ahead);
         out_range = PeformEncodigStep(dict, token, look_ahead,
                                       std::move(out_range), true);
         dict.AddEndSymbolToBuffer();
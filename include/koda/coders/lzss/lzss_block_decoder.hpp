@@ -0,0 +1,46 @@
+#pragma once
+
+#include <koda/coders/lzss/lzss_frame.hpp>
+
+#include <concepts>
+#include <functional>
+#include <span>
+#include <thread>
+
+namespace koda {
+
+/// Decodes the frame written by the LzssBlockEncoder with the decoders made
+/// by the factory (invoked from several threads at once). Every block is
+/// decoded concurrently into its own slice of the output. Blocks primed from
+/// their predecessors wait until the symbols they are primed with are
+/// decoded, so only the independent blocks are decoded fully in parallel
+template <std::integral Token, std::invocable DecoderFactory>
+class LzssBlockDecoder {
+   public:
+    using token_type = Token;
+    using decoder_type = std::invoke_result_t<const DecoderFactory&>;
+
+    explicit LzssBlockDecoder(
+        DecoderFactory factory,
+        size_t thread_count = std::thread::hardware_concurrency());
+
+    [[nodiscard]] size_t thread_count() const noexcept;
+
+    /// Output has to hold all of the frame symbols, the remaining part of it
+    /// is returned
+    auto Decode(std::span<const uint8_t> frame,
+                std::ranges::random_access_range auto&& output) const
+        requires std::ranges::sized_range<decltype(output)>;
+
+   private:
+    DecoderFactory factory_;
+    size_t thread_count_;
+
+    void DecodeBlock(const LzssFrameHeader& header,
+                     std::span<const uint8_t> frame, auto output_iter,
+                     size_t index) const;
+};
+
+}  // namespace koda
+
+#include <koda/coders/lzss/lzss_block_decoder.tpp>
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/utils/formatted_exception.hpp>
+#include <koda/utils/parallel.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <vector>
+
+namespace koda {
+
+template <std::integral Token, std::invocable DecoderFactory>
+LzssBlockDecoder<Token, DecoderFactory>::LzssBlockDecoder(
+    DecoderFactory factory, size_t thread_count)
+    : factory_{std::move(factory)},
+      // Hardware concurrency is zero when it cannot be determined
+      thread_count_{std::max<size_t>(thread_count, 1)} {}
+
+template <std::integral Token, std::invocable DecoderFactory>
+[[nodiscard]] size_t LzssBlockDecoder<Token, DecoderFactory>::thread_count()
+    const noexcept {
+    return thread_count_;
+}
+
+template <std::integral Token, std::invocable DecoderFactory>
+auto LzssBlockDecoder<Token, DecoderFactory>::Decode(
+    std::span<const uint8_t> frame,
+    std::ranges::random_access_range auto&& output) const
+    requires std::ranges::sized_range<decltype(output)>
+{
+    const auto header = LzssFrameHeader::Read(frame);
+    if (std::ranges::size(output) < header.symbol_count) [[unlikely]] {
+        throw FormattedException{"Output cannot hold the frame ({} symbols)",
+                                 header.symbol_count};
+    }
+
+    auto output_iter = std::ranges::begin(output);
+    std::vector<std::atomic<bool>> finished(header.block_count());
+    std::atomic<bool> failed = false;
+
+    auto mark_finished = [&](size_t index) {
+        finished[index].store(true, std::memory_order_release);
+        finished[index].notify_all();
+    };
+
+    ParallelFor(header.block_count(), thread_count_, [&](size_t index) {
+        // Blocks are taken in order so the ones holding the primer are
+        // already being decoded
+        const size_t block_begin = index * header.block_size;
+        const size_t primer_begin =
+            block_begin - std::min(block_begin, header.priming_size);
+        for (size_t i = primer_begin / header.block_size; i < index; ++i) {
+            finished[i].wait(false, std::memory_order_acquire);
+        }
+
+        try {
+            if (!failed) {
+                DecodeBlock(header, frame, output_iter, index);
+            }
+        } catch (...) {
+            failed = true;
+            mark_finished(index);
+            throw;
+        }
+        mark_finished(index);
+    });
+
+    return std::ranges::subrange{output_iter + header.symbol_count,
+                                 std::ranges::end(output)};
+}
+
+template <std::integral Token, std::invocable DecoderFactory>
+void LzssBlockDecoder<Token, DecoderFactory>::DecodeBlock(
+    const LzssFrameHeader& header, std::span<const uint8_t> frame,
+    auto output_iter, size_t index) const {
+    const size_t block_begin = index * header.block_size;
+    const size_t block_end =
+        std::min(block_begin + header.block_size, header.symbol_count);
+    const size_t primer_begin =
+        block_begin - std::min(block_begin, header.priming_size);
+
+    decoder_type decoder = std::invoke(factory_);
+    decoder.Prime(std::ranges::subrange{output_iter + primer_begin,
+                                        output_iter + block_begin});
+
+    auto payload = frame.subspan(header.block_offset(index),
+                                 header.encoded_block_sizes[index]);
+    auto result =
+        decoder(payload | views::LittleEndianInput,
+                std::ranges::subrange{output_iter + block_begin,
+                                      output_iter + block_end});
+    if (!std::ranges::empty(result.output_range)) [[unlikely]] {
+        throw FormattedException{"Block {} of the frame is truncated", index};
+    }
+}
+
+}  // namespace koda
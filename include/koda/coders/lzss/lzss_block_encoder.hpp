@@ -0,0 +1,57 @@
+#pragma once
+
+#include <koda/coders/lzss/lzss_frame.hpp>
+
+#include <concepts>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace koda {
+
+/// Splits the input into the blocks and encodes them concurrently with the
+/// encoders made by the factory (invoked from several threads at once). Every
+/// block is encoded by its own encoder and written in order into the frame
+/// described by the LzssFrameHeader, so the frame does not depend on the
+/// number of threads. Block payloads are the little endian bit streams
+template <std::integral Token, std::invocable EncoderFactory>
+class LzssBlockEncoder {
+   public:
+    using token_type = Token;
+    using encoder_type = std::invoke_result_t<const EncoderFactory&>;
+
+    static constexpr size_t kDefaultBlockSize = size_t{1} << 20;
+
+    explicit LzssBlockEncoder(
+        EncoderFactory factory, size_t block_size = kDefaultBlockSize,
+        size_t thread_count = std::thread::hardware_concurrency());
+
+    /// Windows of the blocks (but the first one) are primed with the given
+    /// number of the trailing symbols of the previous block. Zero (default)
+    /// makes the blocks independent
+    void set_priming_size(size_t priming_size) noexcept;
+
+    [[nodiscard]] size_t priming_size() const noexcept;
+
+    [[nodiscard]] size_t block_size() const noexcept;
+
+    [[nodiscard]] size_t thread_count() const noexcept;
+
+    auto Encode(std::ranges::random_access_range auto&& input,
+                std::ranges::output_range<uint8_t> auto&& output) const
+        requires std::ranges::sized_range<decltype(input)>;
+
+   private:
+    using EncodedBlock = std::vector<uint8_t>;
+
+    EncoderFactory factory_;
+    size_t block_size_;
+    size_t thread_count_;
+    size_t priming_size_ = 0;
+
+    EncodedBlock EncodeBlock(const auto& input, size_t index) const;
+};
+
+}  // namespace koda
+
+#include <koda/coders/lzss/lzss_block_encoder.tpp>
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/utils/formatted_exception.hpp>
+#include <koda/utils/parallel.hpp>
+
+#include <algorithm>
+
+namespace koda {
+
+template <std::integral Token, std::invocable EncoderFactory>
+LzssBlockEncoder<Token, EncoderFactory>::LzssBlockEncoder(
+    EncoderFactory factory, size_t block_size, size_t thread_count)
+    : factory_{std::move(factory)},
+      block_size_{block_size},
+      // Hardware concurrency is zero when it cannot be determined
+      thread_count_{std::max<size_t>(thread_count, 1)} {
+    if (!block_size_) [[unlikely]] {
+        throw FormattedException{"Block size has to be greater than 0"};
+    }
+}
+
+template <std::integral Token, std::invocable EncoderFactory>
+void LzssBlockEncoder<Token, EncoderFactory>::set_priming_size(
+    size_t priming_size) noexcept {
+    priming_size_ = priming_size;
+}
+
+template <std::integral Token, std::invocable EncoderFactory>
+[[nodiscard]] size_t LzssBlockEncoder<Token, EncoderFactory>::priming_size()
+    const noexcept {
+    return priming_size_;
+}
+
+template <std::integral Token, std::invocable EncoderFactory>
+[[nodiscard]] size_t LzssBlockEncoder<Token, EncoderFactory>::block_size()
+    const noexcept {
+    return block_size_;
+}
+
+template <std::integral Token, std::invocable EncoderFactory>
+[[nodiscard]] size_t LzssBlockEncoder<Token, EncoderFactory>::thread_count()
+    const noexcept {
+    return thread_count_;
+}
+
+template <std::integral Token, std::invocable EncoderFactory>
+auto LzssBlockEncoder<Token, EncoderFactory>::Encode(
+    std::ranges::random_access_range auto&& input,
+    std::ranges::output_range<uint8_t> auto&& output) const
+    requires std::ranges::sized_range<decltype(input)>
+{
+    LzssFrameHeader header{.symbol_count = std::ranges::size(input),
+                           .block_size = block_size_,
+                           .priming_size = priming_size_};
+
+    std::vector<EncodedBlock> blocks(
+        LzssFrameHeader::BlockCount(header.symbol_count, block_size_));
+    ParallelFor(blocks.size(), thread_count_, [&](size_t index) {
+        blocks[index] = EncodeBlock(input, index);
+    });
+
+    header.encoded_block_sizes.reserve(blocks.size());
+    for (const auto& block : blocks) {
+        header.encoded_block_sizes.push_back(block.size());
+    }
+
+    auto output_sent = std::ranges::end(output);
+    auto output_iter = header.Write(std::ranges::begin(output), output_sent);
+    for (const auto& block : blocks) {
+        for (uint8_t byte : block) {
+            if (output_iter == output_sent) [[unlikely]] {
+                throw FormattedException{
+                    "Output cannot hold the frame ({} bytes)",
+                    header.block_offset(blocks.size())};
+            }
+            *output_iter++ = byte;
+        }
+    }
+    return std::ranges::subrange{std::move(output_iter),
+                                 std::move(output_sent)};
+}
+
+template <std::integral Token, std::invocable EncoderFactory>
+LzssBlockEncoder<Token, EncoderFactory>::EncodedBlock
+LzssBlockEncoder<Token, EncoderFactory>::EncodeBlock(const auto& input,
+                                                     size_t index) const {
+    const size_t block_begin = index * block_size_;
+    const size_t block_end =
+        std::min(block_begin + block_size_, std::ranges::size(input));
+    const size_t primer_begin =
+        block_begin - std::min(block_begin, priming_size_);
+    auto iter = std::ranges::begin(input);
+
+    encoder_type encoder = std::invoke(factory_);
+    encoder.Prime(
+        std::ranges::subrange{iter + primer_begin, iter + block_begin});
+
+    EncodedBlock encoded;
+    encoder(std::ranges::subrange{iter + block_begin, iter + block_end},
+            encoded | views::InsertFromBack | views::LittleEndianOutput)
+        .output_range.begin()
+        .Flush();
+    return encoded;
+}
+
+}  // namespace koda
@@ -1,7 +1,9 @@
 #pragma once
 
 #include <koda/coders/coder.hpp>
+#include <koda/coders/lzss/lzss_dictionary.hpp>
 #include <koda/coders/lzss/lzss_intermediate_token.hpp>
+#include <koda/coders/lzss/lzss_offset_history.hpp>
 #include <koda/collections/fused_dictionary_and_buffer.hpp>
 #include <koda/collections/search_binary_tree.hpp>
 #include <koda/utils/concepts.hpp>
@@ -36,6 +38,16 @@ class LzssDecoder
 
     [[nodiscard]] constexpr auto&& auxiliary_decoder(this auto&& self);
 
+    /// Fills the dictionary with the symbols the encoder has been primed
+    /// with. Has to be called before the first symbol is decoded
+    constexpr void Prime(InputRange<Token> auto&& primer);
+
+    /// Preloads the window with the dictionary the stream has been encoded
+    /// with, its id is checked against the one preceding the encoded tokens
+    /// when the decoder is initialized. Has to be chosen before the first
+    /// symbol is decoded
+    constexpr void set_dictionary(const LzssDictionary<Token>& dictionary);
+
    private:
     using IMToken = LzssIntermediateToken<Token>;
 
@@ -49,6 +61,9 @@ class LzssDecoder
 
     FusedDictionaryAndBuffer<Token> dictionary_;
     std::optional<CachedSequence> cached_sequence_ = std::nullopt;
+    LzssOffsetHistory offset_history_;
+    uint64_t dictionary_id_ = 0;
+    bool receives_dictionary_id_ = false;
     [[no_unique_address]] AuxiliaryDecoder auxiliary_decoder_;
 
     constexpr auto ProcessCachedSequence(
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
 #include <koda/utils/formatted_exception.hpp>
 #include <koda/utils/utils.hpp>
 
@@ -15,9 +16,10 @@ class LzssDecoder<Token, AuxiliaryDecoder, Allocator>::SlidingDecoderView {
     constexpr explicit SlidingDecoderView(
         FusedDictionaryAndBuffer<Token>& dictionary,
         std::optional<CachedSequence>& cached_sequence,
-        RangeTp&& range) noexcept
+        LzssOffsetHistory& offset_history, RangeTp&& range) noexcept
         : dictionary_{dictionary},
           cached_sequence_{cached_sequence},
+          offset_history_{offset_history},
           iterator_{std::ranges::begin(range)},
           sentinel_{std::ranges::end(range)} {}
 
@@ -66,7 +68,7 @@ class LzssDecoder<Token, AuxiliaryDecoder, Allocator>::SlidingDecoderView {
         SlidingDecoderView* parent_;
 
         constexpr void CopySequenceToDictionary(value_type token) {
-            auto [position, length] = *token.get_marker();
+            auto [position, length] = parent_->ResolveMarker(token);
 
             auto sequence = parent_->dictionary_.get_sequence_at_relative_pos(
                 position, length);
@@ -103,9 +105,30 @@ class LzssDecoder<Token, AuxiliaryDecoder, Allocator>::SlidingDecoderView {
    private:
     FusedDictionaryAndBuffer<Token>& dictionary_;
     std::optional<CachedSequence>& cached_sequence_;
+    LzssOffsetHistory& offset_history_;
     std::ranges::iterator_t<RangeTp> iterator_;
     std::ranges::sentinel_t<RangeTp> sentinel_;
 
+    // Repeated offsets are translated back into the explicit positions,
+    // offsets are counted back from the end of the held symbols
+    constexpr auto ResolveMarker(const IMToken& token) {
+        const size_t held_size =
+            dictionary_.dictionary_size() + dictionary_.buffer_size();
+        if (auto marker = token.get_marker()) {
+            offset_history_.Push(held_size - marker->match_position);
+            return *marker;
+        }
+        auto [offset_index, length] = *token.get_repeated_offset();
+        const size_t offset = offset_history_.Promote(offset_index);
+        if (!offset || offset > held_size) [[unlikely]] {
+            throw FormattedException{
+                "Repeated offset ({}) exceeds the decoded sequence ({})",
+                offset, held_size};
+        }
+        return typename IMToken::RepeatitionMarker{
+            static_cast<uint32_t>(held_size - offset), length};
+    }
+
     constexpr bool HasFinished() const noexcept {
         return iterator_ == sentinel_;
     }
@@ -138,7 +161,32 @@ template <std::integral Token,
           typename Allocator>
 constexpr auto LzssDecoder<Token, AuxiliaryDecoder, Allocator>::Initialize(
     BitInputRange auto&& input) {
-    return auxiliary_decoder_.Initialize(std::forward<decltype(input)>(input));
+    auto input_iter = std::ranges::begin(input);
+    auto input_sent = std::ranges::end(input);
+
+    // Dictionary id is written before anything the auxiliary encoder emits
+    // so it is read before the auxiliary decoder is initialized
+    if (receives_dictionary_id_) {
+        uint64_t received_id = 0;
+        uint8_t received_bits = 0;
+        input_iter = ReadBits(std::move(input_iter), input_sent, received_id,
+                              received_bits, LzssDictionary<Token>::kIdBits);
+        if (received_bits != LzssDictionary<Token>::kIdBits) [[unlikely]] {
+            throw FormattedException{
+                "Stream is too short to hold the dictionary id ({} bits)",
+                received_bits};
+        }
+        if (received_id != dictionary_id_) [[unlikely]] {
+            throw FormattedException{
+                "Stream has been encoded with the dictionary {:#x} instead "
+                "of {:#x}",
+                received_id, dictionary_id_};
+        }
+        receives_dictionary_id_ = false;
+    }
+
+    return auxiliary_decoder_.Initialize(
+        std::ranges::subrange{std::move(input_iter), std::move(input_sent)});
 }
 
 template <std::integral Token,
@@ -150,6 +198,27 @@ LzssDecoder<Token, AuxiliaryDecoder, Allocator>::auxiliary_decoder(
     return std::forward_like<decltype(self)>(self.auxiliary_decoder_);
 }
 
+template <std::integral Token,
+          Decoder<LzssIntermediateToken<Token>> AuxiliaryDecoder,
+          typename Allocator>
+constexpr void LzssDecoder<Token, AuxiliaryDecoder, Allocator>::Prime(
+    InputRange<Token> auto&& primer) {
+    for (Token symbol : primer) {
+        dictionary_.AddSymbolToBuffer(symbol);
+    }
+}
+
+template <std::integral Token,
+          Decoder<LzssIntermediateToken<Token>> AuxiliaryDecoder,
+          typename Allocator>
+constexpr void
+LzssDecoder<Token, AuxiliaryDecoder, Allocator>::set_dictionary(
+    const LzssDictionary<Token>& dictionary) {
+    Prime(dictionary.content());
+    dictionary_id_ = dictionary.id();
+    receives_dictionary_id_ = true;
+}
+
 template <std::integral Token,
           Decoder<LzssIntermediateToken<Token>> AuxiliaryDecoder,
           typename Allocator>
@@ -209,7 +278,7 @@ constexpr auto LzssDecoder<Token, AuxiliaryDecoder, Allocator>::ProcessData(
     BitInputRange auto&& input,
     std::ranges::output_range<Token> auto&& output) {
     SlidingDecoderView decoder_view{
-        dictionary_, cached_sequence_,
+        dictionary_, cached_sequence_, offset_history_,
         std::views::all(std::forward<decltype(output)>(output))};
 
     auto result = auxiliary_decoder_.Decode(
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <koda/utils/concepts.hpp>
+
+#include <cinttypes>
+#include <concepts>
+#include <span>
+#include <vector>
+
+namespace koda {
+
+/// Preset dictionary the windows of the LzssEncoder and LzssDecoder are
+/// preloaded with, so the short inputs can refer to the typical content
+/// right from their beginning. Only the trailing part of the dictionary fits
+/// into the window, the most common content should be placed at its end. The
+/// id identifies the dictionary in the stream and by default is the hash of
+/// its content
+template <std::integral Token>
+class LzssDictionary {
+   public:
+    using IdType = uint32_t;
+
+    static constexpr uint8_t kIdBits = 32;
+
+    constexpr explicit LzssDictionary(InputRange<Token> auto&& content);
+
+    constexpr explicit LzssDictionary(IdType id,
+                                      InputRange<Token> auto&& content);
+
+    [[nodiscard]] constexpr IdType id() const noexcept;
+
+    [[nodiscard]] constexpr std::span<const Token> content() const noexcept;
+
+   private:
+    std::vector<Token> content_;
+    IdType id_;
+
+    // FNV-1a hash of the bytes of the tokens
+    static constexpr IdType HashContent(std::span<const Token> content);
+};
+
+}  // namespace koda
+
+#include <koda/coders/lzss/lzss_dictionary.tpp>
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <climits>
+#include <type_traits>
+
+namespace koda {
+
+template <std::integral Token>
+constexpr LzssDictionary<Token>::LzssDictionary(
+    InputRange<Token> auto&& content)
+    : content_{std::from_range, std::forward<decltype(content)>(content)},
+      id_{HashContent(content_)} {}
+
+template <std::integral Token>
+constexpr LzssDictionary<Token>::LzssDictionary(
+    IdType id, InputRange<Token> auto&& content)
+    : content_{std::from_range, std::forward<decltype(content)>(content)},
+      id_{id} {}
+
+template <std::integral Token>
+[[nodiscard]] constexpr LzssDictionary<Token>::IdType
+LzssDictionary<Token>::id() const noexcept {
+    return id_;
+}
+
+template <std::integral Token>
+[[nodiscard]] constexpr std::span<const Token> LzssDictionary<Token>::content()
+    const noexcept {
+    return content_;
+}
+
+template <std::integral Token>
+/*static*/ constexpr LzssDictionary<Token>::IdType
+LzssDictionary<Token>::HashContent(std::span<const Token> content) {
+    constexpr IdType kOffsetBasis = 2166136261u;
+    constexpr IdType kPrime = 16777619u;
+
+    IdType hash = kOffsetBasis;
+    for (Token token : content) {
+        // Conversion through the unsigned type prevents the sign extension
+        auto value = static_cast<std::make_unsigned_t<Token>>(token);
+        for (size_t i = 0; i < sizeof(Token); ++i, value >>= CHAR_BIT) {
+            hash = (hash ^ static_cast<uint8_t>(value)) * kPrime;
+        }
+    }
+    return hash;
+}
+
+}  // namespace koda
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <koda/coders/coder.hpp>
+#include <koda/coders/lzss/lzss_dictionary.hpp>
 #include <koda/coders/lzss/lzss_intermediate_token.hpp>
+#include <koda/coders/lzss/lzss_offset_history.hpp>
 #include <koda/collections/fused_dictionary_and_buffer.hpp>
+#include <koda/collections/match_finder.hpp>
 #include <koda/collections/search_binary_tree.hpp>
 #include <koda/utils/concepts.hpp>
 
@@ -10,15 +13,30 @@
 #include <memory>
 #include <optional>
 #include <variant>
+#include <vector>
 
 namespace koda {
 
+/// Greedy parsing encodes either the symbol or the longest match found at
+/// the current position, whichever is cheaper per symbol. Optimal parsing
+/// collects the longest matches over a block of positions and encodes the
+/// sequence of symbols and matches (or their prefixes) that covers the block
+/// with the smallest total bit size
+enum class LzssParsing : uint8_t { kGreedy = 0, kOptimal = 1 };
+
+/// Finder is the structure used to look for the repeatitions in the
+/// dictionary, the balanced SearchBinaryTree by default. The HashChain is a
+/// faster alternative that gives up on the short matches. When the auxiliary
+/// encoder has the repeated offsets enabled, greedy parsing without lazy
+/// matching also checks the offsets of the recent matches and encodes the
+/// repeated offset marker if it is cheaper per symbol than the longest match
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator = std::allocator<Token>>
+          typename Allocator = std::allocator<Token>,
+          MatchFinder<Token> Finder = SearchBinaryTree<Token>>
 class LzssEncoder
-    : public EncoderInterface<Token,
-                              LzssEncoder<Token, AuxiliaryEncoder, Allocator>> {
+    : public EncoderInterface<
+          Token, LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>> {
    public:
     using token_type = Token;
 
@@ -41,25 +59,82 @@ class LzssEncoder
 
     [[nodiscard]] constexpr auto&& auxiliary_encoder(this auto&& self);
 
+    [[nodiscard]] constexpr auto&& match_finder(this auto&& self);
+
+    /// Has to be chosen before the first symbol is encoded. Only the greedy
+    /// parsing selects the repeated offsets of the auxiliary encoder
+    constexpr void set_parsing(LzssParsing parsing) noexcept;
+
+    [[nodiscard]] constexpr LzssParsing parsing() const noexcept;
+
+    /// Greedy parsing defers the matches shorter than the good length by one
+    /// position and encodes the symbol instead if the next position yields a
+    /// longer match. Zero (default) commits every match immediately. Has to
+    /// be chosen before the first symbol is encoded and cannot be combined
+    /// with the repeated offsets
+    constexpr void set_lazy_good_length(size_t lazy_good_length) noexcept;
+
+    [[nodiscard]] constexpr size_t lazy_good_length() const noexcept;
+
+    /// Fills the dictionary with the symbols preceding the input without
+    /// encoding them. The decoder has to be primed with the same symbols.
+    /// Has to be called before the first symbol is encoded
+    constexpr void Prime(InputRange<Token> auto&& primer);
+
+    /// Preloads the window with the dictionary and writes its id in front of
+    /// the encoded tokens. The decoder has to be given the same dictionary.
+    /// Has to be chosen before the first symbol is encoded
+    constexpr void set_dictionary(const LzssDictionary<Token>& dictionary);
+
    private:
     using SequenceView = typename FusedDictionaryAndBuffer<Token>::SequenceView;
     using IMToken = LzssIntermediateToken<Token>;
-    using Match = typename SearchBinaryTree<Token>::RepeatitionMarker;
+    using Match = RepeatitionMarker;
+    using RepeatedOffset = typename IMToken::RepeatedOffsetMarker;
 
     struct FusedDictAndBufferInfo {
         size_t dictionary_size;
         std::optional<size_t> cyclic_buffer_size;
     };
 
+    struct ParsingCandidate {
+        Token symbol;
+        Match match;
+    };
+
+    struct ParsingNode {
+        float cost;
+        uint16_t length;
+        bool is_match;
+    };
+
+    // Matches spanning the block boundary are truncated to it
+    static constexpr size_t kParsingBlockSize = 4096;
+
     std::variant<FusedDictionaryAndBuffer<Token>, FusedDictAndBufferInfo>
         dictionary_and_buffer_;
-    SearchBinaryTree<Token> search_tree_;
+    Finder match_finder_;
     std::optional<IMToken> queued_token_ = std::nullopt;
     uint16_t match_count_ = 0;
+    size_t primed_symbols_ = 0;
+    uint64_t dictionary_id_ = 0;
+    uint8_t dictionary_id_bits_ = 0;
+    LzssParsing parsing_ = LzssParsing::kGreedy;
+    size_t lazy_good_length_ = 0;
+    std::optional<ParsingCandidate> deferred_candidate_ = std::nullopt;
+    std::vector<ParsingCandidate> candidates_;
+    std::vector<IMToken> parsed_tokens_;
+    LzssOffsetHistory offset_history_;
     [[no_unique_address]] AuxiliaryEncoder auxiliary_encoder_;
 
     constexpr auto InitializeBuffer(InputRange<Token> auto&& input);
 
+    // Expired strings of the lazily pruned finders still point into the
+    // window so their period cannot exceed its part retained behind the
+    // dictionary
+    constexpr void ValidateExpiryPeriod(
+        const FusedDictionaryAndBuffer<Token>& dict) const;
+
     constexpr auto FlushQueue(BitOutputRange auto&& output);
 
     constexpr auto EncodeData(InputRange<Token> auto&& input,
@@ -70,6 +145,19 @@ class LzssEncoder
     constexpr auto EncodeTokenOrMatch(Token token, const Match& match,
                                       BitOutputRange auto&& output);
 
+    constexpr bool PrefersMatch(Token token, const Match& match) const;
+
+    constexpr bool UsesRepeatedOffsets() const noexcept;
+
+    constexpr auto EncodeWithRepeatedOffsets(
+        FusedDictionaryAndBuffer<Token>& dict, SequenceView look_ahead,
+        const Match& match, BitOutputRange auto&& output);
+
+    constexpr auto EncodeLazily(SequenceView look_ahead,
+                                BitOutputRange auto&& output);
+
+    constexpr auto EncodeDeferredMatch(BitOutputRange auto&& output);
+
     constexpr auto PeformEncodigStep(FusedDictionaryAndBuffer<Token>& dict,
                                      SequenceView look_ahead,
                                      BitOutputRange auto&& output);
@@ -77,7 +165,15 @@ class LzssEncoder
     constexpr auto EncodeIntermediateToken(IMToken&& token,
                                            BitOutputRange auto&& output);
 
-    constexpr void TryToRemoveStringFromSearchTree(
+    constexpr auto CollectCandidate(FusedDictionaryAndBuffer<Token>& dict,
+                                    SequenceView look_ahead,
+                                    BitOutputRange auto&& output);
+
+    constexpr void ParseCandidates();
+
+    constexpr auto FlushParsedTokens(BitOutputRange auto&& output);
+
+    constexpr void TryToRemoveStringFromMatchFinder(
         FusedDictionaryAndBuffer<Token>& dict);
 };
 
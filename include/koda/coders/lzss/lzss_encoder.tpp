@@ -1,25 +1,31 @@
 #pragma once
 
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/utils/formatted_exception.hpp>
 #include <koda/utils/utils.hpp>
 
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
 namespace koda {
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr LzssEncoder<Token, AuxiliaryEncoder, Allocator>::LzssEncoder(
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::LzssEncoder(
     size_t dictionary_size, size_t look_ahead_size,
     AuxiliaryEncoder auxiliary_encoder,
     std::optional<size_t> cyclic_buffer_size, const Allocator& allocator)
     : dictionary_and_buffer_{FusedDictAndBufferInfo{
           dictionary_size, std::move(cyclic_buffer_size)}},
-      search_tree_{look_ahead_size, allocator},
+      match_finder_{look_ahead_size, allocator},
       auxiliary_encoder_{std::move(auxiliary_encoder)} {}
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr LzssEncoder<Token, AuxiliaryEncoder, Allocator>::LzssEncoder(
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::LzssEncoder(
     size_t dictionary_size, size_t look_ahead_size,
     std::optional<size_t> cyclic_buffer_size, const Allocator& allocator)
     requires std::is_default_constructible_v<AuxiliaryEncoder>
@@ -28,17 +34,110 @@ constexpr LzssEncoder<Token, AuxiliaryEncoder, Allocator>::LzssEncoder(
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
 [[nodiscard]] constexpr auto&&
-LzssEncoder<Token, AuxiliaryEncoder, Allocator>::auxiliary_encoder(
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::auxiliary_encoder(
     this auto&& self) {
     return std::forward_like<decltype(self)>(self.auxiliary_encoder_);
 }
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::Flush(
+          typename Allocator, MatchFinder<Token> Finder>
+[[nodiscard]] constexpr auto&&
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::match_finder(
+    this auto&& self) {
+    return std::forward_like<decltype(self)>(self.match_finder_);
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr void
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::set_parsing(
+    LzssParsing parsing) noexcept {
+    parsing_ = parsing;
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+[[nodiscard]] constexpr LzssParsing
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::parsing()
+    const noexcept {
+    return parsing_;
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr void
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::set_lazy_good_length(
+    size_t lazy_good_length) noexcept {
+    lazy_good_length_ = lazy_good_length;
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+[[nodiscard]] constexpr size_t
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::lazy_good_length()
+    const noexcept {
+    return lazy_good_length_;
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr void LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::Prime(
+    InputRange<Token> auto&& primer) {
+    assert(std::holds_alternative<FusedDictAndBufferInfo>(
+               dictionary_and_buffer_) &&
+           "Encoder has to be primed before the first symbol is encoded");
+    if (std::ranges::empty(primer)) {
+        return;
+    }
+
+    auto [dict_size, cyclic_buffer_size] =
+        std::get<FusedDictAndBufferInfo>(dictionary_and_buffer_);
+
+    if constexpr (requires { match_finder_.reserve(size_t{}); }) {
+        match_finder_.reserve(dict_size);
+    }
+
+    auto& dict = dictionary_and_buffer_.template emplace<
+        FusedDictionaryAndBuffer<Token>>(
+        dict_size, match_finder_.string_size(), std::move(cyclic_buffer_size),
+        match_finder_.get_allocator());
+    ValidateExpiryPeriod(dict);
+
+    for (Token symbol : primer) {
+        if (dict.buffer_size() == dict.max_buffer_size()) {
+            auto look_ahead = dict.get_buffer();
+            TryToRemoveStringFromMatchFinder(dict);
+            match_finder_.AddString(look_ahead);
+        }
+        dict.AddSymbolToBuffer(symbol);
+    }
+    // Primer symbols left in the look-ahead are skipped by the encoding steps
+    primed_symbols_ = dict.buffer_size();
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr void
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::set_dictionary(
+    const LzssDictionary<Token>& dictionary) {
+    Prime(dictionary.content());
+    dictionary_id_ = dictionary.id();
+    dictionary_id_bits_ = LzssDictionary<Token>::kIdBits;
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::Flush(
     BitOutputRange auto&& output) {
     return auxiliary_encoder_.Flush(
         FlushData(std::forward<decltype(output)>(output)));
@@ -46,47 +145,83 @@ constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::Flush(
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::Encode(
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::Encode(
     InputRange<Token> auto&& input, BitOutputRange auto&& output) {
+    auto out_range = AsSubrange(std::forward<decltype(output)>(output));
+    if (dictionary_id_bits_) {
+        auto output_iter = WriteBits(std::ranges::begin(out_range),
+                                     std::ranges::end(out_range),
+                                     dictionary_id_, dictionary_id_bits_);
+        out_range = {std::move(output_iter), std::ranges::end(out_range)};
+        if (dictionary_id_bits_) {
+            return CoderResult{std::forward<decltype(input)>(input),
+                               std::move(out_range)};
+        }
+    }
+
     if (std::holds_alternative<FusedDictAndBufferInfo>(
             dictionary_and_buffer_)) {
-        return EncodeData(InitializeBuffer(input), output);
+        return EncodeData(InitializeBuffer(input), std::move(out_range));
     }
-    return EncodeData(input, output);
+    return EncodeData(input, std::move(out_range));
 }
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
 constexpr auto
-LzssEncoder<Token, AuxiliaryEncoder, Allocator>::InitializeBuffer(
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::InitializeBuffer(
     InputRange<Token> auto&& input) {
-    const size_t look_ahead_size = search_tree_.string_size();
+    const size_t look_ahead_size = match_finder_.string_size();
 
     auto [dict_size, cyclic_buffer_size] =
         std::get<FusedDictAndBufferInfo>(dictionary_and_buffer_);
 
+    // Finders keeping the nodes in slabs can have them allocated at once
+    if constexpr (requires { match_finder_.reserve(size_t{}); }) {
+        match_finder_.reserve(dict_size);
+    }
+
     if constexpr (std::ranges::sized_range<decltype(input)>) {
         dictionary_and_buffer_ = FusedDictionaryAndBuffer{
             dict_size, input | std::views::take(look_ahead_size),
-            std::move(cyclic_buffer_size), search_tree_.get_allocator()};
+            std::move(cyclic_buffer_size), match_finder_.get_allocator()};
     } else {
         std::vector<Token> init_view{std::from_range,
                                      input | std::views::take(look_ahead_size)};
 
         dictionary_and_buffer_ = FusedDictionaryAndBuffer{
             dict_size, init_view, std::move(cyclic_buffer_size),
-            search_tree_.get_allocator()};
+            match_finder_.get_allocator()};
     }
+    ValidateExpiryPeriod(
+        std::get<FusedDictionaryAndBuffer<Token>>(dictionary_and_buffer_));
 
     return input | std::views::drop(look_ahead_size);
 }
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::FlushQueue(
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr void
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::ValidateExpiryPeriod(
+    const FusedDictionaryAndBuffer<Token>& dict) const {
+    if constexpr (requires { match_finder_.expiry_period(); }) {
+        if (match_finder_.expiry_period() > dict.retained_size()) [[unlikely]] {
+            throw FormattedException{
+                "Expiry period ({}) exceeds the part of the window retained "
+                "behind the dictionary ({})",
+                match_finder_.expiry_period(), dict.retained_size()};
+        }
+    }
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::FlushQueue(
     BitOutputRange auto&& output) {
     auto [input_range, output_range] = auxiliary_encoder_.Encode(
         std::ranges::subrange{&(*queued_token_), std::next(&(*queued_token_))},
@@ -99,8 +234,9 @@ constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::FlushQueue(
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeData(
     InputRange<Token> auto&& input, BitOutputRange auto&& output) {
     [[assume(std::holds_alternative<FusedDictionaryAndBuffer<Token>>(
         dictionary_and_buffer_))]];
@@ -108,6 +244,11 @@ constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
     auto& dict =
         std::get<FusedDictionaryAndBuffer<Token>>(dictionary_and_buffer_);
 
+    assert((!UsesRepeatedOffsets() ||
+            ((parsing_ == LzssParsing::kGreedy) && !lazy_good_length_)) &&
+           "Repeated offsets are only selected by the greedy parsing without "
+           "the lazy matching");
+
     auto out_range = AsSubrange(std::forward<decltype(output)>(output));
 
     if (queued_token_) {
@@ -118,12 +259,26 @@ constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
         }
     }
 
+    if (!parsed_tokens_.empty()) {
+        out_range = FlushParsedTokens(out_range);
+        if (!parsed_tokens_.empty()) {
+            return CoderResult{std::forward<decltype(input)>(input),
+                               std::move(out_range)};
+        }
+    }
+
     auto input_iter = std::ranges::begin(input);
     auto input_sent = std::ranges::end(input);
+    // Look-ahead of the primed encoder is filled up before the first step
+    for (; (input_iter != input_sent) &&
+           (dict.buffer_size() != dict.max_buffer_size());
+         ++input_iter) {
+        dict.AddSymbolToBuffer(*input_iter);
+    }
     for (; (input_iter != input_sent) && !out_range.empty(); ++input_iter) {
         auto look_ahead = dict.get_buffer();
         out_range = PeformEncodigStep(dict, look_ahead, std::move(out_range));
-        search_tree_.AddString(look_ahead);
+        match_finder_.AddString(look_ahead);
         dict.AddSymbolToBuffer(*input_iter);
     }
     return CoderResult{std::move(input_iter), std::move(input_sent),
@@ -132,15 +287,30 @@ constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::EncodeData(
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
 constexpr auto
-LzssEncoder<Token, AuxiliaryEncoder, Allocator>::EncodeTokenOrMatch(
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeTokenOrMatch(
     Token token, const Match& match, BitOutputRange auto&& output) {
-    IMToken symbol_token{token};
+    if (!PrefersMatch(token, match)) {
+        return EncodeIntermediateToken(IMToken{token},
+                                       std::forward<decltype(output)>(output));
+    }
 
+    IMToken match_token{static_cast<uint32_t>(match.match_position),
+                        static_cast<uint16_t>(match.match_length)};
+    match_count_ = match.match_length - 1;
+    return EncodeIntermediateToken(std::move(match_token),
+                                   std::forward<decltype(output)>(output));
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr bool
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::PrefersMatch(
+    Token token, const Match& match) const {
     if (!match) {
-        return EncodeIntermediateToken(std::move(symbol_token),
-                                       std::forward<decltype(output)>(output));
+        return false;
     }
 
     IMToken match_token{static_cast<uint32_t>(match.match_position),
@@ -148,43 +318,179 @@ LzssEncoder<Token, AuxiliaryEncoder, Allocator>::EncodeTokenOrMatch(
 
     float est_match_bitsize =
         auxiliary_encoder_.TokenBitSize(match_token) / match.match_length;
-    float est_symbol_bitsize = auxiliary_encoder_.TokenBitSize(symbol_token);
+    float est_symbol_bitsize = auxiliary_encoder_.TokenBitSize(IMToken{token});
+
+    return est_symbol_bitsize > est_match_bitsize;
+}
 
-    if (est_symbol_bitsize <= est_match_bitsize) {
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr bool
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::UsesRepeatedOffsets()
+    const noexcept {
+    if constexpr (requires { auxiliary_encoder_.repeated_offsets(); }) {
+        return auxiliary_encoder_.repeated_offsets();
+    }
+    return false;
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::
+    EncodeWithRepeatedOffsets(FusedDictionaryAndBuffer<Token>& dict,
+                              SequenceView look_ahead, const Match& match,
+                              BitOutputRange auto&& output) {
+    // Match positions are relative to the dictionary start so the offsets
+    // are counted back from the end of the dictionary
+    const size_t history_size = dict.dictionary_size();
+    IMToken best_token{look_ahead[0]};
+    float best_bitsize = auxiliary_encoder_.TokenBitSize(best_token);
+    size_t best_length = 1;
+
+    auto consider = [&](IMToken&& token, size_t length) {
+        float bitsize = auxiliary_encoder_.TokenBitSize(token) / length;
+        if (bitsize < best_bitsize) {
+            best_token = std::move(token);
+            best_bitsize = bitsize;
+            best_length = length;
+        }
+    };
+
+    if (match) {
+        consider(IMToken{static_cast<uint32_t>(match.match_position),
+                         static_cast<uint16_t>(match.match_length)},
+                 match.match_length);
+    }
+    for (uint8_t index = 0; index < LzssOffsetHistory::kSize; ++index) {
+        const size_t offset = offset_history_[index];
+        if (!offset || offset > history_size) {
+            continue;
+        }
+        auto sequence = dict.get_sequence_at_relative_pos(
+            history_size - offset, look_ahead.size());
+        if (size_t length = CommonPrefixLength(
+                look_ahead.data(), sequence.data(), look_ahead.size())) {
+            consider(IMToken{RepeatedOffset{index,
+                                            static_cast<uint16_t>(length)}},
+                     length);
+        }
+    }
+
+    if (auto marker = best_token.get_marker()) {
+        offset_history_.Push(history_size - marker->match_position);
+    } else if (auto marker = best_token.get_repeated_offset()) {
+        offset_history_.Promote(marker->offset_index);
+    }
+    match_count_ = best_length - 1;
+    return EncodeIntermediateToken(std::move(best_token),
+                                   std::forward<decltype(output)>(output));
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeLazily(
+    SequenceView look_ahead, BitOutputRange auto&& output) {
+    const Token token = look_ahead[0];
+    const Match match = match_finder_.FindMatch(look_ahead);
+    const bool prefers_match = PrefersMatch(token, match);
+
+    if (deferred_candidate_) {
+        if (!prefers_match ||
+            (match.match_length <= deferred_candidate_->match.match_length)) {
+            return EncodeDeferredMatch(std::forward<decltype(output)>(output));
+        }
+        // Longer match starts at the current position so the deferred one
+        // is replaced by its symbol and the new match is deferred instead
+        IMToken symbol_token{deferred_candidate_->symbol};
+        deferred_candidate_ = ParsingCandidate{token, match};
         return EncodeIntermediateToken(std::move(symbol_token),
                                        std::forward<decltype(output)>(output));
     }
-    match_count_ = match.match_length - 1;
+
+    // Single symbol matches are never deferred since the next position is
+    // not covered by them
+    if (prefers_match && (match.match_length > 1) &&
+        (match.match_length < lazy_good_length_)) {
+        deferred_candidate_ = ParsingCandidate{token, match};
+        return AsSubrange(output);
+    }
+    return EncodeTokenOrMatch(token, match,
+                              std::forward<decltype(output)>(output));
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::EncodeDeferredMatch(
+    BitOutputRange auto&& output) {
+    const Match match = deferred_candidate_->match;
+    deferred_candidate_ = std::nullopt;
+
+    IMToken match_token{static_cast<uint32_t>(match.match_position),
+                        static_cast<uint16_t>(match.match_length)};
+    // Deferred match also covers the current position
+    match_count_ = match.match_length - 2;
     return EncodeIntermediateToken(std::move(match_token),
                                    std::forward<decltype(output)>(output));
 }
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
 constexpr auto
-LzssEncoder<Token, AuxiliaryEncoder, Allocator>::PeformEncodigStep(
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::PeformEncodigStep(
     FusedDictionaryAndBuffer<Token>& dict, SequenceView look_ahead,
     BitOutputRange auto&& output) {
+    if (primed_symbols_) {
+        --primed_symbols_;
+        TryToRemoveStringFromMatchFinder(dict);
+        return AsSubrange(output);
+    }
+
+    if (parsing_ == LzssParsing::kOptimal) {
+        return CollectCandidate(dict, look_ahead,
+                                std::forward<decltype(output)>(output));
+    }
+
+    if (lazy_good_length_ && !match_count_) {
+        auto new_output = EncodeLazily(look_ahead, std::move(output));
+        TryToRemoveStringFromMatchFinder(dict);
+        return new_output;
+    }
+
+    if (!match_count_ && UsesRepeatedOffsets()) {
+        auto new_output = EncodeWithRepeatedOffsets(
+            dict, look_ahead, match_finder_.FindMatch(look_ahead),
+            std::move(output));
+        TryToRemoveStringFromMatchFinder(dict);
+        return new_output;
+    }
+
     if (!match_count_) {
-        auto new_output = EncodeTokenOrMatch(look_ahead[0],
-                                             search_tree_.FindMatch(look_ahead),
-                                             std::move(output));
-        TryToRemoveStringFromSearchTree(dict);
+        auto new_output = EncodeTokenOrMatch(
+            look_ahead[0], match_finder_.FindMatch(look_ahead),
+            std::move(output));
+        TryToRemoveStringFromMatchFinder(dict);
         return new_output;
     }
 
     --match_count_;
-    TryToRemoveStringFromSearchTree(dict);
+    TryToRemoveStringFromMatchFinder(dict);
     return AsSubrange(output);
 }
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
+          typename Allocator, MatchFinder<Token> Finder>
 constexpr auto
-LzssEncoder<Token, AuxiliaryEncoder, Allocator>::EncodeIntermediateToken(
-    IMToken&& token, BitOutputRange auto&& output) {
+LzssEncoder<Token, AuxiliaryEncoder, Allocator,
+            Finder>::EncodeIntermediateToken(IMToken&& token,
+                                             BitOutputRange auto&& output) {
     auto [input_range, output_range] = auxiliary_encoder_.Encode(
         std::ranges::subrange{&token, std::next(&token)}, output);
     // Token has not been encoded due to the jam in the encoder queue - enque
@@ -197,18 +503,105 @@ LzssEncoder<Token, AuxiliaryEncoder, Allocator>::EncodeIntermediateToken(
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr void LzssEncoder<Token, AuxiliaryEncoder, Allocator>::
-    TryToRemoveStringFromSearchTree(FusedDictionaryAndBuffer<Token>& dict) {
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::CollectCandidate(
+    FusedDictionaryAndBuffer<Token>& dict, SequenceView look_ahead,
+    BitOutputRange auto&& output) {
+    candidates_.emplace_back(look_ahead[0],
+                             match_finder_.FindMatch(look_ahead));
+    TryToRemoveStringFromMatchFinder(dict);
+
+    if (candidates_.size() < kParsingBlockSize) {
+        return AsSubrange(output);
+    }
+    ParseCandidates();
+    return FlushParsedTokens(std::forward<decltype(output)>(output));
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr void
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::ParseCandidates() {
+    // Shortest path over the positions of the block where the edges are the
+    // symbols and every prefix of the longest match found at the position
+    const size_t size = candidates_.size();
+    std::vector<ParsingNode> nodes(
+        size + 1, ParsingNode{std::numeric_limits<float>::max(), 0, false});
+    nodes[0].cost = 0;
+
+    auto relax = [&nodes](size_t index, float cost, size_t length,
+                          bool is_match) {
+        if (cost < nodes[index].cost) {
+            nodes[index] = ParsingNode{cost, static_cast<uint16_t>(length),
+                                       is_match};
+        }
+    };
+
+    for (size_t i = 0; i < size; ++i) {
+        const auto& [symbol, match] = candidates_[i];
+        relax(i + 1,
+              nodes[i].cost + auxiliary_encoder_.TokenBitSize(IMToken{symbol}),
+              1, false);
+
+        const size_t max_length = std::min(match.match_length, size - i);
+        for (size_t length = 1; length <= max_length; ++length) {
+            IMToken match_token{static_cast<uint32_t>(match.match_position),
+                                static_cast<uint16_t>(length)};
+            relax(i + length,
+                  nodes[i].cost + auxiliary_encoder_.TokenBitSize(match_token),
+                  length, true);
+        }
+    }
+
+    const auto first_token = parsed_tokens_.size();
+    for (size_t i = size; i;) {
+        const ParsingNode& node = nodes[i];
+        i -= node.length;
+        if (node.is_match) {
+            parsed_tokens_.emplace_back(
+                static_cast<uint32_t>(candidates_[i].match.match_position),
+                node.length);
+        } else {
+            parsed_tokens_.emplace_back(candidates_[i].symbol);
+        }
+    }
+    std::ranges::reverse(parsed_tokens_.begin() + first_token,
+                         parsed_tokens_.end());
+    candidates_.clear();
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::FlushParsedTokens(
+    BitOutputRange auto&& output) {
+    auto [input_range, output_range] = auxiliary_encoder_.Encode(
+        std::ranges::subrange{parsed_tokens_.begin(), parsed_tokens_.end()},
+        output);
+    // Tokens that did not fit into the output are kept for the next call
+    parsed_tokens_.erase(parsed_tokens_.begin(),
+                         std::ranges::begin(input_range));
+    return output_range;
+}
+
+template <std::integral Token,
+          SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr void LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::
+    TryToRemoveStringFromMatchFinder(FusedDictionaryAndBuffer<Token>& dict) {
     if (dict.dictionary_size() == dict.max_dictionary_size()) {
-        search_tree_.RemoveString(dict.get_oldest_dictionary_full_match());
+        match_finder_.RemoveString(dict.get_oldest_dictionary_full_match());
     }
 }
 
 template <std::integral Token,
           SizeAwareEncoder<LzssIntermediateToken<Token>> AuxiliaryEncoder,
-          typename Allocator>
-constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::FlushData(
+          typename Allocator, MatchFinder<Token> Finder>
+constexpr auto
+LzssEncoder<Token, AuxiliaryEncoder, Allocator, Finder>::FlushData(
     BitOutputRange auto&& output) {
     [[assume(std::holds_alternative<FusedDictionaryAndBuffer<Token>>(
         dictionary_and_buffer_))]];
@@ -224,11 +617,24 @@ constexpr auto LzssEncoder<Token, AuxiliaryEncoder, Allocator>::FlushData(
         }
     }
 
-    for (size_t i = 0; i < dict.max_buffer_size(); ++i) {
+    if (!parsed_tokens_.empty()) {
+        out_range = FlushParsedTokens(out_range);
+        if (!parsed_tokens_.empty()) {
+            return out_range;
+        }
+    }
+
+    // Look-ahead of the primed encoder might not have been filled up
+    for (size_t i = dict.buffer_size(); i; --i) {
         out_range =
             PeformEncodigStep(dict, dict.get_buffer(), std::move(out_range));
         dict.AddEndSymbolToBuffer();
     }
+
+    if (!candidates_.empty()) {
+        ParseCandidates();
+        out_range = FlushParsedTokens(std::move(out_range));
+    }
     return out_range;
 }
 
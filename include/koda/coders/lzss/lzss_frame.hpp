@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstdlib>
+#include <iterator>
+#include <span>
+#include <vector>
+
+namespace koda {
+
+/// Header of the frame written by the LzssBlockEncoder. Fields are stored as
+/// the little endian 64-bit words: magic, symbol count, block size, priming
+/// size, block count and the encoded size (in bytes) of every block. Block
+/// payloads follow the header in their order
+struct LzssFrameHeader {
+    static constexpr uint64_t kMagic = 0x314d5246535a4c;  // "LZSFRM1"
+
+    size_t symbol_count = 0;
+    size_t block_size = 0;
+    size_t priming_size = 0;
+    std::vector<size_t> encoded_block_sizes = {};
+
+    [[nodiscard]] static constexpr size_t BlockCount(
+        size_t symbol_count, size_t block_size) noexcept;
+
+    [[nodiscard]] constexpr size_t block_count() const noexcept;
+
+    // Size of the header in bytes
+    [[nodiscard]] constexpr size_t byte_size() const noexcept;
+
+    // Offset of the block payload from the beginning of the frame
+    [[nodiscard]] constexpr size_t block_offset(size_t index) const noexcept;
+
+    constexpr auto Write(std::output_iterator<uint8_t> auto output_iter,
+                         std::sentinel_for<decltype(output_iter)> auto
+                             output_sent) const;
+
+    [[nodiscard]] static constexpr LzssFrameHeader Read(
+        std::span<const uint8_t> frame);
+
+   private:
+    static constexpr size_t kWordSize = sizeof(uint64_t);
+    static constexpr size_t kFixedWords = 5;
+
+    static constexpr uint64_t ReadWord(std::span<const uint8_t> frame,
+                                       size_t index) noexcept;
+};
+
+}  // namespace koda
+
+#include <koda/coders/lzss/lzss_frame.ipp>
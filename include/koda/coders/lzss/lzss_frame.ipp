@@ -0,0 +1,108 @@
+#pragma once
+
+#include <koda/utils/formatted_exception.hpp>
+
+#include <climits>
+#include <numeric>
+
+namespace koda {
+
+[[nodiscard]] /*static*/ constexpr size_t LzssFrameHeader::BlockCount(
+    size_t symbol_count, size_t block_size) noexcept {
+    // Remainder is rounded up separately so the huge counts cannot overflow
+    return symbol_count / block_size + (symbol_count % block_size != 0);
+}
+
+[[nodiscard]] constexpr size_t LzssFrameHeader::block_count() const noexcept {
+    return encoded_block_sizes.size();
+}
+
+[[nodiscard]] constexpr size_t LzssFrameHeader::byte_size() const noexcept {
+    return (kFixedWords + block_count()) * kWordSize;
+}
+
+[[nodiscard]] constexpr size_t LzssFrameHeader::block_offset(
+    size_t index) const noexcept {
+    return std::accumulate(encoded_block_sizes.begin(),
+                           encoded_block_sizes.begin() + index, byte_size());
+}
+
+constexpr auto LzssFrameHeader::Write(
+    std::output_iterator<uint8_t> auto output_iter,
+    std::sentinel_for<decltype(output_iter)> auto output_sent) const {
+    auto write_word = [&](uint64_t word) {
+        for (size_t i = 0; i < kWordSize; ++i, word >>= CHAR_BIT) {
+            if (output_iter == output_sent) [[unlikely]] {
+                throw FormattedException{
+                    "Output cannot hold the frame header ({} bytes)",
+                    byte_size()};
+            }
+            *output_iter++ = static_cast<uint8_t>(word);
+        }
+    };
+
+    write_word(kMagic);
+    write_word(symbol_count);
+    write_word(block_size);
+    write_word(priming_size);
+    write_word(block_count());
+    for (size_t encoded_size : encoded_block_sizes) {
+        write_word(encoded_size);
+    }
+    return output_iter;
+}
+
+[[nodiscard]] /*static*/ constexpr LzssFrameHeader LzssFrameHeader::Read(
+    std::span<const uint8_t> frame) {
+    if (frame.size() < kFixedWords * kWordSize) [[unlikely]] {
+        throw FormattedException{"Frame is too short ({} bytes)",
+                                 frame.size()};
+    }
+    if (ReadWord(frame, 0) != kMagic) [[unlikely]] {
+        throw FormattedException{"Invalid frame magic ({:#x})",
+                                 ReadWord(frame, 0)};
+    }
+
+    LzssFrameHeader header{.symbol_count = ReadWord(frame, 1),
+                           .block_size = ReadWord(frame, 2),
+                           .priming_size = ReadWord(frame, 3)};
+    const size_t block_count = ReadWord(frame, 4);
+    if (!header.block_size ||
+        (block_count != BlockCount(header.symbol_count, header.block_size)))
+        [[unlikely]] {
+        throw FormattedException{
+            "Frame with {} symbols cannot be split into {} blocks of {} "
+            "symbols",
+            header.symbol_count, block_count, header.block_size};
+    }
+    // Block count is compared with the number of words so the header size
+    // cannot overflow
+    if (block_count > frame.size() / kWordSize - kFixedWords) [[unlikely]] {
+        throw FormattedException{"Frame header is truncated ({} bytes)",
+                                 frame.size()};
+    }
+
+    header.encoded_block_sizes.reserve(block_count);
+    size_t payload_end = (kFixedWords + block_count) * kWordSize;
+    for (size_t i = 0; i < block_count; ++i) {
+        const size_t encoded_size = ReadWord(frame, kFixedWords + i);
+        if (encoded_size > frame.size() - payload_end) [[unlikely]] {
+            throw FormattedException{"Frame payload is truncated ({} bytes)",
+                                     frame.size()};
+        }
+        payload_end += encoded_size;
+        header.encoded_block_sizes.push_back(encoded_size);
+    }
+    return header;
+}
+
+/*static*/ constexpr uint64_t LzssFrameHeader::ReadWord(
+    std::span<const uint8_t> frame, size_t index) noexcept {
+    uint64_t word = 0;
+    for (size_t i = kWordSize; i; --i) {
+        word = (word << CHAR_BIT) | frame[index * kWordSize + i - 1];
+    }
+    return word;
+}
+
+}  // namespace koda
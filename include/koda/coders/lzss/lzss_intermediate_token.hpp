@@ -26,12 +26,28 @@ class [[nodiscard]] LzssIntermediateToken {
             const RepeatitionMarker& right) const noexcept = default;
     };
 
+    // Refers to one of the offsets of the most recent matches instead of the
+    // explicit position, see LzssOffsetHistory
+    struct RepeatedOffsetMarker {
+        uint8_t offset_index;
+        LengthTp match_length;
+
+        [[nodiscard]] constexpr auto operator<=>(
+            const RepeatedOffsetMarker& right) const noexcept = default;
+
+        [[nodiscard]] constexpr bool operator==(
+            const RepeatedOffsetMarker& right) const noexcept = default;
+    };
+
     constexpr explicit LzssIntermediateToken(
         InputToken symbol = InputToken{}) noexcept;
 
     constexpr explicit LzssIntermediateToken(PositionTp match_position,
                                              LengthTp match_length) noexcept;
 
+    constexpr explicit LzssIntermediateToken(
+        RepeatedOffsetMarker marker) noexcept;
+
     constexpr LzssIntermediateToken(
         const LzssIntermediateToken& other) noexcept;
 
@@ -42,12 +58,17 @@ class [[nodiscard]] LzssIntermediateToken {
 
     [[nodiscard]] constexpr bool holds_marker() const noexcept;
 
+    [[nodiscard]] constexpr bool holds_repeated_offset() const noexcept;
+
     [[nodiscard]] constexpr std::optional<InputToken> get_symbol()
         const noexcept;
 
     [[nodiscard]] constexpr std::optional<RepeatitionMarker> get_marker()
         const noexcept;
 
+    [[nodiscard]] constexpr std::optional<RepeatedOffsetMarker>
+    get_repeated_offset() const noexcept;
+
     [[nodiscard]] constexpr std::partial_ordering operator<=>(
         const LzssIntermediateToken& right) const noexcept;
 
@@ -57,13 +78,22 @@ class [[nodiscard]] LzssIntermediateToken {
     constexpr ~LzssIntermediateToken();
 
    private:
+    enum class Kind : uint8_t {
+        kSymbol = 0,
+        kMarker = 1,
+        kRepeatedOffset = 2
+    };
+
     // We don't need to manually call destructor on an active
-    // member since both of them are trivially destructible
+    // member since all of them are trivially destructible
     union {
         InputToken symbol_;
         RepeatitionMarker repeatition_marker_;
+        RepeatedOffsetMarker repeated_offset_marker_;
     };
-    bool holds_distance_match_pair_;
+    Kind kind_;
+
+    constexpr void CopyActiveMember(const LzssIntermediateToken& other);
 
     constexpr void Destroy();
 };
@@ -6,7 +6,7 @@ template <std::integral InputToken, UnsignedIntegral PositionTp,
           UnsignedIntegral LengthTp>
 constexpr LzssIntermediateToken<InputToken, PositionTp, LengthTp>::
     LzssIntermediateToken(InputToken symbol) noexcept
-    : symbol_{symbol}, holds_distance_match_pair_{false} {}
+    : symbol_{symbol}, kind_{Kind::kSymbol} {}
 
 template <std::integral InputToken, UnsignedIntegral PositionTp,
           UnsignedIntegral LengthTp>
@@ -14,17 +14,19 @@ constexpr LzssIntermediateToken<InputToken, PositionTp, LengthTp>::
     LzssIntermediateToken(PositionTp match_position,
                           LengthTp match_length) noexcept
     : repeatition_marker_{match_position, match_length},
-      holds_distance_match_pair_{true} {}
+      kind_{Kind::kMarker} {}
+
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp>
+constexpr LzssIntermediateToken<InputToken, PositionTp, LengthTp>::
+    LzssIntermediateToken(RepeatedOffsetMarker marker) noexcept
+    : repeated_offset_marker_{marker}, kind_{Kind::kRepeatedOffset} {}
 
 template <std::integral InputToken, UnsignedIntegral PositionTp,
           UnsignedIntegral LengthTp>
 constexpr LzssIntermediateToken<InputToken, PositionTp, LengthTp>::
     LzssIntermediateToken(const LzssIntermediateToken& other) noexcept {
-    if ((holds_distance_match_pair_ = other.holds_distance_match_pair_)) {
-        repeatition_marker_ = other.repeatition_marker_;
-    } else {
-        symbol_ = other.symbol_;
-    }
+    CopyActiveMember(other);
 }
 
 template <std::integral InputToken, UnsignedIntegral PositionTp,
@@ -33,11 +35,7 @@ constexpr LzssIntermediateToken<InputToken, PositionTp, LengthTp>&
 LzssIntermediateToken<InputToken, PositionTp, LengthTp>::operator=(
     const LzssIntermediateToken& other) noexcept {
     Destroy();
-    if ((holds_distance_match_pair_ = other.holds_distance_match_pair_)) {
-        repeatition_marker_ = other.repeatition_marker_;
-    } else {
-        symbol_ = other.symbol_;
-    }
+    CopyActiveMember(other);
     return *this;
 }
 
@@ -52,8 +50,14 @@ LzssIntermediateToken<InputToken, PositionTp, LengthTp>::operator<=>(
         }
         return std::partial_ordering::unordered;
     }
-    if (auto other = right.get_marker()) {
-        return *get_marker() <=> *other;
+    if (auto marker = get_marker()) {
+        if (auto other = right.get_marker()) {
+            return *marker <=> *other;
+        }
+        return std::partial_ordering::unordered;
+    }
+    if (auto other = right.get_repeated_offset()) {
+        return *get_repeated_offset() <=> *other;
     }
     return std::partial_ordering::unordered;
 }
@@ -69,8 +73,14 @@ LzssIntermediateToken<InputToken, PositionTp, LengthTp>::operator==(
         }
         return false;
     }
-    if (auto other = right.get_marker()) {
-        return *get_marker() == *other;
+    if (auto marker = get_marker()) {
+        if (auto other = right.get_marker()) {
+            return *marker == *other;
+        }
+        return false;
+    }
+    if (auto other = right.get_repeated_offset()) {
+        return *get_repeated_offset() == *other;
     }
     return false;
 }
@@ -86,10 +96,34 @@ template <std::integral InputToken, UnsignedIntegral PositionTp,
           UnsignedIntegral LengthTp>
 constexpr void
 LzssIntermediateToken<InputToken, PositionTp, LengthTp>::Destroy() {
-    if (holds_distance_match_pair_) {
-        repeatition_marker_.~RepeatitionMarker();
-    } else {
-        symbol_.~Symbol();
+    switch (kind_) {
+        case Kind::kSymbol:
+            symbol_.~Symbol();
+            break;
+        case Kind::kMarker:
+            repeatition_marker_.~RepeatitionMarker();
+            break;
+        case Kind::kRepeatedOffset:
+            repeated_offset_marker_.~RepeatedOffsetMarker();
+            break;
+    }
+}
+
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp>
+constexpr void
+LzssIntermediateToken<InputToken, PositionTp, LengthTp>::CopyActiveMember(
+    const LzssIntermediateToken& other) {
+    switch (kind_ = other.kind_) {
+        case Kind::kSymbol:
+            symbol_ = other.symbol_;
+            break;
+        case Kind::kMarker:
+            repeatition_marker_ = other.repeatition_marker_;
+            break;
+        case Kind::kRepeatedOffset:
+            repeated_offset_marker_ = other.repeated_offset_marker_;
+            break;
     }
 }
 
@@ -97,14 +131,21 @@ template <std::integral InputToken, UnsignedIntegral PositionTp,
           UnsignedIntegral LengthTp>
 [[nodiscard]] constexpr bool LzssIntermediateToken<
     InputToken, PositionTp, LengthTp>::holds_symbol() const noexcept {
-    return holds_distance_match_pair_ == false;
+    return kind_ == Kind::kSymbol;
 }
 
 template <std::integral InputToken, UnsignedIntegral PositionTp,
           UnsignedIntegral LengthTp>
 [[nodiscard]] constexpr bool LzssIntermediateToken<
     InputToken, PositionTp, LengthTp>::holds_marker() const noexcept {
-    return holds_distance_match_pair_ == true;
+    return kind_ == Kind::kMarker;
+}
+
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp>
+[[nodiscard]] constexpr bool LzssIntermediateToken<
+    InputToken, PositionTp, LengthTp>::holds_repeated_offset() const noexcept {
+    return kind_ == Kind::kRepeatedOffset;
 }
 
 template <std::integral InputToken, UnsignedIntegral PositionTp,
@@ -129,6 +170,18 @@ LzssIntermediateToken<InputToken, PositionTp, LengthTp>::get_marker()
     return std::nullopt;
 }
 
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp>
+[[nodiscard]] constexpr std::optional<typename LzssIntermediateToken<
+    InputToken, PositionTp, LengthTp>::RepeatedOffsetMarker>
+LzssIntermediateToken<InputToken, PositionTp, LengthTp>::get_repeated_offset()
+    const noexcept {
+    if (holds_repeated_offset()) {
+        return repeated_offset_marker_;
+    }
+    return std::nullopt;
+}
+
 }  // namespace koda
 
 namespace std {
@@ -148,9 +201,15 @@ auto formatter<koda::LzssIntermediateToken<Token, Position, Length>>::format(
         return std::format_to(ctx.out(), "LzssIntermediateToken(symbol={})",
                               *symbol);
     }
-    const auto [pos, len] = *obj.get_marker();
+    if (auto marker = obj.get_marker()) {
+        return std::format_to(ctx.out(),
+                              "LzssIntermediateToken(position={}, length={})",
+                              marker->match_position, marker->match_length);
+    }
+    const auto [index, len] = *obj.get_repeated_offset();
     return std::format_to(
-        ctx.out(), "LzssIntermediateToken(position={}, length={})", pos, len);
+        ctx.out(), "LzssIntermediateToken(offset_index={}, length={})",
+        index, len);
 }
 
 }  // namespace std
@@ -3,6 +3,7 @@
 #include <koda/coders/coder.hpp>
 #include <koda/coders/coder_traits.hpp>
 #include <koda/coders/lzss/lzss_intermediate_token.hpp>
+#include <koda/coders/lzss/lzss_offset_history.hpp>
 
 namespace koda {
 
@@ -34,12 +35,22 @@ class LzssIntermediateTokenDecoder
     constexpr auto Decode(BitInputRange auto&& input,
                           std::ranges::output_range<token_type> auto&& output);
 
+    // Markers carry an extra bit telling whether they repeat one of the
+    // recent offsets. Has to match the encoder and be chosen before the first
+    // token is decoded
+    constexpr void set_repeated_offsets(bool repeated_offsets) noexcept;
+
+    [[nodiscard]] constexpr bool repeated_offsets() const noexcept;
+
    private:
     enum class State : uint8_t {
         kBit = 0,
         kToken = 1,
         kPosition = 2,
-        kLength = 3
+        kLength = 3,
+        // Only used with the repeated offsets
+        kKind = 4,
+        kOffsetIndex = 5
     };
 
     TokenDecoder token_decoder_;
@@ -47,9 +58,17 @@ class LzssIntermediateTokenDecoder
     LengthDecoder length_decoder_;
     State state_ = State::kBit;
     PositionTp receiver_position_[1]{};
+    bool repeated_offsets_ = false;
+    bool receives_repeated_offset_ = false;
+    uint8_t receiver_offset_index_ = 0;
+    uint8_t received_index_bits_ = 0;
 
     constexpr void ReceiveBit(bool bit);
 
+    constexpr void ReceiveKind(bool bit);
+
+    constexpr void ReceiveOffsetIndex(bool bit);
+
     constexpr void ReceiveToken(auto& input_iter, auto& input_sent,
                                 auto& output_iter);
 
@@ -67,6 +67,12 @@ constexpr auto LzssIntermediateTokenDecoder<
             case State::kLength:
                 ReceiveLength(input_iter, input_sent, output_iter);
                 break;
+            case State::kKind:
+                ReceiveKind(*input_iter++);
+                break;
+            case State::kOffsetIndex:
+                ReceiveOffsetIndex(*input_iter++);
+                break;
         }
     }
 
@@ -74,13 +80,63 @@ constexpr auto LzssIntermediateTokenDecoder<
                        std::move(output_iter), std::move(output_sent)};
 }
 
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp, Decoder<InputToken> TokenDecoder,
+          Decoder<PositionTp> PositionDecoder, Decoder<LengthTp> LengthDecoder>
+constexpr void LzssIntermediateTokenDecoder<
+    InputToken, PositionTp, LengthTp, TokenDecoder, PositionDecoder,
+    LengthDecoder>::set_repeated_offsets(bool repeated_offsets) noexcept {
+    repeated_offsets_ = repeated_offsets;
+}
+
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp, Decoder<InputToken> TokenDecoder,
+          Decoder<PositionTp> PositionDecoder, Decoder<LengthTp> LengthDecoder>
+[[nodiscard]] constexpr bool LzssIntermediateTokenDecoder<
+    InputToken, PositionTp, LengthTp, TokenDecoder, PositionDecoder,
+    LengthDecoder>::repeated_offsets() const noexcept {
+    return repeated_offsets_;
+}
+
 template <std::integral InputToken, UnsignedIntegral PositionTp,
           UnsignedIntegral LengthTp, Decoder<InputToken> TokenDecoder,
           Decoder<PositionTp> PositionDecoder, Decoder<LengthTp> LengthDecoder>
 constexpr void LzssIntermediateTokenDecoder<
     InputToken, PositionTp, LengthTp, TokenDecoder, PositionDecoder,
     LengthDecoder>::ReceiveBit(bool bit) {
-    state_ = bit ? State::kPosition : State::kToken;
+    if (!bit) {
+        state_ = State::kToken;
+        return;
+    }
+    receives_repeated_offset_ = false;
+    state_ = repeated_offsets_ ? State::kKind : State::kPosition;
+}
+
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp, Decoder<InputToken> TokenDecoder,
+          Decoder<PositionTp> PositionDecoder, Decoder<LengthTp> LengthDecoder>
+constexpr void LzssIntermediateTokenDecoder<
+    InputToken, PositionTp, LengthTp, TokenDecoder, PositionDecoder,
+    LengthDecoder>::ReceiveKind(bool bit) {
+    if ((receives_repeated_offset_ = bit)) {
+        receiver_offset_index_ = received_index_bits_ = 0;
+        state_ = State::kOffsetIndex;
+    } else {
+        state_ = State::kPosition;
+    }
+}
+
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp, Decoder<InputToken> TokenDecoder,
+          Decoder<PositionTp> PositionDecoder, Decoder<LengthTp> LengthDecoder>
+constexpr void LzssIntermediateTokenDecoder<
+    InputToken, PositionTp, LengthTp, TokenDecoder, PositionDecoder,
+    LengthDecoder>::ReceiveOffsetIndex(bool bit) {
+    receiver_offset_index_ |= static_cast<uint8_t>(bit)
+                              << received_index_bits_;
+    if (++received_index_bits_ == LzssOffsetHistory::kIndexBits) {
+        state_ = State::kLength;
+    }
 }
 
 template <std::integral InputToken, UnsignedIntegral PositionTp,
@@ -144,7 +200,13 @@ constexpr void LzssIntermediateTokenDecoder<
 
     if (out.empty()) {
         // Encoder decreases length by one since 0 is not permitted
-        *output_iter++ = token_type{receiver_position_[0], ++length[0]};
+        if (receives_repeated_offset_) {
+            using RepeatedOffsetMarker = token_type::RepeatedOffsetMarker;
+            *output_iter++ = token_type{
+                RepeatedOffsetMarker{receiver_offset_index_, ++length[0]}};
+        } else {
+            *output_iter++ = token_type{receiver_position_[0], ++length[0]};
+        }
         state_ = State::kBit;
     }
 }
@@ -3,6 +3,7 @@
 #include <koda/coders/coder.hpp>
 #include <koda/coders/coder_traits.hpp>
 #include <koda/coders/lzss/lzss_intermediate_token.hpp>
+#include <koda/coders/lzss/lzss_offset_history.hpp>
 #include <koda/ranges/bit_iterator.hpp>
 
 #include <array>
@@ -42,6 +43,14 @@ class LzssIntermediateTokenEncoder
 
     constexpr auto Flush(BitOutputRange auto&& output);
 
+    // Markers carry an extra bit telling whether they repeat one of the
+    // recent offsets. Has to match the decoder and be chosen before the first
+    // token is encoded. LzssEncoder selects the repeated offsets only with
+    // the greedy parsing and the lazy matching turned off
+    constexpr void set_repeated_offsets(bool repeated_offsets) noexcept;
+
+    [[nodiscard]] constexpr bool repeated_offsets() const noexcept;
+
    private:
     // Symetric encoder:
     // kBit -> kToken -> kBit or kBit -> kPosition -> kLength -> kBit
@@ -51,6 +60,9 @@ class LzssIntermediateTokenEncoder
     // In case of symetric encoder the kBit state emits bit
     // In case of the asymetric encoder the kDeferred states emit bit and kBit
     // does not
+    // With the repeated offsets the markers emit kKind right after kBit
+    // (symetric) or right before kDeferredBitFromMarker (asymetric) and the
+    // repeated offset markers emit kOffsetIndex in place of kPosition
     enum class State : uint8_t {
         kBit = 0,
         kToken = 1,
@@ -58,7 +70,10 @@ class LzssIntermediateTokenEncoder
         kLength = 3,
         // Only used by the asymetric encoder
         kDeferredBitFromToken = 4,
-        kDeferredBitFromMarker = 5
+        kDeferredBitFromMarker = 5,
+        // Only used with the repeated offsets
+        kKind = 6,
+        kOffsetIndex = 7
     };
 
     TokenEncoder token_encoder_;
@@ -70,8 +85,12 @@ class LzssIntermediateTokenEncoder
         struct {
             PositionTp position[1];
             LengthTp length[1];
+            uint8_t offset_index;
         };
     } emitter_{};
+    bool repeated_offsets_ = false;
+    bool emits_repeated_offset_ = false;
+    uint8_t emitted_index_bits_ = 0;
 
     constexpr void EmitBit(const token_type& token, auto& output_iter);
 
@@ -83,6 +102,10 @@ class LzssIntermediateTokenEncoder
 
     constexpr void EmitDeferredBit(auto& output_iter);
 
+    constexpr void EmitKind(auto& output_iter);
+
+    constexpr void EmitOffsetIndex(auto& output_iter);
+
     static constexpr bool IsSymetric = TokenTraits::IsSymetric &&
                                        PositionTraits::IsSymetric &&
                                        LengthTraits::IsSymetric;
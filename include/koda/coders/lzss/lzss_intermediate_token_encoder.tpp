@@ -29,10 +29,17 @@ constexpr float LzssIntermediateTokenEncoder<
     if (auto symbol = token.get_symbol()) {
         return 1 + token_encoder_.TokenBitSize(*symbol);
     }
-    auto [pos, len] = *token.get_marker();
+    const float kind_bit_size = repeated_offsets_ ? 1.f : 0.f;
+    if (auto marker = token.get_marker()) {
+        auto [pos, len] = *marker;
+        assert(len != 0 && "Token must have length");
+        // len will never be zero so encode len - 1 to utilize it
+        return 1.f + kind_bit_size + position_encoder_.TokenBitSize(pos) +
+               length_encoder_.TokenBitSize(len - 1);
+    }
+    auto [index, len] = *token.get_repeated_offset();
     assert(len != 0 && "Token must have length");
-    // len will never be zero so encode len - 1 to utilize it
-    return 1.f + position_encoder_.TokenBitSize(pos) +
+    return 1.f + kind_bit_size + LzssOffsetHistory::kIndexBits +
            length_encoder_.TokenBitSize(len - 1);
 }
 
@@ -68,6 +75,12 @@ constexpr auto LzssIntermediateTokenEncoder<
             case State::kDeferredBitFromMarker:
                 EmitDeferredBit(output_iter);
                 break;
+            case State::kKind:
+                EmitKind(output_iter);
+                break;
+            case State::kOffsetIndex:
+                EmitOffsetIndex(output_iter);
+                break;
         }
     }
 
@@ -83,19 +96,31 @@ constexpr void LzssIntermediateTokenEncoder<
     InputToken, PositionTp, LengthTp, TokenEncoder, PositionEncoder,
     LengthEncoder>::EmitBit(const token_type& token, auto& output_iter) {
     if constexpr (IsSymetric) {
-        *output_iter++ = token.holds_marker();
+        *output_iter++ = !token.holds_symbol();
     }
 
     if (auto symbol = token.get_symbol()) {
         state_ = State::kToken;
         emitter_.symbol[0] = *symbol;
-    } else {
-        state_ = IsSymetric ? State::kPosition : State::kLength;
-        auto [pos, len] = *token.get_marker();
+    } else if (auto marker = token.get_marker()) {
+        state_ = !IsSymetric          ? State::kLength
+                 : repeated_offsets_ ? State::kKind
+                                     : State::kPosition;
+        auto [pos, len] = *marker;
         assert(len != 0 && "Marker has to have length!");
+        emits_repeated_offset_ = false;
         emitter_.position[0] = pos;
         // len will never be zero so encode len - 1 to utilize it
         emitter_.length[0] = --len;
+    } else {
+        assert(repeated_offsets_ && "Repeated offsets have to be enabled!");
+        state_ = IsSymetric ? State::kKind : State::kLength;
+        auto [index, len] = *token.get_repeated_offset();
+        assert(len != 0 && "Marker has to have length!");
+        emits_repeated_offset_ = true;
+        emitted_index_bits_ = 0;
+        emitter_.offset_index = index;
+        emitter_.length[0] = --len;
     }
 }
 
@@ -136,7 +161,9 @@ constexpr void LzssIntermediateTokenEncoder<
     output_sent = std::ranges::end(out);
 
     if (in.empty()) {
-        state_ = IsSymetric ? State::kLength : State::kDeferredBitFromMarker;
+        state_ = IsSymetric          ? State::kLength
+                 : repeated_offsets_ ? State::kKind
+                                     : State::kDeferredBitFromMarker;
     }
 }
 
@@ -156,7 +183,9 @@ constexpr void LzssIntermediateTokenEncoder<
     output_sent = std::ranges::end(out);
 
     if (in.empty()) {
-        state_ = IsSymetric ? State::kBit : State::kPosition;
+        state_ = IsSymetric              ? State::kBit
+                 : emits_repeated_offset_ ? State::kOffsetIndex
+                                          : State::kPosition;
     }
 }
 
@@ -176,6 +205,60 @@ constexpr void LzssIntermediateTokenEncoder<
     }
 }
 
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp, SizeAwareEncoder<InputToken> TokenEncoder,
+          SizeAwareEncoder<PositionTp> PositionEncoder,
+          SizeAwareEncoder<LengthTp> LengthEncoder>
+constexpr void LzssIntermediateTokenEncoder<
+    InputToken, PositionTp, LengthTp, TokenEncoder, PositionEncoder,
+    LengthEncoder>::EmitKind(auto& output_iter) {
+    *output_iter++ = emits_repeated_offset_;
+    if constexpr (IsSymetric) {
+        state_ = emits_repeated_offset_ ? State::kOffsetIndex
+                                        : State::kPosition;
+    } else {
+        state_ = State::kDeferredBitFromMarker;
+    }
+}
+
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp, SizeAwareEncoder<InputToken> TokenEncoder,
+          SizeAwareEncoder<PositionTp> PositionEncoder,
+          SizeAwareEncoder<LengthTp> LengthEncoder>
+constexpr void LzssIntermediateTokenEncoder<
+    InputToken, PositionTp, LengthTp, TokenEncoder, PositionEncoder,
+    LengthEncoder>::EmitOffsetIndex(auto& output_iter) {
+    // Decoder receives the index starting from its least significant bit so
+    // the asymetric encoder emits it in the reversed order
+    const uint8_t bit = IsSymetric ? emitted_index_bits_
+                                   : LzssOffsetHistory::kIndexBits - 1 -
+                                         emitted_index_bits_;
+    *output_iter++ = static_cast<bool>((emitter_.offset_index >> bit) & 1);
+    if (++emitted_index_bits_ == LzssOffsetHistory::kIndexBits) {
+        state_ = IsSymetric ? State::kLength : State::kKind;
+    }
+}
+
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp, SizeAwareEncoder<InputToken> TokenEncoder,
+          SizeAwareEncoder<PositionTp> PositionEncoder,
+          SizeAwareEncoder<LengthTp> LengthEncoder>
+constexpr void LzssIntermediateTokenEncoder<
+    InputToken, PositionTp, LengthTp, TokenEncoder, PositionEncoder,
+    LengthEncoder>::set_repeated_offsets(bool repeated_offsets) noexcept {
+    repeated_offsets_ = repeated_offsets;
+}
+
+template <std::integral InputToken, UnsignedIntegral PositionTp,
+          UnsignedIntegral LengthTp, SizeAwareEncoder<InputToken> TokenEncoder,
+          SizeAwareEncoder<PositionTp> PositionEncoder,
+          SizeAwareEncoder<LengthTp> LengthEncoder>
+[[nodiscard]] constexpr bool LzssIntermediateTokenEncoder<
+    InputToken, PositionTp, LengthTp, TokenEncoder, PositionEncoder,
+    LengthEncoder>::repeated_offsets() const noexcept {
+    return repeated_offsets_;
+}
+
 template <std::integral InputToken, UnsignedIntegral PositionTp,
           UnsignedIntegral LengthTp, SizeAwareEncoder<InputToken> TokenEncoder,
           SizeAwareEncoder<PositionTp> PositionEncoder,
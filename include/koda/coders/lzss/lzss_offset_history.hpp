@@ -0,0 +1,35 @@
+#pragma once
+
+#include <array>
+#include <cinttypes>
+#include <cstdlib>
+
+namespace koda {
+
+/// Offsets (distances back from the current position) of the most recent
+/// matches, the newest one first. Encoder and decoder update their histories
+/// with every match so the repeated offset markers can refer to its entries
+/// by their indices
+class LzssOffsetHistory {
+   public:
+    static constexpr uint8_t kIndexBits = 2;
+    static constexpr size_t kSize = size_t{1} << kIndexBits;
+
+    constexpr LzssOffsetHistory() noexcept = default;
+
+    // Zero marks an entry that has not been filled yet
+    [[nodiscard]] constexpr size_t operator[](size_t index) const noexcept;
+
+    // Records the offset of the match with the explicit position
+    constexpr void Push(size_t offset) noexcept;
+
+    // Records the repeated offset by moving it to the front and returns it
+    constexpr size_t Promote(size_t index) noexcept;
+
+   private:
+    std::array<size_t, kSize> offsets_ = {};
+};
+
+}  // namespace koda
+
+#include <koda/coders/lzss/lzss_offset_history.ipp>
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+
+namespace koda {
+
+[[nodiscard]] constexpr size_t LzssOffsetHistory::operator[](
+    size_t index) const noexcept {
+    assert(index < kSize && "Offset index is out of the history");
+    return offsets_[index];
+}
+
+constexpr void LzssOffsetHistory::Push(size_t offset) noexcept {
+    std::shift_right(offsets_.begin(), offsets_.end(), 1);
+    offsets_.front() = offset;
+}
+
+constexpr size_t LzssOffsetHistory::Promote(size_t index) noexcept {
+    assert(index < kSize && "Offset index is out of the history");
+    // Entries newer than the promoted one are moved by a single place
+    std::ranges::rotate(offsets_.begin(), offsets_.begin() + index,
+                        offsets_.begin() + index + 1);
+    return offsets_.front();
+}
+
+}  // namespace koda
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <koda/coders/coder.hpp>
+#include <koda/coders/rans/rans_table.hpp>
+#include <koda/collections/map.hpp>
+
+#include <cinttypes>
+#include <climits>
+#include <vector>
+
+namespace koda {
+
+/// Decodes the stream produced by the RansEncoder with the same word size.
+/// The reversed stream starts with the final encoder state followed by the
+/// renormalization words in the order the decoder shifts them in
+template <typename Token, typename Count, size_t RenormalizationBits = CHAR_BIT>
+class RansDecoder
+    : public DecoderInterface<
+          Token, RansDecoder<Token, Count, RenormalizationBits>> {
+   public:
+    using token_type = Token;
+    using asymetrical = void;
+
+    static_assert(RenormalizationBits == 8 || RenormalizationBits == 16,
+                  "State can be renormalized only by bytes or 16-bit words");
+
+    constexpr explicit RansDecoder(const RansTable<Token, Count>& table);
+
+    constexpr auto Initialize(BitInputRange auto&& input);
+
+    constexpr auto Decode(BitInputRange auto&& input,
+                          std::ranges::output_range<Token> auto&& output);
+
+   private:
+    static constexpr uint8_t kStateBits = 32;
+    static constexpr uint32_t kLowerBound = uint32_t{1}
+                                            << (kStateBits -
+                                                RenormalizationBits);
+
+    struct DecodingEntry {
+        Token symbol;
+        uint32_t frequency;
+        uint32_t start;
+    };
+
+    std::vector<DecodingEntry> symbols_;
+    // Index of the symbol owning each of the 2^precision slots, precision
+    // never exceeds 16 bits so the index always fits
+    std::vector<uint16_t> slots_;
+    uint32_t state_ = 0;
+    uint64_t receiver_ = 0;
+    uint8_t received_size_ = 0;
+    uint8_t receiver_size_ = kStateBits;
+    uint8_t precision_;
+
+    constexpr auto SetReceiver(auto iter, const auto& sent);
+
+    constexpr bool ReceiveBits();
+
+    constexpr Token DecodeToken();
+
+    static constexpr std::vector<DecodingEntry> BuildSymbols(
+        const RansTable<Token, Count>& table);
+
+    static constexpr std::vector<uint16_t> BuildSlots(
+        const std::vector<DecodingEntry>& symbols, size_t total_frequency);
+};
+
+}  // namespace koda
+
+#include <koda/coders/rans/rans_decoder.tpp>
@@ -0,0 +1,111 @@
+#pragma once
+
+#include <koda/utils/utils.hpp>
+
+#include <cassert>
+
+namespace koda {
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr RansDecoder<Token, Count, RenormalizationBits>::RansDecoder(
+    const RansTable<Token, Count>& table)
+    : symbols_{BuildSymbols(table)},
+      slots_{BuildSlots(symbols_, table.total_frequency())},
+      precision_{table.precision()} {}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr auto RansDecoder<Token, Count, RenormalizationBits>::Initialize(
+    BitInputRange auto&& input) {
+    return std::forward<decltype(input)>(input);
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr auto RansDecoder<Token, Count, RenormalizationBits>::Decode(
+    BitInputRange auto&& input,
+    std::ranges::output_range<Token> auto&& output) {
+    auto in_iter = std::ranges::begin(input);
+    auto in_sent = std::ranges::end(input);
+
+    auto out_iter = std::ranges::begin(output);
+    auto out_sent = std::ranges::end(output);
+
+    // Tokens whose decoding leaves the state normalized need no input so
+    // the input is checked only when the state awaits its words
+    while (out_iter != out_sent) {
+        if (receiver_size_) {
+            if (in_iter == in_sent) {
+                break;
+            }
+            in_iter = SetReceiver(std::move(in_iter), in_sent);
+            if ((received_size_ != receiver_size_) || !ReceiveBits()) {
+                continue;
+            }
+        }
+        *out_iter++ = DecodeToken();
+    }
+
+    return CoderResult{std::move(in_iter), std::move(in_sent),
+                       std::move(out_iter), std::move(out_sent)};
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr auto RansDecoder<Token, Count, RenormalizationBits>::SetReceiver(
+    auto iter, const auto& sent) {
+    return ReadBits(std::move(iter), sent, receiver_, received_size_,
+                    receiver_size_);
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr bool RansDecoder<Token, Count, RenormalizationBits>::ReceiveBits() {
+    // Words are received starting from their most significant bit, the
+    // initial state is received the same way as a single wide word
+    state_ = static_cast<uint32_t>(
+        (static_cast<uint64_t>(state_) << receiver_size_) |
+        ReverseBits(receiver_, receiver_size_));
+    receiver_ = received_size_ = 0;
+    receiver_size_ = state_ < kLowerBound ? RenormalizationBits : 0;
+    return !receiver_size_;
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr Token RansDecoder<Token, Count, RenormalizationBits>::DecodeToken() {
+    const uint32_t slot = state_ & LowBitsMask<uint32_t>(precision_);
+    const DecodingEntry& entry = symbols_[slots_[slot]];
+    state_ = entry.frequency * (state_ >> precision_) + slot - entry.start;
+    receiver_size_ = state_ < kLowerBound ? RenormalizationBits : 0;
+    return entry.symbol;
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+/*static*/ constexpr std::vector<
+    typename RansDecoder<Token, Count, RenormalizationBits>::DecodingEntry>
+RansDecoder<Token, Count, RenormalizationBits>::BuildSymbols(
+    const RansTable<Token, Count>& table) {
+    std::vector<DecodingEntry> symbols;
+    symbols.reserve(table.frequencies().size());
+    uint32_t start = 0;
+
+    for (const auto& [token, count] : table.frequencies()) {
+        const auto frequency = static_cast<uint32_t>(count);
+        symbols.emplace_back(token, frequency, start);
+        start += frequency;
+    }
+    return symbols;
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+/*static*/ constexpr std::vector<uint16_t>
+RansDecoder<Token, Count, RenormalizationBits>::BuildSlots(
+    const std::vector<DecodingEntry>& symbols, size_t total_frequency) {
+    std::vector<uint16_t> slots;
+    slots.reserve(total_frequency);
+
+    for (const auto& [index, entry] : std::views::enumerate(symbols)) {
+        slots.insert(slots.end(), entry.frequency,
+                     static_cast<uint16_t>(index));
+    }
+    assert(slots.size() == total_frequency);
+    return slots;
+}
+
+}  // namespace koda
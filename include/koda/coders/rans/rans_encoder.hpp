@@ -0,0 +1,76 @@
+#pragma once
+
+#include <koda/coders/coder.hpp>
+#include <koda/coders/rans/rans_table.hpp>
+#include <koda/collections/map.hpp>
+#include <koda/collections/token_table.hpp>
+
+#include <cinttypes>
+#include <climits>
+
+namespace koda {
+
+/// Range variant of the asymmetric numeral systems. The 32-bit state is
+/// renormalized by whole RenormalizationBits wide words (bytes or 16-bit
+/// words) so, contrary to the TansEncoder, neither the state table nor
+/// the per token bit counts are needed. The decoder reads the reversed
+/// stream and yields the tokens in the reversed order
+template <typename Token, typename Count, size_t RenormalizationBits = CHAR_BIT>
+class RansEncoder
+    : public EncoderInterface<
+          Token, RansEncoder<Token, Count, RenormalizationBits>> {
+   public:
+    using asymetrical = void;
+    using token_type = Token;
+
+    static_assert(RenormalizationBits == 8 || RenormalizationBits == 16,
+                  "State can be renormalized only by bytes or 16-bit words");
+
+    constexpr explicit RansEncoder(const RansTable<Token, Count>& table);
+
+    constexpr float TokenBitSize(Token token) const;
+
+    constexpr auto Encode(InputRange<Token> auto&& input,
+                          BitOutputRange auto&& output);
+
+    constexpr auto Flush(BitOutputRange auto&& output);
+
+   private:
+    static constexpr uint8_t kStateBits = 32;
+    static constexpr uint32_t kLowerBound = uint32_t{1}
+                                            << (kStateBits -
+                                                RenormalizationBits);
+
+    struct SymbolTransform {
+        // States at or above the bound are renormalized before encoding
+        uint64_t renormalization_bound;
+        uint32_t frequency;
+        uint32_t start;
+        float bit_size;
+    };
+
+    TokenTable<Token, SymbolTransform> transforms_;
+    uint32_t state_ = kLowerBound;
+    uint64_t emitter_ = 0;
+    uint8_t emitter_size_ = 0;
+    uint8_t precision_;
+    bool flushed_ = false;
+
+    constexpr auto EncodeTokens(InputRange<Token> auto&& input, auto iter,
+                                auto sentinel);
+
+    constexpr void EncodeToken(const auto& token);
+
+    constexpr void AppendToEmitter(uint64_t value, uint8_t bit_count);
+
+    constexpr auto FlushEmitter(auto output_iter, const auto& output_sent);
+
+    static constexpr TokenTable<Token, SymbolTransform> BuildSymbolTransforms(
+        const RansTable<Token, Count>& table);
+
+    static constexpr float BitSize(uint32_t frequency, uint8_t precision);
+};
+
+}  // namespace koda
+
+#include <koda/coders/rans/rans_encoder.tpp>
@@ -0,0 +1,145 @@
+#pragma once
+
+#include <koda/utils/formatted_exception.hpp>
+#include <koda/utils/utils.hpp>
+
+#include <cassert>
+
+namespace koda {
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr RansEncoder<Token, Count, RenormalizationBits>::RansEncoder(
+    const RansTable<Token, Count>& table)
+    : transforms_{BuildSymbolTransforms(table)},
+      precision_{table.precision()} {}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr float RansEncoder<Token, Count, RenormalizationBits>::TokenBitSize(
+    Token token) const {
+    return transforms_.At(token).bit_size;
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr auto RansEncoder<Token, Count, RenormalizationBits>::Encode(
+    InputRange<Token> auto&& input, BitOutputRange auto&& output) {
+    auto sentinel = std::ranges::end(output);
+    auto iter = FlushEmitter(std::ranges::begin(output), sentinel);
+
+    if (iter == sentinel) {
+        return CoderResult{std::forward<decltype(input)>(input),
+                           std::move(iter), std::move(sentinel)};
+    }
+
+    return EncodeTokens(std::forward<decltype(input)>(input), std::move(iter),
+                        std::move(sentinel));
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr auto RansEncoder<Token, Count, RenormalizationBits>::Flush(
+    BitOutputRange auto&& output) {
+    auto sentinel = std::ranges::end(output);
+    auto iter = FlushEmitter(std::ranges::begin(output), sentinel);
+
+    // Final state is emitted whole so the decoder can start from it
+    if ((iter != sentinel) && !flushed_) {
+        flushed_ = true;
+        AppendToEmitter(state_, kStateBits);
+        iter = FlushEmitter(std::move(iter), sentinel);
+    }
+
+    return std::ranges::subrange{std::move(iter), std::move(sentinel)};
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr auto RansEncoder<Token, Count, RenormalizationBits>::EncodeTokens(
+    InputRange<Token> auto&& input, auto iter, auto sentinel) {
+    auto input_iter = std::ranges::begin(input);
+    auto input_sent = std::ranges::end(input);
+
+    for (; (iter != sentinel) && (input_iter != input_sent); ++input_iter) {
+        EncodeToken(*input_iter);
+        iter = FlushEmitter(iter, sentinel);
+    }
+
+    return CoderResult{std::move(input_iter), std::move(input_sent),
+                       std::move(iter), std::move(sentinel)};
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr void RansEncoder<Token, Count, RenormalizationBits>::EncodeToken(
+    const auto& token) {
+    const SymbolTransform* transform = transforms_.Find(token);
+    if (!transform) [[unlikely]] {
+        throw FormattedException{"Token is not described by the rANS table"};
+    }
+    // Least significant words are emitted first, the decoder receives them
+    // in the reversed order while shifting them back into the state
+    while (state_ >= transform->renormalization_bound) {
+        AppendToEmitter(state_, RenormalizationBits);
+        state_ >>= RenormalizationBits;
+    }
+    state_ = ((state_ / transform->frequency) << precision_) +
+             (state_ % transform->frequency) + transform->start;
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr void RansEncoder<Token, Count, RenormalizationBits>::AppendToEmitter(
+    uint64_t value, uint8_t bit_count) {
+    assert(emitter_size_ + bit_count <= 64);
+    emitter_ |= (value & LowBitsMask<uint64_t>(bit_count)) << emitter_size_;
+    emitter_size_ += bit_count;
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+constexpr auto RansEncoder<Token, Count, RenormalizationBits>::FlushEmitter(
+    auto output_iter, const auto& output_sent) {
+    return WriteBits(std::move(output_iter), output_sent, emitter_,
+                     emitter_size_);
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+/*static*/ constexpr TokenTable<
+    Token,
+    typename RansEncoder<Token, Count, RenormalizationBits>::SymbolTransform>
+RansEncoder<Token, Count, RenormalizationBits>::BuildSymbolTransforms(
+    const RansTable<Token, Count>& table) {
+    TokenTable<Token, SymbolTransform> transforms;
+    uint32_t start = 0;
+
+    for (const auto& [token, count] : table.frequencies()) {
+        const auto frequency = static_cast<uint32_t>(count);
+        transforms.Insert(
+            token,
+            SymbolTransform{
+                .renormalization_bound =
+                    (static_cast<uint64_t>(kLowerBound >> table.precision())
+                     << RenormalizationBits) *
+                    frequency,
+                .frequency = frequency,
+                .start = start,
+                .bit_size = BitSize(frequency, table.precision())});
+        start += frequency;
+    }
+    return transforms;
+}
+
+template <typename Token, typename Count, size_t RenormalizationBits>
+/*static*/ constexpr float
+RansEncoder<Token, Count, RenormalizationBits>::BitSize(uint32_t frequency,
+                                                        uint8_t precision) {
+    // Fractional part of the logarithm is evaluated by squaring the mantissa
+    // so the size is also available in the constant evaluation
+    const uint32_t integral = IntFloorLog2(frequency);
+    double mantissa = static_cast<double>(frequency) / (1u << integral);
+    double fraction = 0;
+    for (double bit = 0.5; bit > 0x1p-24; bit /= 2) {
+        mantissa *= mantissa;
+        if (mantissa >= 2) {
+            mantissa /= 2;
+            fraction += bit;
+        }
+    }
+    return static_cast<float>(precision - integral - fraction);
+}
+
+}  // namespace koda
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <koda/collections/map.hpp>
+
+#include <cinttypes>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace koda {
+
+/// Token frequencies normalized so they sum up to 2^precision. Every counted
+/// token keeps at least one slot so each of them remains encodable
+template <typename Token, std::integral CountTp>
+class RansTable {
+   public:
+    static constexpr uint8_t kDefaultPrecision = 12;
+    static constexpr uint8_t kMaxPrecision = 16;
+
+    explicit constexpr RansTable(const Map<Token, CountTp>& count,
+                                 uint8_t precision = kDefaultPrecision);
+
+    [[nodiscard]] constexpr const Map<Token, CountTp>& frequencies()
+        const noexcept;
+
+    [[nodiscard]] constexpr uint8_t precision() const noexcept;
+
+    [[nodiscard]] constexpr size_t total_frequency() const noexcept;
+
+   private:
+    Map<Token, CountTp> frequencies_;
+    uint8_t precision_;
+
+    constexpr void Normalize(const Map<Token, CountTp>& count);
+
+    static constexpr void DistributeRemainder(
+        std::vector<std::pair<Token, CountTp>>& scaled, size_t assigned,
+        size_t total_frequency);
+
+    constexpr void ValidateTable(const Map<Token, CountTp>& count) const;
+};
+
+}  // namespace koda
+
+#include <koda/coders/rans/rans_table.tpp>
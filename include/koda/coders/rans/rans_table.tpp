@@ -0,0 +1,117 @@
+#pragma once
+
+#include <koda/utils/formatted_exception.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <ranges>
+
+namespace koda {
+
+template <typename Token, std::integral CountTp>
+constexpr RansTable<Token, CountTp>::RansTable(
+    const Map<Token, CountTp>& count, uint8_t precision)
+    : precision_{precision} {
+    ValidateTable(count);
+    Normalize(count);
+}
+
+template <typename Token, std::integral CountTp>
+[[nodiscard]] constexpr const Map<Token, CountTp>&
+RansTable<Token, CountTp>::frequencies() const noexcept {
+    return frequencies_;
+}
+
+template <typename Token, std::integral CountTp>
+[[nodiscard]] constexpr uint8_t RansTable<Token, CountTp>::precision()
+    const noexcept {
+    return precision_;
+}
+
+template <typename Token, std::integral CountTp>
+[[nodiscard]] constexpr size_t RansTable<Token, CountTp>::total_frequency()
+    const noexcept {
+    return size_t{1} << precision_;
+}
+
+template <typename Token, std::integral CountTp>
+constexpr void RansTable<Token, CountTp>::Normalize(
+    const Map<Token, CountTp>& count) {
+    const uint64_t total = std::max<uint64_t>(
+        std::ranges::fold_left(count | std::views::values, uint64_t{0},
+                               std::plus<>{}),
+        1);
+
+    std::vector<std::pair<Token, CountTp>> scaled;
+    scaled.reserve(count.size());
+    size_t assigned = 0;
+    for (const auto& [token, occurences] : count) {
+        const auto frequency = std::max<uint64_t>(
+            static_cast<uint64_t>(occurences) * total_frequency() / total, 1);
+        scaled.emplace_back(token, static_cast<CountTp>(frequency));
+        assigned += frequency;
+    }
+
+    DistributeRemainder(scaled, assigned, total_frequency());
+
+    for (const auto& [token, frequency] : scaled) {
+        frequencies_.Emplace(token, frequency);
+    }
+}
+
+template <typename Token, std::integral CountTp>
+/*static*/ constexpr void RansTable<Token, CountTp>::DistributeRemainder(
+    std::vector<std::pair<Token, CountTp>>& scaled, size_t assigned,
+    size_t total_frequency) {
+    // Rounding errors are corrected on the most frequent tokens since their
+    // relative frequency changes the least
+    std::ranges::stable_sort(scaled, std::greater<>{},
+                             &std::pair<Token, CountTp>::second);
+
+    if (assigned < total_frequency) {
+        scaled.front().second += total_frequency - assigned;
+        return;
+    }
+
+    // Rare tokens that were raised to a single slot are paid off by the others
+    while (assigned > total_frequency) {
+        for (auto& [token, frequency] : scaled) {
+            if (assigned == total_frequency) {
+                break;
+            }
+            if (frequency > 1) {
+                --frequency;
+                --assigned;
+            }
+        }
+    }
+}
+
+template <typename Token, std::integral CountTp>
+constexpr void RansTable<Token, CountTp>::ValidateTable(
+    const Map<Token, CountTp>& count) const {
+    if (!precision_ || precision_ > kMaxPrecision) [[unlikely]] {
+        throw FormattedException{
+            "Precision ({}) has to be in the range [1, {}]",
+            static_cast<size_t>(precision_),
+            static_cast<size_t>(kMaxPrecision)};
+    }
+    // A single token receives the whole total frequency
+    if (total_frequency() > std::numeric_limits<CountTp>::max()) [[unlikely]] {
+        throw FormattedException{
+            "Total frequency ({}) of the precision ({}) does not fit the count "
+            "type",
+            total_frequency(), static_cast<size_t>(precision_)};
+    }
+    if (count.empty()) [[unlikely]] {
+        throw FormattedException{"Given count map is empty"};
+    }
+    if (count.size() > total_frequency()) [[unlikely]] {
+        throw FormattedException{
+            "Precision ({}) allows at most ({}) tokens, got ({})",
+            static_cast<size_t>(precision_), total_frequency(), count.size()};
+    }
+}
+
+}  // namespace koda
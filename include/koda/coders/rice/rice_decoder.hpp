@@ -1,6 +1,7 @@
 #pragma once
 
 #include <koda/coders/coder.hpp>
+#include <koda/coders/rice/rice_partition.hpp>
 #include <koda/utils/concepts.hpp>
 
 namespace koda {
@@ -12,6 +13,9 @@ class RiceDecoder : public DecoderInterface<Token, RiceDecoder<Token>> {
 
     constexpr explicit RiceDecoder(size_t order) noexcept;
 
+    /// Follows the partitions of the RiceEncoder in the adaptive mode
+    constexpr explicit RiceDecoder(RicePartitioning partitioning);
+
     constexpr auto Decode(BitInputRange auto&& input,
                           std::ranges::output_range<Token> auto&& output);
 
@@ -20,9 +24,29 @@ class RiceDecoder : public DecoderInterface<Token, RiceDecoder<Token>> {
    private:
     Token token_{};
     size_t order_;
-    uint8_t bits_ = 0;
+    // Number of remainder bits left to be read increased by one, zero when
+    // the quotient is being read
+    size_t bits_ = 0;
+    // Adaptive mode only, the order of the next partition is received or,
+    // in the backward adaptation, selected when no tokens are left in the
+    // current one
+    size_t partition_size_ = 0;
+    size_t left_ = 0;
+    uint64_t header_ = 0;
+    uint64_t sum_ = 0;
+    uint8_t header_size_ = 0;
+    bool backward_ = false;
+
+    constexpr auto ReceiveHeader(auto iter, const auto& sent);
+
+    constexpr void AdaptOrder() noexcept;
+
+    constexpr void CountToken(const Token& token) noexcept;
 
     constexpr auto DecodeToken(auto out_iter, auto iter, const auto& sent);
+
+    constexpr bool DecodeBufferedToken(auto& out_iter,
+                                       BitWordInputIterator auto& iter);
 };
 
 }  // namespace koda
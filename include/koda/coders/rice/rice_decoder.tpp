@@ -1,10 +1,28 @@
 #pragma once
 
+#include <koda/utils/utils.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <utility>
+
 namespace koda {
+
 template <UnsignedIntegral Token>
 constexpr RiceDecoder<Token>::RiceDecoder(size_t order) noexcept
     : order_{order} {}
 
+template <UnsignedIntegral Token>
+constexpr RiceDecoder<Token>::RiceDecoder(RicePartitioning partitioning)
+    : order_{0},
+      partition_size_{partitioning.partition_size},
+      backward_{partitioning.adaptation == RiceAdaptation::kBackward} {
+    if (!partition_size_) [[unlikely]] {
+        throw std::invalid_argument{"Partition size has to be positive"};
+    }
+}
+
 template <UnsignedIntegral Token>
 constexpr auto RiceDecoder<Token>::Decode(
     BitInputRange auto&& input,
@@ -16,6 +34,19 @@ constexpr auto RiceDecoder<Token>::Decode(
     auto out_sent = std::ranges::end(output);
 
     while ((in_iter != in_sent) && (out_iter != out_sent)) {
+        if (partition_size_ && !left_) {
+            if (backward_) {
+                AdaptOrder();
+            } else {
+                in_iter = ReceiveHeader(std::move(in_iter), in_sent);
+                continue;
+            }
+        }
+        if constexpr (BitWordInputIterator<decltype(in_iter)>) {
+            if (!bits_ && DecodeBufferedToken(out_iter, in_iter)) {
+                continue;
+            }
+        }
         std::tie(out_iter, in_iter) = DecodeToken(out_iter, in_iter, in_sent);
     }
 
@@ -31,26 +62,82 @@ constexpr auto RiceDecoder<Token>::Initialize(BitInputRange auto&& input) {
 template <UnsignedIntegral Token>
 constexpr auto RiceDecoder<Token>::DecodeToken(auto out_iter, auto iter,
                                                const auto& sent) {
-    bool last_iter = *iter++;
-    for (; !bits_ && !last_iter && (iter != sent); ++iter, ++token_) {
-        last_iter = *iter;
+    // Quotient is stored in the unary code terminated with one
+    for (; !bits_ && (iter != sent); ++iter) {
+        if (*iter) {
+            bits_ = order_ + 1;
+        } else {
+            ++token_;
+        }
     }
 
-    if (bits_) {
-        token_ = (token_ << 1) | last_iter;
-        --bits_;
-    } else if (last_iter) {
-        bits_ = order_;
+    for (; (bits_ > 1) && (iter != sent); ++iter, --bits_) {
+        token_ = (token_ << 1) | *iter;
     }
 
-    for (; bits_ && (iter != sent); ++iter) {
-        token_ = (token_ << 1) | *iter;
-        if (!--bits_) {
-            *out_iter++ = std::move(token_);
-            token_ = Token{};
-        }
+    if (bits_ == 1) {
+        CountToken(token_);
+        *out_iter++ = std::exchange(token_, Token{});
+        bits_ = 0;
     }
     return std::pair{std::move(out_iter), std::move(iter)};
 }
 
+template <UnsignedIntegral Token>
+constexpr bool RiceDecoder<Token>::DecodeBufferedToken(
+    auto& out_iter, BitWordInputIterator auto& iter) {
+    const uint8_t window = std::min(iter.Available(), iter.MaxPeekLength());
+    const uint64_t bits = iter.Peek(window);
+
+    // Long unary codes are skipped a whole window at once
+    if (!bits) {
+        token_ += window;
+        iter.Consume(window);
+        return true;
+    }
+
+    const size_t zeros = std::countr_zero(bits);
+    if (zeros + 1 + order_ > iter.Available()) {
+        // Code word is truncated, let the bit by bit path keep the state
+        return false;
+    }
+
+    iter.Consume(zeros + 1);
+    // Remainder is stored starting from the most significant bit
+    const auto remainder = ReverseBits(iter.ReadBits(order_), order_);
+    const auto token =
+        static_cast<Token>(((token_ + zeros) << order_) | remainder);
+    *out_iter++ = token;
+    token_ = Token{};
+    CountToken(token);
+    return true;
+}
+
+template <UnsignedIntegral Token>
+constexpr auto RiceDecoder<Token>::ReceiveHeader(auto iter, const auto& sent) {
+    iter = ReadBits(std::move(iter), sent, header_, header_size_,
+                    kRiceOrderBits<Token>);
+    if (header_size_ == kRiceOrderBits<Token>) {
+        order_ = std::exchange(header_, 0);
+        header_size_ = 0;
+        left_ = partition_size_;
+    }
+    return iter;
+}
+
+template <UnsignedIntegral Token>
+constexpr void RiceDecoder<Token>::AdaptOrder() noexcept {
+    order_ = SelectRiceOrder<Token>(sum_, partition_size_);
+    sum_ = 0;
+    left_ = partition_size_;
+}
+
+template <UnsignedIntegral Token>
+constexpr void RiceDecoder<Token>::CountToken(const Token& token) noexcept {
+    if (partition_size_) {
+        sum_ = AccumulateRiceSum(sum_, token);
+        --left_;
+    }
+}
+
 }  // namespace koda
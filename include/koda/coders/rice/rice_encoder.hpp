@@ -1,8 +1,11 @@
 #pragma once
 
 #include <koda/coders/coder.hpp>
+#include <koda/coders/rice/rice_partition.hpp>
 #include <koda/utils/concepts.hpp>
 
+#include <vector>
+
 namespace koda {
 
 template <UnsignedIntegral Token>
@@ -12,6 +15,14 @@ class RiceEncoder : public EncoderInterface<Token, RiceEncoder<Token>> {
 
     constexpr explicit RiceEncoder(size_t order);
 
+    /// In the forward adaptation tokens are buffered until the partition is
+    /// complete, then its order is selected and the whole partition is
+    /// encoded at once. In the backward one tokens are encoded right away
+    /// with the order selected for the previous partition
+    constexpr explicit RiceEncoder(RicePartitioning partitioning);
+
+    /// Adaptive modes estimate the size with the order the token would be
+    /// encoded with if it was the next one
     constexpr float TokenBitSize(Token token) const;
 
     constexpr auto Encode(InputRange<Token> auto&& input,
@@ -25,6 +36,25 @@ class RiceEncoder : public EncoderInterface<Token, RiceEncoder<Token>> {
     size_t limit_;
     size_t order_;
     size_t bits_ = 0;
+    // Adaptive mode only, the sealed partition has its order selected and
+    // is being emitted starting from its header
+    std::vector<Token> partition_;
+    size_t partition_size_ = 0;
+    size_t encoded_ = 0;
+    uint64_t header_ = 0;
+    uint8_t header_size_ = 0;
+    bool sealed_ = false;
+    bool backward_ = false;
+    // Sum of the tokens of the partition being collected and, in the
+    // backward adaptation, the number of tokens left in the current one
+    uint64_t sum_ = 0;
+    size_t left_ = 0;
+
+    constexpr void SetOrder(size_t order);
+
+    constexpr void AdaptOrder(const Token& token);
+
+    constexpr size_t NextTokenOrder(const Token& token) const;
 
     constexpr auto SetEmitter(const Token& token, auto iter);
 
@@ -32,6 +62,13 @@ class RiceEncoder : public EncoderInterface<Token, RiceEncoder<Token>> {
 
     constexpr auto EncodeTokens(InputRange<Token> auto&& input, auto iter,
                                 auto sentinel);
+
+    constexpr auto EncodePartitions(InputRange<Token> auto&& input, auto iter,
+                                    auto sentinel);
+
+    constexpr auto SealPartition(auto iter, const auto& sentinel);
+
+    constexpr auto FlushPartition(auto iter, const auto& sentinel);
 };
 
 }  // namespace koda
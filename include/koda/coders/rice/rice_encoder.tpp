@@ -1,5 +1,10 @@
 #pragma once
 
+#include <koda/utils/utils.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
 namespace koda {
 
 template <UnsignedIntegral Token>
@@ -8,9 +13,28 @@ constexpr RiceEncoder<Token>::RiceEncoder(size_t order)
       limit_{1 + order},
       order_{order} {}
 
+template <UnsignedIntegral Token>
+constexpr RiceEncoder<Token>::RiceEncoder(RicePartitioning partitioning)
+    : RiceEncoder{0} {
+    if (!partitioning.partition_size) [[unlikely]] {
+        throw std::invalid_argument{"Partition size has to be positive"};
+    }
+    partition_size_ = partitioning.partition_size;
+    backward_ = partitioning.adaptation == RiceAdaptation::kBackward;
+    if (!backward_) {
+        partition_.reserve(partition_size_);
+    }
+}
+
 template <UnsignedIntegral Token>
 constexpr float RiceEncoder<Token>::TokenBitSize(Token token) const {
-    return order_ + 1 + (token >> order_);
+    const size_t order = NextTokenOrder(token);
+    float size = order + 1 + (token >> order);
+    if (partition_size_ && !backward_) {
+        // Header is shared by the whole partition
+        size += static_cast<float>(kRiceOrderBits<Token>) / partition_size_;
+    }
+    return size;
 }
 
 template <UnsignedIntegral Token>
@@ -24,6 +48,11 @@ constexpr auto RiceEncoder<Token>::Encode(InputRange<Token> auto&& input,
                            std::move(iter), std::move(sentinel)};
     }
 
+    if (partition_size_ && !backward_) {
+        return EncodePartitions(std::forward<decltype(input)>(input),
+                                std::move(iter), std::move(sentinel));
+    }
+
     return EncodeTokens(std::forward<decltype(input)>(input), std::move(iter),
                         std::move(sentinel));
 }
@@ -31,8 +60,54 @@ constexpr auto RiceEncoder<Token>::Encode(InputRange<Token> auto&& input,
 template <UnsignedIntegral Token>
 constexpr auto RiceEncoder<Token>::Flush(BitOutputRange auto&& output) {
     auto sentinel = std::ranges::end(output);
-    return std::ranges::subrange{
-        FlushEmitter(std::ranges::begin(output), sentinel), sentinel};
+    auto iter = FlushEmitter(std::ranges::begin(output), sentinel);
+
+    if (partition_size_ && !backward_) {
+        // Last partition may be shorter, the decoder is given the number of
+        // tokens anyway
+        iter = FlushPartition(std::move(iter), sentinel);
+        if (!sealed_ && !partition_.empty()) {
+            iter = SealPartition(std::move(iter), sentinel);
+        }
+    }
+
+    return std::ranges::subrange{std::move(iter), std::move(sentinel)};
+}
+
+template <UnsignedIntegral Token>
+constexpr void RiceEncoder<Token>::SetOrder(size_t order) {
+    mask_ = static_cast<Token>((uint64_t{1} << order) - 1);
+    limit_ = 1 + order;
+    order_ = order;
+}
+
+template <UnsignedIntegral Token>
+constexpr void RiceEncoder<Token>::AdaptOrder(const Token& token) {
+    // Order changes only between the tokens so the emitter is never flushed
+    // with the order other than the one the token was set with
+    if (!left_) {
+        SetOrder(SelectRiceOrder<Token>(sum_, partition_size_));
+        sum_ = 0;
+        left_ = partition_size_;
+    }
+    sum_ = AccumulateRiceSum(sum_, token);
+    --left_;
+}
+
+template <UnsignedIntegral Token>
+constexpr size_t RiceEncoder<Token>::NextTokenOrder(const Token& token) const {
+    if (!partition_size_) {
+        return order_;
+    }
+    if (backward_) {
+        return left_ ? order_ : SelectRiceOrder<Token>(sum_, partition_size_);
+    }
+    // Sealed partition is being emitted, the token would start the next one
+    if (sealed_) {
+        return SelectRiceOrder<Token>(token, 1);
+    }
+    return SelectRiceOrder<Token>(AccumulateRiceSum(sum_, token),
+                                  partition_.size() + 1);
 }
 
 template <UnsignedIntegral Token>
@@ -48,19 +123,26 @@ constexpr auto RiceEncoder<Token>::FlushEmitter(auto iter, const auto& sent) {
         return iter;
     }
 
-    for (; (bits_ > limit_) && (iter != sent); ++iter, --bits_) {
-        *iter = 0;
-    }
-
-    if ((bits_ == limit_) && (iter != sent)) {
-        --bits_;
-        *iter++ = 1;
-    }
-
-    for (; (bits_ != 0) && (iter != sent); ++iter, --bits_) {
-        *iter = 1 & (token_ >> (bits_ - 1));
+    // Quotient's unary code is emitted in word-sized chunks of zeros
+    while (bits_ > limit_) {
+        uint64_t zeros = 0;
+        const uint8_t chunk = std::min<size_t>(bits_ - limit_, 64);
+        uint8_t left = chunk;
+        iter = WriteBits(std::move(iter), sent, zeros, left);
+        bits_ -= chunk - left;
+        if (left) {
+            return iter;
+        }
     }
 
+    // Terminating one and the remainder are emitted from the most
+    // significant bit so they have to be reversed first
+    uint64_t suffix = ReverseBits<uint64_t>(
+        ((uint64_t{1} << order_) | token_) & LowBitsMask<uint64_t>(bits_),
+        bits_);
+    uint8_t left = bits_;
+    iter = WriteBits(std::move(iter), sent, suffix, left);
+    bits_ = left;
     return iter;
 }
 
@@ -71,6 +153,9 @@ constexpr auto RiceEncoder<Token>::EncodeTokens(InputRange<Token> auto&& input,
     auto input_sent = std::ranges::end(input);
 
     for (; (iter != sentinel) && (input_iter != input_sent); ++input_iter) {
+        if (partition_size_) {
+            AdaptOrder(*input_iter);
+        }
         iter = SetEmitter(*input_iter, iter);
         iter = FlushEmitter(iter, sentinel);
     }
@@ -79,4 +164,59 @@ constexpr auto RiceEncoder<Token>::EncodeTokens(InputRange<Token> auto&& input,
                        std::move(iter), std::move(sentinel)};
 }
 
+template <UnsignedIntegral Token>
+constexpr auto RiceEncoder<Token>::EncodePartitions(
+    InputRange<Token> auto&& input, auto iter, auto sentinel) {
+    auto input_iter = std::ranges::begin(input);
+    auto input_sent = std::ranges::end(input);
+
+    iter = FlushPartition(std::move(iter), sentinel);
+    for (; (iter != sentinel) && (input_iter != input_sent); ++input_iter) {
+        partition_.push_back(*input_iter);
+        sum_ = AccumulateRiceSum(sum_, *input_iter);
+        if (partition_.size() == partition_size_) {
+            iter = SealPartition(std::move(iter), sentinel);
+        }
+    }
+
+    return CoderResult{std::move(input_iter), std::move(input_sent),
+                       std::move(iter), std::move(sentinel)};
+}
+
+template <UnsignedIntegral Token>
+constexpr auto RiceEncoder<Token>::SealPartition(auto iter,
+                                                 const auto& sentinel) {
+    SetOrder(SelectRiceOrder<Token>(sum_, partition_.size()));
+    sum_ = 0;
+    header_ = order_;
+    header_size_ = kRiceOrderBits<Token>;
+    sealed_ = true;
+    return FlushPartition(std::move(iter), sentinel);
+}
+
+template <UnsignedIntegral Token>
+constexpr auto RiceEncoder<Token>::FlushPartition(auto iter,
+                                                  const auto& sentinel) {
+    if (!sealed_) {
+        return iter;
+    }
+
+    iter = WriteBits(std::move(iter), sentinel, header_, header_size_);
+    iter = FlushEmitter(std::move(iter), sentinel);
+    while (!header_size_ && !bits_) {
+        if (encoded_ == partition_.size()) {
+            partition_.clear();
+            encoded_ = 0;
+            sealed_ = false;
+            break;
+        }
+        if (iter == sentinel) {
+            break;
+        }
+        iter = SetEmitter(partition_[encoded_++], std::move(iter));
+        iter = FlushEmitter(std::move(iter), sentinel);
+    }
+    return iter;
+}
+
 }  // namespace koda
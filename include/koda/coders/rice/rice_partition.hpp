@@ -0,0 +1,53 @@
+#pragma once
+
+#include <koda/utils/concepts.hpp>
+
+#include <bit>
+#include <cinttypes>
+#include <climits>
+#include <cstddef>
+#include <span>
+
+namespace koda {
+
+/// Selects how the order of the partition is chosen in the adaptive mode
+/// of the Rice coders. The forward adaptation precedes each partition with
+/// the header holding the order selected for its own tokens, partitions are
+/// emitted only when complete so this variant cannot share the stream with
+/// other coders. The backward adaptation encodes each partition with the
+/// order selected for the previous one, tokens are emitted right away and
+/// without headers so the variant works inside of the compound coders like
+/// the LzssIntermediateTokenEncoder
+enum class RiceAdaptation : uint8_t { kForward, kBackward };
+
+/// Selects the adaptive mode of the Rice coders. Tokens are split into
+/// partitions of partition_size tokens, each one encoded with its own order
+struct RicePartitioning {
+    size_t partition_size;
+    RiceAdaptation adaptation = RiceAdaptation::kForward;
+};
+
+/// Number of header bits needed to store any order valid for the token
+template <UnsignedIntegral Token>
+inline constexpr uint8_t kRiceOrderBits =
+    std::bit_width(sizeof(Token) * CHAR_BIT - 1);
+
+/// Estimates the order minimizing the encoded size of the partition from
+/// the sum of its tokens
+template <UnsignedIntegral Token>
+[[nodiscard]] constexpr uint8_t SelectRiceOrder(
+    std::span<const Token> partition) noexcept;
+
+template <UnsignedIntegral Token>
+[[nodiscard]] constexpr uint8_t SelectRiceOrder(uint64_t sum,
+                                                uint64_t count) noexcept;
+
+/// Adds the token to the sum of the partition, saturates instead of
+/// overflowing
+template <UnsignedIntegral Token>
+[[nodiscard]] constexpr uint64_t AccumulateRiceSum(uint64_t sum,
+                                                   Token token) noexcept;
+
+}  // namespace koda
+
+#include <koda/coders/rice/rice_partition.tpp>
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <limits>
+
+namespace koda {
+
+template <UnsignedIntegral Token>
+[[nodiscard]] constexpr uint8_t SelectRiceOrder(
+    std::span<const Token> partition) noexcept {
+    uint64_t sum = 0;
+    for (const Token& token : partition) {
+        sum = AccumulateRiceSum(sum, token);
+    }
+    return SelectRiceOrder<Token>(sum, partition.size());
+}
+
+template <UnsignedIntegral Token>
+[[nodiscard]] constexpr uint8_t SelectRiceOrder(uint64_t sum,
+                                                uint64_t count) noexcept {
+    // Each token costs order + 1 bits and its quotient, the quotients are
+    // approximated by the sum shifted by the order
+    uint8_t best_order = 0;
+    uint64_t best_size = std::numeric_limits<uint64_t>::max();
+    for (uint8_t order = 0; order < sizeof(Token) * CHAR_BIT; ++order) {
+        const uint64_t size = count * (order + 1) + (sum >> order);
+        if (size < best_size) {
+            best_size = size;
+            best_order = order;
+        }
+    }
+    return best_order;
+}
+
+template <UnsignedIntegral Token>
+[[nodiscard]] constexpr uint64_t AccumulateRiceSum(uint64_t sum,
+                                                   Token token) noexcept {
+    return (sum > std::numeric_limits<uint64_t>::max() - token)
+               ? std::numeric_limits<uint64_t>::max()
+               : sum + token;
+}
+
+}  // namespace koda
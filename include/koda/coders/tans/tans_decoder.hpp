@@ -3,15 +3,27 @@
 #include <koda/coders/coder.hpp>
 #include <koda/coders/tans/tans_table.hpp>
 #include <koda/collections/map.hpp>
+#include <koda/collections/token_table.hpp>
+
+#include <array>
 
 namespace koda {
 
-template <typename Token, typename Count, typename State = size_t>
-class TansDecoder : public DecoderInterface<Token, TansDecoder<Token, Count>> {
+/// Decodes the stream produced by the TansEncoder with the same number of
+/// interleaved states. The reversed stream starts with the final encoder
+/// states (the last used one first) and the states are used round-robin
+/// in the reversed order
+template <typename Token, typename Count, typename State = size_t,
+          size_t StateCount = 1>
+class TansDecoder
+    : public DecoderInterface<Token,
+                              TansDecoder<Token, Count, State, StateCount>> {
    public:
     using token_type = Token;
     using asymetrical = void;
 
+    static_assert(StateCount > 0, "At least one state is required");
+
     constexpr explicit TansDecoder(
         const TansInitTable<Token, Count>& init_table);
 
@@ -21,9 +33,6 @@ class TansDecoder : public DecoderInterface<Token, TansDecoder<Token, Count>> {
                           std::ranges::output_range<Token> auto&& output);
 
    private:
-    using BitIter = BigEndianOutputBitIter<State*>;
-    using BitRange = std::pair<BitIter, BitIter>;
-
     struct DecodingEntry {
         Token symbol;
         State next_state;
@@ -31,9 +40,13 @@ class TansDecoder : public DecoderInterface<Token, TansDecoder<Token, Count>> {
     };
 
     std::vector<DecodingEntry> decoding_table_;
-    BitRange receiver_;
-    State state_ = 0;
-    State received_bits_[1]{};
+    std::array<State, StateCount> states_ = {};
+    // State currently receiving its bits
+    size_t slot_ = 0;
+    size_t initialized_states_ = 0;
+    uint64_t receiver_ = 0;
+    uint8_t received_size_ = 0;
+    uint8_t receiver_size_;
 
     constexpr auto HandleDiracDelta(
         BitInputRange auto&& input,
@@ -41,6 +54,8 @@ class TansDecoder : public DecoderInterface<Token, TansDecoder<Token, Count>> {
 
     constexpr auto SetReceiver(auto iter, const auto& sent);
 
+    constexpr bool ReceiveState();
+
     constexpr Token DecodeToken();
 
     static constexpr std::vector<DecodingEntry> BuildDecodingTable(
@@ -6,22 +6,21 @@
 
 namespace koda {
 
-template <typename Token, typename Count, typename State>
-constexpr TansDecoder<Token, Count, State>::TansDecoder(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr TansDecoder<Token, Count, State, StateCount>::TansDecoder(
     const TansInitTable<Token, Count>& init_table)
     : decoding_table_{BuildDecodingTable(init_table)},
-      receiver_{BitIter{std::ranges::begin(received_bits_)},
-                BitIter{std::ranges::begin(received_bits_),
-                        IntFloorLog2(decoding_table_.size())}} {}
+      receiver_size_{
+          static_cast<uint8_t>(IntFloorLog2(decoding_table_.size()))} {}
 
-template <typename Token, typename Count, typename State>
-constexpr auto TansDecoder<Token, Count, State>::Initialize(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr auto TansDecoder<Token, Count, State, StateCount>::Initialize(
     BitInputRange auto&& input) {
     return std::forward<decltype(input)>(input);
 }
 
-template <typename Token, typename Count, typename State>
-constexpr auto TansDecoder<Token, Count, State>::Decode(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr auto TansDecoder<Token, Count, State, StateCount>::Decode(
     BitInputRange auto&& input,
     std::ranges::output_range<Token> auto&& output) {
     if (decoding_table_.size() == 1) {
@@ -36,8 +35,8 @@ constexpr auto TansDecoder<Token, Count, State>::Decode(
     auto out_sent = std::ranges::end(output);
 
     while ((in_iter != in_sent) && (out_iter != out_sent)) {
-        in_iter = SetReceiver(in_iter, in_sent);
-        if (receiver_.first == receiver_.second) {
+        in_iter = SetReceiver(std::move(in_iter), in_sent);
+        if ((received_size_ == receiver_size_) && ReceiveState()) {
             *out_iter++ = DecodeToken();
         }
     }
@@ -46,8 +45,8 @@ constexpr auto TansDecoder<Token, Count, State>::Decode(
                        std::move(out_iter), std::move(out_sent)};
 }
 
-template <typename Token, typename Count, typename State>
-constexpr auto TansDecoder<Token, Count, State>::HandleDiracDelta(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr auto TansDecoder<Token, Count, State, StateCount>::HandleDiracDelta(
     BitInputRange auto&& input,
     std::ranges::output_range<Token> auto&& output) {
     auto out_iter = std::ranges::begin(output);
@@ -58,46 +57,53 @@ constexpr auto TansDecoder<Token, Count, State>::HandleDiracDelta(
                        std::move(out_sent)};
 }
 
-template <typename Token, typename Count, typename State>
-constexpr auto TansDecoder<Token, Count, State>::SetReceiver(auto iter,
-                                                             const auto& sent) {
-    auto& state_iter = receiver_.first;
-    const auto& state_sent = receiver_.second;
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr auto TansDecoder<Token, Count, State, StateCount>::SetReceiver(
+    auto iter, const auto& sent) {
+    // Word iterators hand over the whole refill with a single register read,
+    // bits are copied one by one only when the input ends in the middle of it
+    return ReadBits(std::move(iter), sent, receiver_, received_size_,
+                    receiver_size_);
+}
 
-    for (; (iter != sent) && (state_iter != state_sent); ++iter, ++state_iter) {
-        *state_iter = *iter;
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr bool TansDecoder<Token, Count, State, StateCount>::ReceiveState() {
+    // State bits are received starting from the most significant one
+    states_[slot_] += ReverseBits(receiver_, received_size_);
+    receiver_ = received_size_ = 0;
+    slot_ = (slot_ + 1) % StateCount;
+
+    // Each final state has to be received before the first token is decoded
+    if ((initialized_states_ != StateCount) &&
+        (++initialized_states_ != StateCount)) {
+        receiver_size_ = IntFloorLog2(decoding_table_.size());
+        return false;
     }
-
-    return iter;
+    return true;
 }
 
-template <typename Token, typename Count, typename State>
-constexpr Token TansDecoder<Token, Count, State>::DecodeToken() {
-    receiver_.first.Flush();
-    state_ += received_bits_[0] >> receiver_.second.Position();
-
-    const auto& decoding_entry = decoding_table_[state_];
-    Token token = decoding_entry.symbol;
-    state_ = decoding_entry.next_state;
-
-    receiver_ = {
-        BitIter{std::ranges::begin(received_bits_)},
-        BitIter{std::ranges::begin(received_bits_), decoding_entry.bit_count}};
-    return token;
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr Token TansDecoder<Token, Count, State, StateCount>::DecodeToken() {
+    // Decoded state receives the bits that were emitted with its token
+    State& state = states_[slot_];
+    const auto& decoding_entry = decoding_table_[state];
+    state = decoding_entry.next_state;
+    receiver_size_ = decoding_entry.bit_count;
+    return decoding_entry.symbol;
 }
 
-template <typename Token, typename Count, typename State>
+template <typename Token, typename Count, typename State, size_t StateCount>
 /*static*/ constexpr std::vector<
-    typename TansDecoder<Token, Count, State>::DecodingEntry>
-TansDecoder<Token, Count, State>::BuildDecodingTable(
+    typename TansDecoder<Token, Count, State, StateCount>::DecodingEntry>
+TansDecoder<Token, Count, State, StateCount>::BuildDecodingTable(
     const TansInitTable<Token, Count>& init_table) {
     const auto number_of_states = init_table.number_of_states();
     std::vector<DecodingEntry> decoding_table;
     decoding_table.reserve(number_of_states);
-    Map<Token, Count> next = init_table.states_per_token();
+    TokenTable<Token, Count> next{init_table.states_per_token()};
 
     for (const auto& token : init_table.state_table()) {
-        auto state = next.At(token)++;
+        auto state = next[token]++;
         uint8_t bit_count =
             IntFloorLog2(number_of_states) - IntFloorLog2(state);
         auto new_state = (state << bit_count) - number_of_states;
@@ -3,15 +3,27 @@
 #include <koda/coders/coder.hpp>
 #include <koda/coders/tans/tans_table.hpp>
 #include <koda/collections/map.hpp>
+#include <koda/collections/token_table.hpp>
+
+#include <array>
 
 namespace koda {
 
-template <typename Token, typename Count, typename State = size_t>
-class TansEncoder : public EncoderInterface<Token, TansEncoder<Token, Count>> {
+/// Tokens are encoded round-robin with StateCount independent states that
+/// share the encoding table and the output stream. Using more than one state
+/// breaks the dependency between consecutive decoding steps so they can be
+/// overlapped by the processor
+template <typename Token, typename Count, typename State = size_t,
+          size_t StateCount = 1>
+class TansEncoder
+    : public EncoderInterface<Token,
+                              TansEncoder<Token, Count, State, StateCount>> {
    public:
     using asymetrical = void;
     using token_type = Token;
 
+    static_assert(StateCount > 0, "At least one state is required");
+
     constexpr explicit TansEncoder(
         const TansInitTable<Token, Count>& init_table);
 
@@ -24,16 +36,22 @@ class TansEncoder : public EncoderInterface<Token, TansEncoder<Token, Count>> {
 
    private:
     using SState = std::make_signed_t<State>;
-    using BitIter = LittleEndianInputBitIter<const State*>;
-    using BitRange = std::pair<BitIter, BitIter>;
 
-    Map<Token, uint8_t> saturation_map_;
-    Map<Token, SState> offset_map_;
-    Map<Token, State> renorm_map_;
+    /// Parameters used by every encoded token are kept together so they are
+    /// fetched with a single lookup (and never span two cache lines)
+    struct alignas(2 * sizeof(State)) SymbolTransform {
+        State renormalization;
+        SState start_offset;
+    };
+
+    TokenTable<Token, SymbolTransform> transforms_;
+    TokenTable<Token, uint8_t> saturations_;
     std::vector<State> encoding_table_;
-    BitRange emitter_;
-    State state_;
-    State emitted_bits_[1];
+    std::array<State, StateCount> states_ = {};
+    size_t slot_ = 0;
+    size_t flushed_states_ = 0;
+    uint64_t emitter_ = 0;
+    uint8_t emitter_size_ = 0;
     uint8_t shift_;
 
     constexpr auto EncodeTokens(InputRange<Token> auto&& input, auto iter,
@@ -41,23 +59,19 @@ class TansEncoder : public EncoderInterface<Token, TansEncoder<Token, Count>> {
 
     constexpr void EncodeToken(const auto& token);
 
-    constexpr void SetEmitter(Count bit_count);
+    constexpr void SetEmitter(State value, Count bit_count);
 
     constexpr auto FlushEmitter(auto output_iter, const auto& output_sent);
 
-    static constexpr Map<Token, uint8_t> BuildSaturationMap(
+    static constexpr TokenTable<Token, uint8_t> BuildSaturations(
         const TansInitTable<Token, Count>& init_table);
 
-    static constexpr Map<Token, State> BuildRenormalizationOffsetMap(
-        const TansInitTable<Token, Count>& init_table,
-        const Map<Token, uint8_t>& saturation_map);
-
-    static constexpr Map<Token, SState> BuildStartOffsetMap(
+    static constexpr TokenTable<Token, SymbolTransform> BuildSymbolTransforms(
         const TansInitTable<Token, Count>& init_table);
 
     static constexpr std::vector<State> BuildEncodingTable(
         const TansInitTable<Token, Count>& init_table,
-        const Map<Token, SState>& start_offset_map);
+        const TokenTable<Token, SymbolTransform>& transforms);
 };
 
 }  // namespace koda
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <koda/utils/formatted_exception.hpp>
 #include <koda/utils/utils.hpp>
 
 #include <cassert>
@@ -8,25 +9,25 @@
 
 namespace koda {
 
-template <typename Token, typename Count, typename State>
-constexpr TansEncoder<Token, Count, State>::TansEncoder(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr TansEncoder<Token, Count, State, StateCount>::TansEncoder(
     const TansInitTable<Token, Count>& init_table)
-    : saturation_map_{BuildSaturationMap(init_table)},
-      offset_map_{BuildStartOffsetMap(init_table)},
-      renorm_map_{BuildRenormalizationOffsetMap(init_table, saturation_map_)},
-      encoding_table_{BuildEncodingTable(init_table, offset_map_)},
-      state_{init_table.number_of_states()},
+    : transforms_{BuildSymbolTransforms(init_table)},
+      saturations_{BuildSaturations(init_table)},
+      encoding_table_{BuildEncodingTable(init_table, transforms_)},
       shift_{static_cast<uint8_t>(
-          1 + IntFloorLog2(init_table.number_of_states()))} {}
+          1 + IntFloorLog2(init_table.number_of_states()))} {
+    states_.fill(init_table.number_of_states());
+}
 
-template <typename Token, typename Count, typename State>
-constexpr float TansEncoder<Token, Count, State>::TokenBitSize(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr float TansEncoder<Token, Count, State, StateCount>::TokenBitSize(
     Token token) const {
-    return saturation_map_.At(token);
+    return saturations_.At(token);
 }
 
-template <typename Token, typename Count, typename State>
-constexpr auto TansEncoder<Token, Count, State>::Encode(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr auto TansEncoder<Token, Count, State, StateCount>::Encode(
     InputRange<Token> auto&& input, BitOutputRange auto&& output) {
     auto sentinel = std::ranges::end(output);
     auto iter = FlushEmitter(std::ranges::begin(output), sentinel);
@@ -40,26 +41,31 @@ constexpr auto TansEncoder<Token, Count, State>::Encode(
                         std::move(sentinel));
 }
 
-template <typename Token, typename Count, typename State>
-constexpr auto TansEncoder<Token, Count, State>::Flush(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr auto TansEncoder<Token, Count, State, StateCount>::Flush(
     BitOutputRange auto&& output) {
     auto sentinel = std::ranges::end(output);
     auto iter = FlushEmitter(std::ranges::begin(output), sentinel);
 
-    if (iter == sentinel || encoding_table_.empty()) {
+    if (encoding_table_.empty()) {
         return std::ranges::subrange{std::move(iter), std::move(sentinel)};
     }
 
-    // Encode final state with uniform distrib to simplify process
-    state_ -= encoding_table_.size();
-    SetEmitter(IntFloorLog2(encoding_table_.size()));
+    // Final states are encoded with uniform distrib to simplify process. They
+    // are emitted starting from the one following the last used state so the
+    // decoder reading the reversed stream receives the last used one first
+    while ((iter != sentinel) && (flushed_states_ != StateCount)) {
+        const State state = states_[(slot_ + flushed_states_++) % StateCount];
+        SetEmitter(state - encoding_table_.size(),
+                   IntFloorLog2(encoding_table_.size()));
+        iter = FlushEmitter(std::move(iter), sentinel);
+    }
 
-    return std::ranges::subrange{FlushEmitter(std::move(iter), sentinel),
-                                 sentinel};
+    return std::ranges::subrange{std::move(iter), std::move(sentinel)};
 }
 
-template <typename Token, typename Count, typename State>
-constexpr auto TansEncoder<Token, Count, State>::EncodeTokens(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr auto TansEncoder<Token, Count, State, StateCount>::EncodeTokens(
     InputRange<Token> auto&& input, auto iter, auto sentinel) {
     auto input_iter = std::ranges::begin(input);
     auto input_sent = std::ranges::end(input);
@@ -73,96 +79,89 @@ constexpr auto TansEncoder<Token, Count, State>::EncodeTokens(
                        std::move(iter), std::move(sentinel)};
 }
 
-template <typename Token, typename Count, typename State>
-constexpr void TansEncoder<Token, Count, State>::EncodeToken(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr void TansEncoder<Token, Count, State, StateCount>::EncodeToken(
     const auto& token) {
-    auto bit_count = (state_ + renorm_map_.At(token)) >> shift_;
+    const SymbolTransform* transform = transforms_.Find(token);
+    if (!transform) [[unlikely]] {
+        throw FormattedException{"Token is not described by the tANS table"};
+    }
+    State& state = states_[slot_];
+    auto bit_count = (state + transform->renormalization) >> shift_;
     assert(bit_count <= CHAR_BIT * sizeof(Count));
-    SetEmitter(bit_count);
-    state_ = encoding_table_[offset_map_.At(token) + (state_ >> bit_count)];
+    SetEmitter(state, bit_count);
+    state = encoding_table_[transform->start_offset + (state >> bit_count)];
+    slot_ = (slot_ + 1) % StateCount;
 }
 
-template <typename Token, typename Count, typename State>
-constexpr void TansEncoder<Token, Count, State>::SetEmitter(Count bit_count) {
-    emitted_bits_[0] = state_;
-    emitter_ = std::pair{BitIter{std::ranges::begin(emitted_bits_)},
-                         BitIter{std::ranges::begin(emitted_bits_), bit_count}};
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr void TansEncoder<Token, Count, State, StateCount>::SetEmitter(
+    State value, Count bit_count) {
+    emitter_ = value;
+    emitter_size_ = bit_count;
 }
 
-template <typename Token, typename Count, typename State>
-constexpr auto TansEncoder<Token, Count, State>::FlushEmitter(
+template <typename Token, typename Count, typename State, size_t StateCount>
+constexpr auto TansEncoder<Token, Count, State, StateCount>::FlushEmitter(
     auto output_iter, const auto& output_sent) {
-    auto& bit_iter = emitter_.first;
-    const auto& bit_sent = emitter_.second;
-
-    for (; (bit_iter != bit_sent) && (output_iter != output_sent);
-         ++output_iter, ++bit_iter) {
-        *output_iter = *bit_iter;
-    }
-    return output_iter;
+    return WriteBits(std::move(output_iter), output_sent, emitter_,
+                     emitter_size_);
 }
 
-template <typename Token, typename Count, typename State>
-/*static*/ constexpr Map<Token, uint8_t>
-TansEncoder<Token, Count, State>::BuildSaturationMap(
+template <typename Token, typename Count, typename State, size_t StateCount>
+/*static*/ constexpr TokenTable<Token, uint8_t>
+TansEncoder<Token, Count, State, StateCount>::BuildSaturations(
     const TansInitTable<Token, Count>& init_table) {
-    return Map<Token, uint8_t>{
+    return TokenTable<Token, uint8_t>{
         init_table.states_per_token() |
         std::views::transform(
             [max_bit_size = IntFloorLog2(init_table.number_of_states())](
                 const auto& entry) {
                 const auto& [token, count] = entry;
-                return std::pair{token, max_bit_size - IntFloorLog2(count)};
-            })};
-}
-
-template <typename Token, typename Count, typename State>
-/*static*/ constexpr Map<Token, State>
-TansEncoder<Token, Count, State>::BuildRenormalizationOffsetMap(
-    const TansInitTable<Token, Count>& init_table,
-    const Map<Token, uint8_t>& saturation_map) {
-    return Map<Token, Count>{
-        BuildSaturationMap(init_table) |
-        std::views::transform(
-            [&, max_bit_size = 1 + IntFloorLog2(init_table.number_of_states())](
-                const auto& saturation_tuple) {
-                const auto& [token, saturation] = saturation_tuple;
-                auto max = saturation << max_bit_size;
-                auto min = init_table.states_per_token().At(token)
-                           << saturation;
-                return std::pair{token, max > min ? (max - min) : 0};
+                return std::pair{
+                    token,
+                    static_cast<uint8_t>(max_bit_size - IntFloorLog2(count))};
             })};
 }
 
-template <typename Token, typename Count, typename State>
-/*static*/ constexpr Map<Token,
-                         typename TansEncoder<Token, Count, State>::SState>
-TansEncoder<Token, Count, State>::BuildStartOffsetMap(
+template <typename Token, typename Count, typename State, size_t StateCount>
+/*static*/ constexpr TokenTable<
+    Token,
+    typename TansEncoder<Token, Count, State, StateCount>::SymbolTransform>
+TansEncoder<Token, Count, State, StateCount>::BuildSymbolTransforms(
     const TansInitTable<Token, Count>& init_table) {
-    return Map<Token, SState>{
-        init_table.states_per_token() |
-        std::views::transform([accumulator =
-                                   Count{0}](const auto& entry) mutable {
-            const auto& [token, count] = entry;
-            SState offset =
-                static_cast<SState>(accumulator) - static_cast<SState>(count);
-            accumulator += count;
-            return std::pair{token, offset};
-        })};
+    const auto max_bit_size = IntFloorLog2(init_table.number_of_states());
+    TokenTable<Token, SymbolTransform> transforms;
+    Count accumulator = 0;
+
+    for (const auto& [token, count] : init_table.states_per_token()) {
+        const auto saturation = max_bit_size - IntFloorLog2(count);
+        const auto max = saturation << (max_bit_size + 1);
+        const auto min = count << saturation;
+        transforms.Insert(
+            token,
+            SymbolTransform{
+                .renormalization = static_cast<State>(max > min ? (max - min)
+                                                                : 0),
+                .start_offset = static_cast<SState>(accumulator) -
+                                static_cast<SState>(count)});
+        accumulator += count;
+    }
+    return transforms;
 }
 
-template <typename Token, typename Count, typename State>
+template <typename Token, typename Count, typename State, size_t StateCount>
 /*static*/ constexpr std::vector<State>
-TansEncoder<Token, Count, State>::BuildEncodingTable(
+TansEncoder<Token, Count, State, StateCount>::BuildEncodingTable(
     const TansInitTable<Token, Count>& init_table,
-    const Map<Token, SState>& start_offset_map) {
+    const TokenTable<Token, SymbolTransform>& transforms) {
     const auto number_of_states = init_table.number_of_states();
     std::vector<Count> encoding_table(number_of_states);
-    Map<Token, Count> next = init_table.states_per_token();
+    TokenTable<Token, Count> next{init_table.states_per_token()};
 
     for (const auto& [index, token] :
          std::views::enumerate(init_table.state_table())) {
-        encoding_table[next.At(token)++ + start_offset_map.At(token)] =
+        encoding_table[next[token]++ + transforms[token].start_offset] =
             index + number_of_states;
     }
 
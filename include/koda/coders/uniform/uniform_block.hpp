@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstdlib>
+
+namespace koda::details {
+
+/// Number of the tokens packed at once, a block of the tokens of any bit size
+/// fills whole 64-bit words
+inline constexpr size_t kUniformBlockSize = 128;
+
+/// Packs the block of the tokens widened to the 64-bit lanes into the
+/// kUniformBlockSize * token_bit_size / 64 words. Adjacent lanes are merged
+/// in the vector registers as long as the merged group fits the lane, the
+/// groups are then concatenated into the words. The lanes are overwritten
+inline void PackUniformBlock(uint64_t* lanes, uint8_t token_bit_size,
+                             uint64_t* words);
+
+/// Reverses the PackUniformBlock, the tokens are written to the lanes
+inline void UnpackUniformBlock(const uint64_t* words, uint8_t token_bit_size,
+                               uint64_t* lanes);
+
+// Merges every pair of the lanes of the given width into the lower half of
+// the lanes
+inline void MergeLanePairs(uint64_t* lanes, size_t count, uint8_t width);
+
+// Splits the lower half of the lanes into the pairs of the given width, the
+// count is the number of the lanes after the split
+inline void SplitLanePairs(uint64_t* lanes, size_t count, uint8_t width);
+
+}  // namespace koda::details
+
+#include <koda/coders/uniform/uniform_block.ipp>
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <koda/utils/utils.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace koda::details {
+
+inline void PackUniformBlock(uint64_t* lanes, uint8_t token_bit_size,
+                             uint64_t* words) {
+    assert(token_bit_size && token_bit_size <= 64 &&
+           "Token bit size has to be in the range [1, 64]");
+    size_t count = kUniformBlockSize;
+    uint8_t width = token_bit_size;
+    for (; 2 * width <= 64; width *= 2, count /= 2) {
+        MergeLanePairs(lanes, count, width);
+    }
+
+    std::fill_n(words, kUniformBlockSize * token_bit_size / 64, 0);
+    for (size_t index = 0, position = 0; index < count;
+         ++index, position += width) {
+        const size_t shift = position % 64;
+        words[position / 64] |= lanes[index] << shift;
+        if (shift + width > 64) {
+            words[position / 64 + 1] |= lanes[index] >> (64 - shift);
+        }
+    }
+}
+
+inline void UnpackUniformBlock(const uint64_t* words, uint8_t token_bit_size,
+                               uint64_t* lanes) {
+    assert(token_bit_size && token_bit_size <= 64 &&
+           "Token bit size has to be in the range [1, 64]");
+    size_t count = kUniformBlockSize;
+    uint8_t width = token_bit_size;
+    for (; 2 * width <= 64; width *= 2) {
+        count /= 2;
+    }
+
+    const uint64_t mask = LowBitsMask<uint64_t>(width);
+    for (size_t index = 0, position = 0; index < count;
+         ++index, position += width) {
+        const size_t shift = position % 64;
+        uint64_t group = words[position / 64] >> shift;
+        if (shift + width > 64) {
+            group |= words[position / 64 + 1] << (64 - shift);
+        }
+        lanes[index] = group & mask;
+    }
+
+    while (width != token_bit_size) {
+        width /= 2;
+        count *= 2;
+        SplitLanePairs(lanes, count, width);
+    }
+}
+
+inline void MergeLanePairs(uint64_t* lanes, size_t count, uint8_t width) {
+    size_t index = 0;
+    // Merged lanes are stored below the ones that are still to be loaded
+#if defined(__AVX2__)
+    const __m128i shift = _mm_cvtsi32_si128(width);
+    for (; index + 8 <= count; index += 8) {
+        const __m256i first =
+            _mm256_loadu_si256(reinterpret_cast<const __m256i*>(lanes + index));
+        const __m256i second = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(lanes + index + 4));
+        // Unpacking works within the 128-bit halves, the cross-lane
+        // permutation puts the merged pairs back in order
+        const __m256i merged = _mm256_or_si256(
+            _mm256_unpacklo_epi64(first, second),
+            _mm256_sll_epi64(_mm256_unpackhi_epi64(first, second), shift));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + index / 2),
+                            _mm256_permute4x64_epi64(merged, 0xD8));
+    }
+#elif defined(__SSE2__)
+    const __m128i shift = _mm_cvtsi32_si128(width);
+    for (; index + 4 <= count; index += 4) {
+        const __m128i first =
+            _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes + index));
+        const __m128i second = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(lanes + index + 2));
+        _mm_storeu_si128(
+            reinterpret_cast<__m128i*>(lanes + index / 2),
+            _mm_or_si128(
+                _mm_unpacklo_epi64(first, second),
+                _mm_sll_epi64(_mm_unpackhi_epi64(first, second), shift)));
+    }
+#endif
+    for (; index < count; index += 2) {
+        lanes[index / 2] = lanes[index] | (lanes[index + 1] << width);
+    }
+}
+
+inline void SplitLanePairs(uint64_t* lanes, size_t count, uint8_t width) {
+    size_t index = count;
+    // Pairs are split from the top so no group is overwritten before it is
+    // loaded
+#if defined(__AVX2__)
+    const __m256i mask =
+        _mm256_set1_epi64x(static_cast<int64_t>(LowBitsMask<uint64_t>(width)));
+    const __m128i shift = _mm_cvtsi32_si128(width);
+    for (; index >= 8; index -= 8) {
+        const __m256i groups = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(lanes + (index - 8) / 2));
+        const __m256i low = _mm256_and_si256(groups, mask);
+        const __m256i high = _mm256_srl_epi64(groups, shift);
+        const __m256i even = _mm256_unpacklo_epi64(low, high);
+        const __m256i odd = _mm256_unpackhi_epi64(low, high);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + index - 8),
+                            _mm256_permute2x128_si256(even, odd, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes + index - 4),
+                            _mm256_permute2x128_si256(even, odd, 0x31));
+    }
+#elif defined(__SSE2__)
+    const __m128i mask =
+        _mm_set1_epi64x(static_cast<int64_t>(LowBitsMask<uint64_t>(width)));
+    const __m128i shift = _mm_cvtsi32_si128(width);
+    for (; index >= 4; index -= 4) {
+        const __m128i groups = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(lanes + (index - 4) / 2));
+        const __m128i low = _mm_and_si128(groups, mask);
+        const __m128i high = _mm_srl_epi64(groups, shift);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + index - 4),
+                         _mm_unpacklo_epi64(low, high));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes + index - 2),
+                         _mm_unpackhi_epi64(low, high));
+    }
+#endif
+    for (; index; index -= 2) {
+        const uint64_t group = lanes[index / 2 - 1];
+        lanes[index - 2] = group & LowBitsMask<uint64_t>(width);
+        lanes[index - 1] = group >> width;
+    }
+}
+
+}  // namespace koda::details
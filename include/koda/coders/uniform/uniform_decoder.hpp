@@ -1,6 +1,7 @@
 #pragma once
 
 #include <koda/coders/coder.hpp>
+#include <koda/coders/uniform/uniform_block.hpp>
 
 namespace koda {
 
@@ -12,26 +13,27 @@ class UniformDecoder : public DecoderInterface<Token, UniformDecoder<Token>> {
     constexpr explicit UniformDecoder(
         size_t token_bit_size = sizeof(Token) * CHAR_BIT) noexcept;
 
-    constexpr UniformDecoder(const UniformDecoder& other) noexcept;
-
-    constexpr UniformDecoder& operator=(const UniformDecoder& other);
-
     constexpr auto Decode(BitInputRange auto&& input,
                           std::ranges::output_range<Token> auto&& output);
 
     constexpr auto Initialize(BitInputRange auto&& input);
 
    private:
-    using BitIter = LittleEndianOutputBitIter<Token*>;
-    using BitRange = std::pair<BitIter, BitIter>;
-
-    Token token_[1]{};
-    BitRange receiver_;
-    size_t token_bit_size_;
+    uint64_t receiver_ = 0;
+    uint8_t received_size_ = 0;
+    uint8_t token_bit_size_;
 
     constexpr auto SetReceiver(auto iter, const auto& sent);
 
     constexpr Token DecodeToken();
+
+    constexpr void UnpackTokens(BitWordInputIterator auto& iter,
+                                auto& out_iter, const auto& out_sent);
+
+    // Contiguous output is unpacked by whole blocks outside of the constant
+    // evaluation
+    void DecodeBlocks(BitWordInputIterator auto& iter, auto& out_iter,
+                      const auto& out_sent);
 };
 
 }  // namespace koda
@@ -1,38 +1,17 @@
 #pragma once
 
-namespace koda {
+#include <koda/utils/utils.hpp>
 
-template <std::integral Token>
-constexpr UniformDecoder<Token>::UniformDecoder(size_t token_bit_size) noexcept
-    : receiver_{BitIter{std::ranges::begin(token_)},
-                token_bit_size == (sizeof(Token) * CHAR_BIT)
-                    ? BitIter{std::ranges::end(token_)}
-                    : BitIter{std::ranges::begin(token_), token_bit_size}},
-      token_bit_size_{token_bit_size} {}
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <memory>
 
-template <std::integral Token>
-constexpr UniformDecoder<Token>::UniformDecoder(
-    const UniformDecoder& other) noexcept
-    : token_{other.token_[0]},
-      receiver_{other.receiver_.first.Rebind(std::ranges::begin(token_)),
-                other.receiver_.second.Rebind(
-                    other.token_bit_size_ == (sizeof(Token) * CHAR_BIT)
-                        ? std::ranges::end(token_)
-                        : std::ranges::begin(token_))},
-      token_bit_size_{other.token_bit_size_} {}
+namespace koda {
 
 template <std::integral Token>
-constexpr UniformDecoder<Token>& UniformDecoder<Token>::operator=(
-    const UniformDecoder& other) {
-    token_bit_size_ = other.token_bit_size_;
-    token_[0] = other.token_[0];
-    receiver_ = {other.receiver_.first.Rebind(std::ranges::begin(token_)),
-                 other.receiver_.second.Rebind(
-                     other.token_bit_size_ == (sizeof(Token) * CHAR_BIT)
-                         ? std::ranges::end(token_)
-                         : std::ranges::begin(token_))};
-    return *this;
-}
+constexpr UniformDecoder<Token>::UniformDecoder(size_t token_bit_size) noexcept
+    : token_bit_size_{static_cast<uint8_t>(token_bit_size)} {}
 
 template <std::integral Token>
 constexpr auto UniformDecoder<Token>::Decode(
@@ -44,9 +23,29 @@ constexpr auto UniformDecoder<Token>::Decode(
     auto out_iter = std::ranges::begin(output);
     auto out_sent = std::ranges::end(output);
 
+    if constexpr (BitWordInputIterator<decltype(in_iter)>) {
+        if constexpr (std::contiguous_iterator<decltype(out_iter)> &&
+                      std::same_as<std::iter_value_t<decltype(out_iter)>,
+                                   Token> &&
+                      std::sized_sentinel_for<decltype(out_sent),
+                                              decltype(out_iter)>) {
+            if !consteval {
+                DecodeBlocks(in_iter, out_iter, out_sent);
+            }
+        }
+        // Several tokens are unpacked from a single peeked word as long as
+        // no token is partially received
+        while (token_bit_size_ && !received_size_ && (in_iter != in_sent) &&
+               (out_iter != out_sent) &&
+               (2 * token_bit_size_ <= in_iter.MaxPeekLength()) &&
+               (in_iter.Available() >= 2 * token_bit_size_)) {
+            UnpackTokens(in_iter, out_iter, out_sent);
+        }
+    }
+
     while ((in_iter != in_sent) && (out_iter != out_sent)) {
-        in_iter = SetReceiver(in_iter, in_sent);
-        if (receiver_.first == receiver_.second) {
+        in_iter = SetReceiver(std::move(in_iter), in_sent);
+        if (received_size_ == token_bit_size_) {
             *out_iter++ = DecodeToken();
         }
     }
@@ -62,27 +61,58 @@ constexpr auto UniformDecoder<Token>::Initialize(BitInputRange auto&& input) {
 
 template <std::integral Token>
 constexpr auto UniformDecoder<Token>::SetReceiver(auto iter, const auto& sent) {
-    auto& state_iter = receiver_.first;
-    const auto& state_sent = receiver_.second;
-
-    for (; (iter != sent) && (state_iter != state_sent); ++iter, ++state_iter) {
-        *state_iter = *iter;
-    }
-
-    return iter;
+    return ReadBits(std::move(iter), sent, receiver_, received_size_,
+                    token_bit_size_);
 }
 
 template <std::integral Token>
 constexpr Token UniformDecoder<Token>::DecodeToken() {
-    receiver_.first.Flush();
-    Token token = token_[0];
-    token_[0] = {};
-    receiver_ =
-        std::pair{BitIter{std::ranges::begin(token_)},
-                  (token_bit_size_ == (sizeof(Token) * CHAR_BIT)
-                       ? BitIter{std::ranges::end(token_)}
-                       : BitIter{std::ranges::begin(token_), token_bit_size_})};
+    Token token = static_cast<Token>(receiver_);
+    receiver_ = received_size_ = 0;
     return token;
 }
 
+template <std::integral Token>
+constexpr void UniformDecoder<Token>::UnpackTokens(
+    BitWordInputIterator auto& iter, auto& out_iter, const auto& out_sent) {
+    const size_t count =
+        std::min(iter.Available(), iter.MaxPeekLength()) / token_bit_size_;
+    const uint64_t mask = LowBitsMask<uint64_t>(token_bit_size_);
+    uint64_t bits = iter.Peek(count * token_bit_size_);
+
+    size_t unpacked = 0;
+    for (; (unpacked != count) && (out_iter != out_sent); ++unpacked) {
+        *out_iter++ = static_cast<Token>(bits & mask);
+        bits >>= token_bit_size_;
+    }
+    iter.Consume(unpacked * token_bit_size_);
+}
+
+template <std::integral Token>
+void UniformDecoder<Token>::DecodeBlocks(BitWordInputIterator auto& iter,
+                                         auto& out_iter,
+                                         const auto& out_sent) {
+    if (!token_bit_size_ || token_bit_size_ > 64 || received_size_) {
+        return;
+    }
+
+    const size_t word_count = details::kUniformBlockSize * token_bit_size_ / 64;
+    std::array<uint64_t, details::kUniformBlockSize> words;
+    std::array<uint64_t, details::kUniformBlockSize> lanes;
+    while ((out_sent - out_iter >=
+            static_cast<std::ptrdiff_t>(details::kUniformBlockSize)) &&
+           (iter.Available() >= details::kUniformBlockSize * token_bit_size_)) {
+        for (size_t index = 0; index < word_count; ++index) {
+            words[index] = iter.ReadBits(64);
+        }
+        details::UnpackUniformBlock(words.data(), token_bit_size_,
+                                    lanes.data());
+        Token* tokens = std::to_address(out_iter);
+        for (size_t index = 0; index < details::kUniformBlockSize; ++index) {
+            tokens[index] = static_cast<Token>(lanes[index]);
+        }
+        out_iter += details::kUniformBlockSize;
+    }
+}
+
 }  // namespace koda
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <koda/coders/coder.hpp>
+#include <koda/coders/uniform/uniform_block.hpp>
 
 namespace koda {
 
@@ -20,19 +21,25 @@ class UniformEncoder : public EncoderInterface<Token, UniformEncoder<Token>> {
     constexpr auto Flush(BitOutputRange auto&& output);
 
    private:
-    using BitIter = LittleEndianInputBitIter<const Token*>;
-    using BitRange = std::pair<BitIter, BitIter>;
+    static constexpr uint8_t kEmitterBits = 64;
 
-    Token token_[1];
-    BitRange emitter_;
+    uint64_t emitter_ = 0;
+    uint8_t emitter_size_ = 0;
     size_t token_bit_size_;
 
     constexpr auto EncodeTokens(InputRange<Token> auto&& input, auto iter,
                                 auto sentinel);
 
+    // Contiguous input is packed by whole blocks outside of the constant
+    // evaluation
+    auto EncodeBlocks(auto& input_iter, const auto& input_sent, auto iter,
+                      const auto& sentinel);
+
     constexpr auto FlushEmitter(auto output_iter, const auto& output_sent);
 
     constexpr void SetEmitter(const Token& token);
+
+    constexpr void PackTokens(auto& input_iter, const auto& input_sent);
 };
 
 }  // namespace koda
@@ -1,6 +1,11 @@
 #pragma once
 
+#include <koda/utils/utils.hpp>
+
+#include <array>
 #include <bit>
+#include <iterator>
+#include <memory>
 
 namespace koda {
 
@@ -41,6 +46,22 @@ constexpr auto UniformEncoder<Token>::EncodeTokens(
     auto input_iter = std::ranges::begin(input);
     auto input_sent = std::ranges::end(input);
 
+    if constexpr (BitWordOutputIterator<decltype(iter)>) {
+        if constexpr (std::contiguous_iterator<decltype(input_iter)>) {
+            if !consteval {
+                iter = EncodeBlocks(input_iter, input_sent, std::move(iter),
+                                    sentinel);
+            }
+        }
+        // Whole words of tokens are written at once as long as the output
+        // surely takes them, so no token is left waiting in the emitter
+        while ((input_iter != input_sent) &&
+               details::HasRoomForBits(iter, sentinel, kEmitterBits)) {
+            PackTokens(input_iter, input_sent);
+            iter = FlushEmitter(std::move(iter), sentinel);
+        }
+    }
+
     for (; (iter != sentinel) && (input_iter != input_sent); ++input_iter) {
         SetEmitter(*input_iter);
         iter = FlushEmitter(iter, sentinel);
@@ -51,26 +72,73 @@ constexpr auto UniformEncoder<Token>::EncodeTokens(
 }
 
 template <std::integral Token>
-constexpr auto UniformEncoder<Token>::FlushEmitter(auto output_iter,
-                                                   const auto& output_sent) {
-    auto& bit_iter = emitter_.first;
-    const auto& bit_sent = emitter_.second;
+auto UniformEncoder<Token>::EncodeBlocks(auto& input_iter,
+                                         const auto& input_sent, auto iter,
+                                         const auto& sentinel) {
+    if (!token_bit_size_ || token_bit_size_ > kEmitterBits) {
+        return iter;
+    }
 
-    for (; (bit_iter != bit_sent) && (output_iter != output_sent);
-         ++output_iter, ++bit_iter) {
-        *output_iter = *bit_iter;
+    // Every block fills whole words so the bits waiting in the emitter are
+    // carried over the blocks unchanged
+    const size_t word_count =
+        details::kUniformBlockSize * token_bit_size_ / kEmitterBits;
+    const uint64_t mask = LowBitsMask<uint64_t>(token_bit_size_);
+    std::array<uint64_t, details::kUniformBlockSize> lanes;
+    std::array<uint64_t, details::kUniformBlockSize> words;
+    while ((std::ranges::distance(input_iter, input_sent) >=
+            static_cast<std::ptrdiff_t>(details::kUniformBlockSize)) &&
+           details::HasRoomForBits(
+               iter, sentinel,
+               details::kUniformBlockSize * token_bit_size_ + kEmitterBits)) {
+        const Token* tokens = std::to_address(input_iter);
+        for (size_t index = 0; index < details::kUniformBlockSize; ++index) {
+            lanes[index] =
+                static_cast<std::make_unsigned_t<Token>>(tokens[index]) & mask;
+        }
+        details::PackUniformBlock(
+            lanes.data(), static_cast<uint8_t>(token_bit_size_), words.data());
+        for (size_t index = 0; index < word_count; ++index) {
+            iter.WriteBits(emitter_ | (words[index] << emitter_size_),
+                           kEmitterBits);
+            emitter_ = emitter_size_
+                           ? words[index] >> (kEmitterBits - emitter_size_)
+                           : 0;
+        }
+        input_iter += details::kUniformBlockSize;
     }
-    return output_iter;
+    return iter;
+}
+
+template <std::integral Token>
+constexpr auto UniformEncoder<Token>::FlushEmitter(auto output_iter,
+                                                   const auto& output_sent) {
+    return WriteBits(std::move(output_iter), output_sent, emitter_,
+                     emitter_size_);
 }
 
 template <std::integral Token>
 constexpr void UniformEncoder<Token>::SetEmitter(const Token& token) {
-    token_[0] = token;
-    emitter_ =
-        std::pair{BitIter{std::ranges::begin(token_)},
-                  token_bit_size_ == (sizeof(Token) * CHAR_BIT)
-                      ? BitIter{std::ranges::end(token_)}
-                      : BitIter{std::ranges::begin(token_), token_bit_size_}};
+    // Conversion through the unsigned type prevents the sign extension, bits
+    // above the token size are cleared so the packed tokens can be appended
+    // to the emitter after it is flushed bit by bit
+    emitter_ = static_cast<std::make_unsigned_t<Token>>(token) &
+               LowBitsMask<uint64_t>(token_bit_size_);
+    emitter_size_ = token_bit_size_;
+}
+
+template <std::integral Token>
+constexpr void UniformEncoder<Token>::PackTokens(auto& input_iter,
+                                                 const auto& input_sent) {
+    const uint64_t mask = LowBitsMask<uint64_t>(token_bit_size_);
+    for (; (input_iter != input_sent) &&
+           (emitter_size_ + token_bit_size_ <= kEmitterBits);
+         ++input_iter) {
+        const uint64_t token =
+            static_cast<std::make_unsigned_t<Token>>(*input_iter);
+        emitter_ |= (token & mask) << emitter_size_;
+        emitter_size_ += token_bit_size_;
+    }
 }
 
 }  // namespace koda
@@ -126,6 +126,10 @@ class FusedDictionaryAndBuffer {
 
     [[nodiscard]] constexpr bool empty() const noexcept;
 
+    /// Number of the symbols behind the dictionary that stay intact until
+    /// the buffer overwrites them
+    [[nodiscard]] constexpr size_t retained_size() const noexcept;
+
    private:
     using Buffer = std::vector<ValueType>;
     using BufferIter = typename std::vector<ValueType>::iterator;
@@ -198,6 +198,14 @@ FusedDictionaryAndBuffer<Tp, AllocatorTp>::max_buffer_size() const noexcept {
     return buffer_size_;
 }
 
+template <typename Tp, typename AllocatorTp>
+[[nodiscard]] constexpr size_t
+FusedDictionaryAndBuffer<Tp, AllocatorTp>::retained_size() const noexcept {
+    // Telomeres duplicate buffer_size - 1 symbols, the rest of the cyclic
+    // buffer not taken by the dictionary and the buffer lags behind them
+    return cyclic_buffer_.size() - (dictionary_size_ + 2 * buffer_size_ - 1);
+}
+
 template <typename Tp, typename AllocatorTp>
 /*static*/ constexpr size_t
 FusedDictionaryAndBuffer<Tp, AllocatorTp>::CalculateCyclicBufferSize(
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <koda/collections/match_finder.hpp>
+
+#include <cinttypes>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace koda {
+
+/// Match finder that keeps a binary search tree of strings per bucket of the
+/// hash of their first four symbols. Every inserted string becomes the root
+/// of its tree (the tree is split around it on the way down), so the nodes
+/// get older with the depth and the ones that left the window are cut off
+/// by the next traversal that reaches them. Removal therefore only moves the
+/// window. Children are kept in a circular array of 32-bit positions sized
+/// to the window
+template <typename Tp, typename AllocatorTp = std::allocator<Tp>>
+class HashBinaryTree {
+   public:
+    using ValueType = Tp;
+    using StringView = std::basic_string_view<ValueType>;
+    using RepeatitionMarker = koda::RepeatitionMarker;
+
+    static constexpr size_t kDefaultMaxSearchDepth = 32;
+
+    constexpr explicit HashBinaryTree(
+        size_t string_size, const AllocatorTp& allocator = AllocatorTp{});
+
+    constexpr explicit HashBinaryTree(
+        size_t string_size, size_t max_search_depth,
+        const AllocatorTp& allocator = AllocatorTp{});
+
+    constexpr void AddString(StringView string);
+
+    constexpr bool RemoveString(StringView string);
+
+    constexpr RepeatitionMarker FindMatch(StringView buffer) const;
+
+    constexpr void set_max_search_depth(size_t max_search_depth) noexcept;
+
+    [[nodiscard]] constexpr size_t max_search_depth() const noexcept;
+
+    [[nodiscard]] constexpr size_t string_size() const noexcept;
+
+    [[nodiscard]] constexpr size_t size() const noexcept;
+
+    [[nodiscard]] constexpr AllocatorTp get_allocator() const;
+
+   private:
+    using ValueTraits = std::allocator_traits<AllocatorTp>;
+    using LinkAllocatorTp = typename ValueTraits::rebind_alloc<uint32_t>;
+    using KeyAllocatorTp = typename ValueTraits::rebind_alloc<const Tp*>;
+
+    static constexpr size_t kHashLength = 4;
+    static constexpr uint8_t kHashBits = 16;
+    static constexpr uint64_t kHashMultiplier = 0x9E37'79B9'7F4A'7C15;
+    static constexpr size_t kMinimalCapacity = 16;
+    // Links store positions increased by one so zero marks the empty subtree
+    static constexpr uint32_t kEmptyLink = 0;
+
+    std::vector<uint32_t, LinkAllocatorTp> heads_;
+    // Smaller and greater subtree of every node stored next to each other
+    std::vector<uint32_t, LinkAllocatorTp> children_;
+    std::vector<const Tp*, KeyAllocatorTp> keys_;
+    size_t dictionary_start_index_ = 0;
+    size_t buffer_start_index_ = 0;
+    size_t string_size_;
+    size_t hash_length_;
+    size_t max_search_depth_;
+    [[no_unique_address]] AllocatorTp allocator_;
+
+    constexpr void Grow();
+
+    constexpr size_t Slot(size_t position) const noexcept;
+
+    constexpr bool ResolveLink(uint32_t link, size_t& position) const noexcept;
+
+    constexpr uint32_t Hash(const ValueType* string) const noexcept;
+
+    constexpr std::pair<size_t, size_t> FindInTree(const ValueType* buffer,
+                                                   size_t length) const;
+
+    constexpr std::pair<size_t, size_t> FindInWindow(const ValueType* buffer,
+                                                     size_t length) const;
+
+    constexpr static size_t FindCommonPrefixSize(const ValueType* buffer,
+                                                 const ValueType* key,
+                                                 size_t start,
+                                                 size_t length) noexcept;
+};
+
+}  // namespace koda
+
+#include <koda/collections/hash_binary_tree.tpp>
@@ -0,0 +1,264 @@
+#pragma once
+
+#include <koda/utils/utils.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace koda {
+
+template <typename Tp, typename AllocatorTp>
+constexpr HashBinaryTree<Tp, AllocatorTp>::HashBinaryTree(
+    size_t string_size, const AllocatorTp& allocator)
+    : HashBinaryTree{string_size, kDefaultMaxSearchDepth, allocator} {}
+
+template <typename Tp, typename AllocatorTp>
+constexpr HashBinaryTree<Tp, AllocatorTp>::HashBinaryTree(
+    size_t string_size, size_t max_search_depth, const AllocatorTp& allocator)
+    : heads_(size_t{1} << kHashBits, kEmptyLink, LinkAllocatorTp{allocator}),
+      children_{LinkAllocatorTp{allocator}},
+      keys_{KeyAllocatorTp{allocator}},
+      string_size_{string_size},
+      hash_length_{std::min(string_size, kHashLength)},
+      max_search_depth_{max_search_depth},
+      allocator_{allocator} {}
+
+template <typename Tp, typename AllocatorTp>
+constexpr void HashBinaryTree<Tp, AllocatorTp>::AddString(StringView string) {
+    assert(string.size() == string_size_ &&
+           "Inserted string have to have fixed size equal to string_size_");
+
+    if (2 * size() == children_.size()) {
+        Grow();
+    }
+
+    const ValueType* key = string.data();
+    const size_t slot = Slot(buffer_start_index_);
+    const uint32_t hash = Hash(key);
+    keys_[slot] = key;
+    uint32_t link = heads_[hash];
+    heads_[hash] = static_cast<uint32_t>(buffer_start_index_ + 1);
+
+    // Old tree is split into the strings smaller and greater than the new
+    // root, the common prefix with both sides never shrinks on the way down
+    uint32_t* smaller = &children_[2 * slot];
+    uint32_t* greater = &children_[2 * slot + 1];
+    size_t smaller_length = 0;
+    size_t greater_length = 0;
+    size_t position = 0;
+
+    for (size_t depth = 0;; ++depth) {
+        if (depth == max_search_depth_ || !ResolveLink(link, position)) {
+            *smaller = *greater = kEmptyLink;
+            break;
+        }
+
+        const ValueType* node_key = keys_[Slot(position)];
+        uint32_t* node_children = &children_[2 * Slot(position)];
+        const size_t length = FindCommonPrefixSize(
+            key, node_key, std::min(smaller_length, greater_length),
+            string_size_);
+
+        if (length == string_size_) {
+            // Older copy of the same string is replaced by the new root
+            *smaller = node_children[0];
+            *greater = node_children[1];
+            break;
+        }
+
+        if (node_key[length] < key[length]) {
+            *smaller = link;
+            smaller = &node_children[1];
+            link = *smaller;
+            smaller_length = length;
+        } else {
+            *greater = link;
+            greater = &node_children[0];
+            link = *greater;
+            greater_length = length;
+        }
+    }
+
+    ++buffer_start_index_;
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr bool HashBinaryTree<Tp, AllocatorTp>::RemoveString(
+    StringView string) {
+    if (!size() || string.size() != string_size_) [[unlikely]] {
+        return false;
+    }
+
+    // Nodes that left the window are cut off when they are reached
+    ++dictionary_start_index_;
+    return true;
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr HashBinaryTree<Tp, AllocatorTp>::RepeatitionMarker
+HashBinaryTree<Tp, AllocatorTp>::FindMatch(StringView buffer) const {
+    assert(
+        buffer.size() <= string_size_ &&
+        "Inserted string have to have fixed size not bigger than string_size_");
+
+    auto [position, length] =
+        buffer.size() < hash_length_
+            ? FindInWindow(buffer.data(), buffer.size())
+            : FindInTree(buffer.data(), buffer.size());
+
+    if (!length) {
+        return {0, 0};
+    }
+
+    return {// Calculate relative offset from the start of the dictionary
+            position - dictionary_start_index_, length};
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr void HashBinaryTree<Tp, AllocatorTp>::set_max_search_depth(
+    size_t max_search_depth) noexcept {
+    max_search_depth_ = max_search_depth;
+}
+
+template <typename Tp, typename AllocatorTp>
+[[nodiscard]] constexpr size_t
+HashBinaryTree<Tp, AllocatorTp>::max_search_depth() const noexcept {
+    return max_search_depth_;
+}
+
+template <typename Tp, typename AllocatorTp>
+[[nodiscard]] constexpr size_t HashBinaryTree<Tp, AllocatorTp>::string_size()
+    const noexcept {
+    return string_size_;
+}
+
+template <typename Tp, typename AllocatorTp>
+[[nodiscard]] constexpr size_t HashBinaryTree<Tp, AllocatorTp>::size()
+    const noexcept {
+    return buffer_start_index_ - dictionary_start_index_;
+}
+
+template <typename Tp, typename AllocatorTp>
+[[nodiscard]] constexpr AllocatorTp
+HashBinaryTree<Tp, AllocatorTp>::get_allocator() const {
+    return allocator_;
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr void HashBinaryTree<Tp, AllocatorTp>::Grow() {
+    const size_t capacity = std::max(kMinimalCapacity, children_.size());
+    decltype(children_) children(2 * capacity, kEmptyLink,
+                                 children_.get_allocator());
+    decltype(keys_) keys(capacity, nullptr, keys_.get_allocator());
+
+    for (size_t position = dictionary_start_index_;
+         position != buffer_start_index_; ++position) {
+        const size_t slot = position & (capacity - 1);
+        children[2 * slot] = children_[2 * Slot(position)];
+        children[2 * slot + 1] = children_[2 * Slot(position) + 1];
+        keys[slot] = keys_[Slot(position)];
+    }
+
+    children_ = std::move(children);
+    keys_ = std::move(keys);
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr size_t HashBinaryTree<Tp, AllocatorTp>::Slot(
+    size_t position) const noexcept {
+    return position & (keys_.size() - 1);
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr bool HashBinaryTree<Tp, AllocatorTp>::ResolveLink(
+    uint32_t link, size_t& position) const noexcept {
+    // Links are truncated to 32 bits, so the position is restored from its
+    // distance to the newest string
+    const size_t distance = static_cast<uint32_t>(buffer_start_index_ - link);
+    if ((link == kEmptyLink) || (distance >= size())) {
+        return false;
+    }
+    position = buffer_start_index_ - 1 - distance;
+    return true;
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr uint32_t HashBinaryTree<Tp, AllocatorTp>::Hash(
+    const ValueType* string) const noexcept {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < hash_length_; ++i) {
+        hash = (hash ^ static_cast<uint64_t>(string[i])) * kHashMultiplier;
+    }
+    return static_cast<uint32_t>(hash >> (64 - kHashBits));
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr std::pair<size_t, size_t>
+HashBinaryTree<Tp, AllocatorTp>::FindInTree(const ValueType* buffer,
+                                            size_t length) const {
+    std::pair<size_t, size_t> match{};
+    size_t smaller_length = 0;
+    size_t greater_length = 0;
+    size_t position = 0;
+    uint32_t link = heads_[Hash(buffer)];
+
+    // Nodes get older with the depth, so only the longer matches replace the
+    // found one
+    for (size_t depth = 0;
+         (depth != max_search_depth_) && ResolveLink(link, position);
+         ++depth) {
+        const ValueType* node_key = keys_[Slot(position)];
+        const uint32_t* node_children = &children_[2 * Slot(position)];
+        const size_t prefix_length = FindCommonPrefixSize(
+            buffer, node_key, std::min(smaller_length, greater_length),
+            length);
+
+        if (match.second < prefix_length) {
+            match = {position, prefix_length};
+        }
+        if (prefix_length == length) {
+            break;
+        }
+
+        if (node_key[prefix_length] < buffer[prefix_length]) {
+            link = node_children[1];
+            smaller_length = prefix_length;
+        } else {
+            link = node_children[0];
+            greater_length = prefix_length;
+        }
+    }
+    return match;
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr std::pair<size_t, size_t>
+HashBinaryTree<Tp, AllocatorTp>::FindInWindow(const ValueType* buffer,
+                                              size_t length) const {
+    std::pair<size_t, size_t> match{};
+    const size_t depth = std::min(size(), max_search_depth_);
+    for (size_t distance = 0; distance < depth; ++distance) {
+        const size_t position = buffer_start_index_ - 1 - distance;
+        const size_t prefix_length =
+            FindCommonPrefixSize(buffer, keys_[Slot(position)], 0, length);
+        if (match.second < prefix_length) {
+            match = {position, prefix_length};
+        }
+        if (prefix_length == length) {
+            break;
+        }
+    }
+    return match;
+}
+
+template <typename Tp, typename AllocatorTp>
+/*static*/ constexpr size_t
+HashBinaryTree<Tp, AllocatorTp>::FindCommonPrefixSize(const ValueType* buffer,
+                                                      const ValueType* key,
+                                                      size_t start,
+                                                      size_t length) noexcept {
+    return start + CommonPrefixLength(buffer + start, key + start,
+                                      length - start);
+}
+
+}  // namespace koda
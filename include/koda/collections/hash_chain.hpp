@@ -0,0 +1,95 @@
+#pragma once
+
+#include <koda/collections/match_finder.hpp>
+
+#include <cinttypes>
+#include <cstdlib>
+#include <memory>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace koda {
+
+/// Match finder that links the strings sharing the hash of their first
+/// symbols into chains ordered from the newest one. Chain links are kept in
+/// a circular array of 32-bit positions sized to the window, which grows
+/// whenever the window does. Matches shorter than the hashed prefix are
+/// found only for the look-ahead buffers that are shorter than it
+template <typename Tp, typename AllocatorTp = std::allocator<Tp>>
+class HashChain {
+   public:
+    using ValueType = Tp;
+    using StringView = std::basic_string_view<ValueType>;
+    using RepeatitionMarker = koda::RepeatitionMarker;
+
+    static constexpr size_t kDefaultMaxChainDepth = 64;
+
+    constexpr explicit HashChain(size_t string_size,
+                                 const AllocatorTp& allocator = AllocatorTp{});
+
+    constexpr explicit HashChain(size_t string_size, size_t max_chain_depth,
+                                 const AllocatorTp& allocator = AllocatorTp{});
+
+    constexpr void AddString(StringView string);
+
+    constexpr bool RemoveString(StringView string);
+
+    constexpr RepeatitionMarker FindMatch(StringView buffer) const;
+
+    constexpr void set_max_chain_depth(size_t max_chain_depth) noexcept;
+
+    [[nodiscard]] constexpr size_t max_chain_depth() const noexcept;
+
+    [[nodiscard]] constexpr size_t string_size() const noexcept;
+
+    [[nodiscard]] constexpr size_t size() const noexcept;
+
+    [[nodiscard]] constexpr AllocatorTp get_allocator() const;
+
+   private:
+    using ValueTraits = std::allocator_traits<AllocatorTp>;
+    using LinkAllocatorTp = typename ValueTraits::rebind_alloc<uint32_t>;
+    using KeyAllocatorTp = typename ValueTraits::rebind_alloc<const Tp*>;
+
+    static constexpr size_t kHashLength = 3;
+    static constexpr uint8_t kHashBits = 15;
+    static constexpr uint64_t kHashMultiplier = 0x9E37'79B9'7F4A'7C15;
+    static constexpr size_t kMinimalCapacity = 16;
+    // Links store positions increased by one so zero marks the chain end
+    static constexpr uint32_t kChainEnd = 0;
+
+    std::vector<uint32_t, LinkAllocatorTp> heads_;
+    std::vector<uint32_t, LinkAllocatorTp> links_;
+    std::vector<const Tp*, KeyAllocatorTp> keys_;
+    size_t dictionary_start_index_ = 0;
+    size_t buffer_start_index_ = 0;
+    size_t string_size_;
+    size_t hash_length_;
+    size_t max_chain_depth_;
+    [[no_unique_address]] AllocatorTp allocator_;
+
+    constexpr void Grow();
+
+    constexpr size_t Slot(size_t position) const noexcept;
+
+    constexpr uint32_t Hash(const ValueType* string) const noexcept;
+
+    constexpr std::pair<size_t, size_t> FindInChain(const ValueType* buffer,
+                                                    size_t length) const;
+
+    constexpr std::pair<size_t, size_t> FindInWindow(const ValueType* buffer,
+                                                     size_t length) const;
+
+    constexpr static void UpdateMatchInfo(std::pair<size_t, size_t>& match_info,
+                                          size_t prefix_length,
+                                          size_t position) noexcept;
+
+    constexpr static size_t FindCommonPrefixSize(const ValueType* buffer,
+                                                 const ValueType* key,
+                                                 size_t length) noexcept;
+};
+
+}  // namespace koda
+
+#include <koda/collections/hash_chain.tpp>
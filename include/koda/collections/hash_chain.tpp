@@ -0,0 +1,204 @@
+#pragma once
+
+#include <koda/utils/utils.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace koda {
+
+template <typename Tp, typename AllocatorTp>
+constexpr HashChain<Tp, AllocatorTp>::HashChain(size_t string_size,
+                                                const AllocatorTp& allocator)
+    : HashChain{string_size, kDefaultMaxChainDepth, allocator} {}
+
+template <typename Tp, typename AllocatorTp>
+constexpr HashChain<Tp, AllocatorTp>::HashChain(size_t string_size,
+                                                size_t max_chain_depth,
+                                                const AllocatorTp& allocator)
+    : heads_(size_t{1} << kHashBits, kChainEnd, LinkAllocatorTp{allocator}),
+      links_{LinkAllocatorTp{allocator}},
+      keys_{KeyAllocatorTp{allocator}},
+      string_size_{string_size},
+      hash_length_{std::min(string_size, kHashLength)},
+      max_chain_depth_{max_chain_depth},
+      allocator_{allocator} {}
+
+template <typename Tp, typename AllocatorTp>
+constexpr void HashChain<Tp, AllocatorTp>::AddString(StringView string) {
+    assert(string.size() == string_size_ &&
+           "Inserted string have to have fixed size equal to string_size_");
+
+    if (size() == links_.size()) {
+        Grow();
+    }
+
+    const size_t slot = Slot(buffer_start_index_);
+    const uint32_t hash = Hash(string.data());
+    keys_[slot] = string.data();
+    links_[slot] = heads_[hash];
+    heads_[hash] = static_cast<uint32_t>(buffer_start_index_ + 1);
+    ++buffer_start_index_;
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr bool HashChain<Tp, AllocatorTp>::RemoveString(StringView string) {
+    if (!size() || string.size() != string_size_) [[unlikely]] {
+        return false;
+    }
+
+    // Strings leave the window in the insertion order, so the removed one is
+    // always the oldest. Its chain is cut only when it is the last one left
+    // in it, otherwise the chain ends on the distance check
+    const uint32_t hash = Hash(keys_[Slot(dictionary_start_index_)]);
+    if (heads_[hash] == static_cast<uint32_t>(dictionary_start_index_ + 1)) {
+        heads_[hash] = kChainEnd;
+    }
+
+    ++dictionary_start_index_;
+    return true;
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr HashChain<Tp, AllocatorTp>::RepeatitionMarker
+HashChain<Tp, AllocatorTp>::FindMatch(StringView buffer) const {
+    assert(
+        buffer.size() <= string_size_ &&
+        "Inserted string have to have fixed size not bigger than string_size_");
+
+    auto [position, length] =
+        buffer.size() < hash_length_
+            ? FindInWindow(buffer.data(), buffer.size())
+            : FindInChain(buffer.data(), buffer.size());
+
+    if (!length) {
+        return {0, 0};
+    }
+
+    return {// Calculate relative offset from the start of the dictionary
+            position - dictionary_start_index_, length};
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr void HashChain<Tp, AllocatorTp>::set_max_chain_depth(
+    size_t max_chain_depth) noexcept {
+    max_chain_depth_ = max_chain_depth;
+}
+
+template <typename Tp, typename AllocatorTp>
+[[nodiscard]] constexpr size_t HashChain<Tp, AllocatorTp>::max_chain_depth()
+    const noexcept {
+    return max_chain_depth_;
+}
+
+template <typename Tp, typename AllocatorTp>
+[[nodiscard]] constexpr size_t HashChain<Tp, AllocatorTp>::string_size()
+    const noexcept {
+    return string_size_;
+}
+
+template <typename Tp, typename AllocatorTp>
+[[nodiscard]] constexpr size_t HashChain<Tp, AllocatorTp>::size()
+    const noexcept {
+    return buffer_start_index_ - dictionary_start_index_;
+}
+
+template <typename Tp, typename AllocatorTp>
+[[nodiscard]] constexpr AllocatorTp HashChain<Tp, AllocatorTp>::get_allocator()
+    const {
+    return allocator_;
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr void HashChain<Tp, AllocatorTp>::Grow() {
+    const size_t capacity = std::max(kMinimalCapacity, 2 * links_.size());
+    decltype(links_) links(capacity, kChainEnd, links_.get_allocator());
+    decltype(keys_) keys(capacity, nullptr, keys_.get_allocator());
+
+    for (size_t position = dictionary_start_index_;
+         position != buffer_start_index_; ++position) {
+        links[position & (capacity - 1)] = links_[Slot(position)];
+        keys[position & (capacity - 1)] = keys_[Slot(position)];
+    }
+
+    links_ = std::move(links);
+    keys_ = std::move(keys);
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr size_t HashChain<Tp, AllocatorTp>::Slot(
+    size_t position) const noexcept {
+    return position & (links_.size() - 1);
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr uint32_t HashChain<Tp, AllocatorTp>::Hash(
+    const ValueType* string) const noexcept {
+    uint64_t hash = 0;
+    for (size_t i = 0; i < hash_length_; ++i) {
+        hash = (hash ^ static_cast<uint64_t>(string[i])) * kHashMultiplier;
+    }
+    return static_cast<uint32_t>(hash >> (64 - kHashBits));
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr std::pair<size_t, size_t> HashChain<Tp, AllocatorTp>::FindInChain(
+    const ValueType* buffer, size_t length) const {
+    std::pair<size_t, size_t> match{};
+    uint32_t link = heads_[Hash(buffer)];
+    for (size_t depth = 0; (link != kChainEnd) && (depth < max_chain_depth_);
+         ++depth) {
+        // Links are truncated to 32 bits, so the position is restored from
+        // its distance to the newest string. Links that left the window end
+        // the chain
+        const size_t distance =
+            static_cast<uint32_t>(buffer_start_index_ - link);
+        if (distance >= size()) {
+            break;
+        }
+        const size_t position = buffer_start_index_ - 1 - distance;
+        const size_t prefix_length =
+            FindCommonPrefixSize(buffer, keys_[Slot(position)], length);
+        UpdateMatchInfo(match, prefix_length, position);
+        if (prefix_length == length) {
+            break;
+        }
+        link = links_[Slot(position)];
+    }
+    return match;
+}
+
+template <typename Tp, typename AllocatorTp>
+constexpr std::pair<size_t, size_t> HashChain<Tp, AllocatorTp>::FindInWindow(
+    const ValueType* buffer, size_t length) const {
+    std::pair<size_t, size_t> match{};
+    const size_t depth = std::min(size(), max_chain_depth_);
+    for (size_t distance = 0; distance < depth; ++distance) {
+        const size_t position = buffer_start_index_ - 1 - distance;
+        const size_t prefix_length =
+            FindCommonPrefixSize(buffer, keys_[Slot(position)], length);
+        UpdateMatchInfo(match, prefix_length, position);
+        if (prefix_length == length) {
+            break;
+        }
+    }
+    return match;
+}
+
+template <typename Tp, typename AllocatorTp>
+/*static*/ constexpr void HashChain<Tp, AllocatorTp>::UpdateMatchInfo(
+    std::pair<size_t, size_t>& match_info, size_t prefix_length,
+    size_t position) noexcept {
+    if (match_info.second < prefix_length) {
+        match_info.first = position;
+        match_info.second = prefix_length;
+    }
+}
+
+template <typename Tp, typename AllocatorTp>
+/*static*/ constexpr size_t HashChain<Tp, AllocatorTp>::FindCommonPrefixSize(
+    const ValueType* buffer, const ValueType* key, size_t length) noexcept {
+    return CommonPrefixLength(buffer, key, length);
+}
+
+}  // namespace koda
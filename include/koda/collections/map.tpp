@@ -369,25 +369,24 @@ template <typename KeyTp, typename ValueTp,
 constexpr Map<KeyTp, ValueTp, ComparatorTp, AllocatorTp>::NodeInsertionLocation
 Map<KeyTp, ValueTp, ComparatorTp, AllocatorTp>::FindInsertionLocation(
     const entry_type& entry) {
-    Node** node = &this->root();
     Node* parent = nullptr;
-    while (*node) {
-        switch (OrderCast(comparator_(entry.first, (*node)->value.first))) {
+    bool is_right_child = false;
+    for (Node* node = this->root(); node;) {
+        switch (OrderCast(comparator_(entry.first, node->value.first))) {
             case WeakOrdering::kEquivalent:
                 return std::nullopt;
             case WeakOrdering::kLess:
-                parent = *node;
-                node = &(*node)->left;
+                is_right_child = false;
                 break;
             case WeakOrdering::kGreater:
-                parent = *node;
-                node = &(*node)->right;
+                is_right_child = true;
                 break;
             default:
                 std::unreachable();
         };
+        parent = std::exchange(node, is_right_child ? node->right : node->left);
     }
-    return NodeInsertionLocation{std::in_place, *node, parent};
+    return NodeInsertionLocation{std::in_place, parent, is_right_child};
 }
 
 template <typename KeyTp, typename ValueTp,
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cinttypes>
+#include <concepts>
+#include <cstdlib>
+#include <string_view>
+
+namespace koda {
+
+struct [[nodiscard]] RepeatitionMarker {
+    size_t match_position;
+    size_t match_length;
+
+    [[nodiscard]] inline constexpr operator bool() const noexcept {
+        return match_length != 0;
+    }
+
+    [[nodiscard]] constexpr auto operator<=>(
+        const RepeatitionMarker&) const noexcept = default;
+};
+
+/// Dictionary of the fixed size strings used by the LZ encoders to find the
+/// repeatitions. Strings are added as the window slides and removed starting
+/// from the oldest one, positions of the found matches are relative to the
+/// oldest string still held by the finder
+template <typename Finder, typename Tp>
+concept MatchFinder =
+    requires(Finder finder, const Finder cfinder,
+             std::basic_string_view<Tp> string) {
+        finder.AddString(string);
+        { finder.RemoveString(string) } -> std::same_as<bool>;
+        { cfinder.FindMatch(string) } -> std::same_as<RepeatitionMarker>;
+        { cfinder.string_size() } -> std::same_as<size_t>;
+        { cfinder.size() } -> std::same_as<size_t>;
+        cfinder.get_allocator();
+    };
+
+}  // namespace koda
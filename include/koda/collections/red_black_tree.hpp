@@ -1,5 +1,7 @@
 #pragma once
 
+#include <koda/utils/concepts.hpp>
+
 #include <cinttypes>
 #include <concepts>
 #include <cstdlib>
@@ -8,10 +10,51 @@
 #include <string>
 #include <string_view>
 #include <utility>
+#include <vector>
 
 namespace koda {
 
-template <typename ValueTp, typename AllocatorTp = std::allocator<ValueTp>>
+/// Pointer layout allocates the nodes one by one and links them with the
+/// pointers. Indexed layout carves the nodes out of the contiguous slabs and
+/// links them with 32-bit indices, what shrinks every node and keeps the
+/// whole tree in a few large allocations
+enum class RedBlackTreeLayout : uint8_t { kPointer = 0, kIndexed = 1 };
+
+namespace details {
+
+enum class RedBlackTreeColor : bool { kBlack = 0, kRed = 1 };
+
+template <typename NodeTp, RedBlackTreeLayout Layout>
+struct RedBlackTreeLinks {
+    using Link = NodeTp*;
+
+    constexpr RedBlackTreeLinks(Link parent, RedBlackTreeColor color) noexcept;
+
+    Link parent;
+    Link left = nullptr;
+    Link right = nullptr;
+    RedBlackTreeColor color;
+};
+
+template <typename NodeTp>
+struct RedBlackTreeLinks<NodeTp, RedBlackTreeLayout::kIndexed> {
+    // Zero is the null link so the first slot of the first slab stays unused
+    using Link = uint32_t;
+
+    constexpr RedBlackTreeLinks(Link parent, RedBlackTreeColor color) noexcept;
+
+    Link parent;
+    Link left = 0;
+    Link right = 0;
+    // Link to the node itself shares the word with the color
+    Link self : 31 = 0;
+    RedBlackTreeColor color : 1;
+};
+
+}  // namespace details
+
+template <typename ValueTp, typename AllocatorTp = std::allocator<ValueTp>,
+          RedBlackTreeLayout Layout = RedBlackTreeLayout::kPointer>
 class RedBlackTree {
    public:
     constexpr RedBlackTree(
@@ -22,10 +65,15 @@ class RedBlackTree {
     constexpr virtual ~RedBlackTree();
 
    protected:
-    struct Node {
-        enum class Color : bool { kBlack = 0, kRed = 1 };
+    static constexpr bool kIndexed = Layout == RedBlackTreeLayout::kIndexed;
 
-        constexpr explicit Node(ValueTp value, Node* parent = nullptr,
+    // Links are placed before the value so the indexed node packs them with
+    // the color into a 16-byte header
+    struct Node : details::RedBlackTreeLinks<Node, Layout> {
+        using Color = details::RedBlackTreeColor;
+        using Link = details::RedBlackTreeLinks<Node, Layout>::Link;
+
+        constexpr explicit Node(ValueTp value, Link parent = Link{},
                                 Color color = Color::kBlack);
 
         constexpr Node(Node&&) noexcept = default;
@@ -35,12 +83,9 @@ class RedBlackTree {
         constexpr Node& operator=(const Node&) = delete;
 
         ValueTp value;
-        Node* parent;
-        Node* left = nullptr;
-        Node* right = nullptr;
-        Color color;
     };
 
+    using Link = Node::Link;
     using ValueTraits = std::allocator_traits<AllocatorTp>;
     using NodeTraits = typename ValueTraits::rebind_traits<Node>;
     using NodeAllocatorTp = typename ValueTraits::rebind_alloc<Node>;
@@ -69,6 +114,18 @@ class RedBlackTree {
         constexpr Node* GetNode(ValueTp value, Node* parent = nullptr,
                                 Node::Color color = Node::Color::kBlack);
 
+        // Destroys the node when the tree is torn down, slab nodes are kept
+        // for the reuse
+        constexpr void ReleaseNode(Node* node);
+
+        // Allocates the slabs for the given number of nodes up front, no-op
+        // in the pointer layout
+        constexpr void Reserve(size_t count);
+
+        [[nodiscard]] constexpr Node* Resolve(Link link) const noexcept;
+
+        [[nodiscard]] constexpr Link MakeLink(const Node* node) const noexcept;
+
         constexpr AllocatorTp get_allocator() const;
 
         constexpr NodeAllocatorTp& get_node_allocator() noexcept;
@@ -76,8 +133,22 @@ class RedBlackTree {
         constexpr ~NodePool();
 
        private:
+        static constexpr size_t kSlabBits = 10;
+        static constexpr size_t kSlabSize = size_t{1} << kSlabBits;
+        static constexpr size_t kMaxSlots = size_t{1} << 31;
+
+        using SlabAllocatorTp = typename ValueTraits::rebind_alloc<Node*>;
+
         [[no_unique_address]] NodeAllocatorTp allocator_;
         Node* handle_ = nullptr;
+        // Slabs are never moved so the nodes keep their addresses, only used
+        // by the indexed layout
+        std::vector<Node*, SlabAllocatorTp> slabs_;
+        size_t used_slots_ = 1;
+
+        constexpr Node* GetFreshNode();
+
+        constexpr void AllocateSlab();
 
         constexpr void Destroy();
     };
@@ -90,6 +161,8 @@ class RedBlackTree {
     static constexpr IteratorFromSentinelT kIteratorFromSentinel{};
     static constexpr IteratorFromNodeT kIteratorFromNode{};
 
+    // Iterators follow the raw links so they are available only in the
+    // pointer layout
     template <bool IsConst>
     class NodeIteratorBase {
        public:
@@ -139,7 +212,13 @@ class RedBlackTree {
     using NodeConstIterator = NodeIteratorBase<true>;
 
     using NodePtr = Node*;
-    using NodeInsertionLocation = std::optional<std::pair<Node*&, Node*>>;
+
+    struct InsertionPoint {
+        Node* parent;
+        bool is_right_child;
+    };
+
+    using NodeInsertionLocation = std::optional<InsertionPoint>;
 
     constexpr explicit RedBlackTree(RedBlackTree&& other) noexcept;
     constexpr explicit RedBlackTree(const RedBlackTree& other) = delete;
@@ -154,17 +233,33 @@ class RedBlackTree {
 
     constexpr const NodePtr& root() const noexcept;
 
+    [[nodiscard]] constexpr Node* Parent(const Node* node) const noexcept;
+
+    [[nodiscard]] constexpr Node* Left(const Node* node) const noexcept;
+
+    [[nodiscard]] constexpr Node* Right(const Node* node) const noexcept;
+
     constexpr NodePtr InsertNode(ValueTp value);
 
     constexpr void RemoveNode(NodePtr node);
 
-    constexpr NodeIterator node_begin() noexcept;
+    // Drops the values rejected by the predicate and links the remaining
+    // nodes into a perfectly balanced tree without comparing any value
+    constexpr void Rebuild(Invocable<bool, const ValueTp&> auto&& retain);
+
+    constexpr void ReserveNodes(size_t count);
+
+    constexpr NodeIterator node_begin() noexcept
+        requires(!kIndexed);
 
-    constexpr NodeConstIterator node_begin() const noexcept;
+    constexpr NodeConstIterator node_begin() const noexcept
+        requires(!kIndexed);
 
-    constexpr NodeIterator node_end() noexcept;
+    constexpr NodeIterator node_end() noexcept
+        requires(!kIndexed);
 
-    constexpr NodeConstIterator node_end() const noexcept;
+    constexpr NodeConstIterator node_end() const noexcept
+        requires(!kIndexed);
 
     constexpr void CloneFrom(const RedBlackTree& source)
         requires std::is_copy_constructible_v<ValueTp>;
@@ -175,13 +270,19 @@ class RedBlackTree {
     NodePool pool_;
     Node* root_ = nullptr;
 
+    constexpr void SetParent(Node* node, const Node* parent) noexcept;
+
+    constexpr void SetLeft(Node* node, const Node* left) noexcept;
+
+    constexpr void SetRight(Node* node, const Node* right) noexcept;
+
     constexpr void RotateLeft(Node* node);
 
     constexpr void RotateRight(Node* node);
 
     constexpr void RotateHelper(Node* node, Node* child, Node* root);
 
-    constexpr Node* BuildNode(ValueTp&& value, Node*& node, Node* parent);
+    constexpr Node* BuildNode(ValueTp&& value, const InsertionPoint& location);
 
     constexpr void FixInsertionImbalance(Node* node);
 
@@ -198,6 +299,11 @@ class RedBlackTree {
 
     constexpr Node* FindSuccessor(Node* node);
 
+    constexpr Node* FindNextInOrder(Node* node);
+
+    constexpr Node* LinkBalanced(Node*& nodes, size_t count, size_t depth,
+                                 size_t red_depth);
+
     constexpr void RemoveNodeRotateSiblingRightPath(Node* parent, Node* sibling,
                                                     Node* nephew);
 
@@ -234,22 +340,21 @@ class RedBlackTree {
 
     constexpr void RemoveBlackChildlessNode(Node* node);
 
-    constexpr void CloneNodeChildren(const Node* node, Node* clone)
+    constexpr void CloneNodeChildren(const RedBlackTree& source,
+                                     const Node* node, Node* clone)
         requires std::is_copy_constructible_v<ValueTp>;
 
-    constexpr void PopulateClonedRoot(const Node* root)
+    constexpr void PopulateClonedRoot(const RedBlackTree& source)
         requires std::is_copy_constructible_v<ValueTp>;
 
     // Only runs when checked build is explicitly requested
     constexpr void CheckInvariants() const;
 
 #ifdef KODA_CHECKED_BUILD
-    static constexpr std::ranges::subrange<NodeConstIterator, NodeConstIterator>
-    nodes(const Node* root) noexcept;
-
-    constexpr void ValidateRedNodeConstraint() const;
+    constexpr void ValidateRedNodeConstraint(const Node* node) const;
 
-    constexpr void ValidateBlackNodeConstraint() const;
+    // Returns the black height of the subtree
+    constexpr size_t ValidateBlackNodeConstraint(const Node* node) const;
 
 #endif  // KODA_CHECKED_BUILD
 };
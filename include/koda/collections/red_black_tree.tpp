@@ -1,180 +1,293 @@
 #pragma once
 
+#include <koda/utils/formatted_exception.hpp>
+
 #include <algorithm>
+#include <bit>
 #include <cassert>
 #include <ranges>
 
 namespace koda {
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::RedBlackTree(
+namespace details {
+
+template <typename NodeTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTreeLinks<NodeTp, Layout>::RedBlackTreeLinks(
+    Link parent, RedBlackTreeColor color) noexcept
+    : parent{parent}, color{color} {}
+
+template <typename NodeTp>
+constexpr RedBlackTreeLinks<NodeTp, RedBlackTreeLayout::kIndexed>::
+    RedBlackTreeLinks(Link parent, RedBlackTreeColor color) noexcept
+    : parent{parent}, color{color} {}
+
+}  // namespace details
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::RedBlackTree(
     const AllocatorTp& allocator) noexcept
     : pool_{allocator} {}
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::RedBlackTree(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::RedBlackTree(
     RedBlackTree&& other) noexcept
     : root_{std::exchange(other.root_, nullptr)},
       pool_{std::move(other.pool_)} {}
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>&
-RedBlackTree<ValueTp, AllocatorTp>::operator=(RedBlackTree&& other) noexcept {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>&
+RedBlackTree<ValueTp, AllocatorTp, Layout>::operator=(
+    RedBlackTree&& other) noexcept {
     Destroy();
     root_ = std::exchange(other.root_, nullptr);
     pool_ = std::move(other.pool_);
     return *this;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::~RedBlackTree() {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::~RedBlackTree() {
     Destroy();
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 [[nodiscard]] constexpr AllocatorTp
-RedBlackTree<ValueTp, AllocatorTp>::get_allocator() const {
+RedBlackTree<ValueTp, AllocatorTp, Layout>::get_allocator() const {
     return pool_.get_allocator();
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::Node::Node(ValueTp value,
-                                                         Node* parent,
-                                                         Color color)
-    : value{std::move(value)}, parent{parent}, color{color} {}
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node::Node(
+    ValueTp value, Link parent, Color color)
+    : details::RedBlackTreeLinks<Node, Layout>{parent, color},
+      value{std::move(value)} {}
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp,
-                       AllocatorTp>::NodePool::Scheduler::~Scheduler() {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp,
+                       Layout>::NodePool::Scheduler::~Scheduler() {
     pool.ReturnNode(node);
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodePool::NodePool(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::NodePool(
     const AllocatorTp& allocator) noexcept
-    : allocator_{allocator} {}
+    : allocator_{allocator}, slabs_{SlabAllocatorTp{allocator}} {}
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodePool::NodePool(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::NodePool(
     NodePool&& other) noexcept
     : allocator_{std::move(other.allocator_)},
-      handle_{std::exchange(other.handle_, nullptr)} {}
+      handle_{std::exchange(other.handle_, nullptr)},
+      slabs_{std::move(other.slabs_)},
+      used_slots_{std::exchange(other.used_slots_, 1)} {
+    other.slabs_.clear();
+}
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodePool&
-RedBlackTree<ValueTp, AllocatorTp>::NodePool::operator=(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool&
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::operator=(
     NodePool&& other) noexcept {
     Destroy();
     allocator_ = std::move(other.allocator_);
     handle_ = std::exchange(other.handle_, nullptr);
+    slabs_ = std::move(other.slabs_);
+    other.slabs_.clear();
+    used_slots_ = std::exchange(other.used_slots_, 1);
     return *this;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::NodePool::ReturnNode(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::ReturnNode(
     Node* handle) {
-    handle->left = handle_;
+    handle->left = MakeLink(handle_);
     handle_ = handle;
     auto value_alloc = get_allocator();
     ValueTraits::destroy(value_alloc, std::addressof(handle_->value));
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodePool::Scheduler
-RedBlackTree<ValueTp, AllocatorTp>::NodePool::ScheduleForReturn(Node* node) {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::Scheduler
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::ScheduleForReturn(
+    Node* node) {
     return Scheduler{*this, node};
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::Node*
-RedBlackTree<ValueTp, AllocatorTp>::NodePool::GetNode(ValueTp value,
-                                                      Node* parent,
-                                                      Node::Color color) {
-    if (!handle_) {
-        Node* node = NodeTraits::allocate(allocator_, 1);
-        NodeTraits::construct(allocator_, node, std::move(value), parent,
-                              color);
-        return node;
-    }
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::GetNode(
+    ValueTp value, Node* parent, Node::Color color) {
     Node* node = handle_;
-    handle_ = node->left;
+    // Construction clears the link to the node itself so it is saved first
+    Link self{};
+    if (node) {
+        handle_ = Resolve(node->left);
+        self = MakeLink(node);
+    } else {
+        node = GetFreshNode();
+    }
 
-    NodeTraits::construct(allocator_, node, std::move(value), parent, color);
+    NodeTraits::construct(allocator_, node, std::move(value), MakeLink(parent),
+                          color);
+    if constexpr (kIndexed) {
+        // Fresh slot is the last one handed out by the slabs
+        node->self = self ? self : static_cast<Link>(used_slots_ - 1);
+    }
     return node;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::ReleaseNode(Node* node) {
+    if constexpr (kIndexed) {
+        ReturnNode(node);
+    } else {
+        NodeTraits::destroy(allocator_, node);
+        NodeTraits::deallocate(allocator_, node, 1);
+    }
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::Reserve(
+    size_t count) {
+    if constexpr (kIndexed) {
+        while (slabs_.size() * kSlabSize < std::min(count + 1, kMaxSlots)) {
+            AllocateSlab();
+        }
+    }
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::Resolve(
+    Link link) const noexcept {
+    if constexpr (kIndexed) {
+        return link ? slabs_[link >> kSlabBits] + (link & (kSlabSize - 1))
+                    : nullptr;
+    } else {
+        return link;
+    }
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Link
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::MakeLink(
+    const Node* node) const noexcept {
+    if constexpr (kIndexed) {
+        return node ? node->self : 0;
+    } else {
+        return const_cast<Node*>(node);
+    }
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr AllocatorTp
-RedBlackTree<ValueTp, AllocatorTp>::NodePool::get_allocator() const {
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::get_allocator() const {
     return allocator_;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 [[nodiscard]]
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeAllocatorTp&
-RedBlackTree<ValueTp, AllocatorTp>::NodePool::get_node_allocator() noexcept {
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeAllocatorTp&
+RedBlackTree<ValueTp, AllocatorTp,
+             Layout>::NodePool::get_node_allocator() noexcept {
     return allocator_;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodePool::~NodePool() {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::~NodePool() {
     Destroy();
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::NodePool::Destroy() {
-    for (Node* node = handle_; node;) {
-        Node* old_node = node;
-        node = node->left;
-        NodeTraits::deallocate(allocator_, old_node, 1);
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::GetFreshNode() {
+    if constexpr (kIndexed) {
+        if (used_slots_ >= slabs_.size() * kSlabSize) {
+            if (used_slots_ == kMaxSlots) [[unlikely]] {
+                throw FormattedException{
+                    "Indexed tree can hold at most ({}) nodes",
+                    kMaxSlots - 1};
+            }
+            AllocateSlab();
+        }
+        return Resolve(static_cast<Link>(used_slots_++));
+    } else {
+        return NodeTraits::allocate(allocator_, 1);
+    }
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::AllocateSlab() {
+    slabs_.push_back(NodeTraits::allocate(allocator_, kSlabSize));
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePool::Destroy() {
+    if constexpr (kIndexed) {
+        // Nodes left in the free list have their values already destroyed
+        for (Node* slab : slabs_) {
+            NodeTraits::deallocate(allocator_, slab, kSlabSize);
+        }
+        slabs_.clear();
+        used_slots_ = 1;
+        handle_ = nullptr;
+    } else {
+        for (Node* node = handle_; node;) {
+            Node* old_node = node;
+            node = node->left;
+            NodeTraits::deallocate(allocator_, old_node, 1);
+        }
     }
 }
 
 // Recursiveless tree iterator!
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeIteratorBase<
     IsConst>::NodeIteratorBase(pointer_type node,
                                [[maybe_unused]] IteratorFromBeginingT) noexcept
     : current_{node ? FindLeftmost(node) : node}, is_sentinel_{!node} {}
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeIteratorBase<
     IsConst>::NodeIteratorBase(pointer_type node,
                                [[maybe_unused]] IteratorFromSentinelT) noexcept
     : current_{node}, is_sentinel_{true} {}
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeIteratorBase<
     IsConst>::NodeIteratorBase(pointer_type node,
                                [[maybe_unused]] IteratorFromNodeT) noexcept
     : current_{node}, is_sentinel_{!node} {}
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<
-    IsConst>::value_type
-RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<IsConst>::operator*()
-    const noexcept {
+[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::
+    NodeIteratorBase<IsConst>::value_type
+    RedBlackTree<ValueTp, AllocatorTp,
+                 Layout>::NodeIteratorBase<IsConst>::operator*()
+        const noexcept {
     return *current_;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<
-    IsConst>::pointer_type
-RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<IsConst>::operator->()
-    const noexcept {
+[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::
+    NodeIteratorBase<IsConst>::pointer_type
+    RedBlackTree<ValueTp, AllocatorTp,
+                 Layout>::NodeIteratorBase<IsConst>::operator->()
+        const noexcept {
     return current_;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<IsConst>&
-RedBlackTree<ValueTp,
-             AllocatorTp>::NodeIteratorBase<IsConst>::operator++() noexcept {
+constexpr RedBlackTree<ValueTp, AllocatorTp,
+                       Layout>::NodeIteratorBase<IsConst>&
+RedBlackTree<ValueTp, AllocatorTp,
+             Layout>::NodeIteratorBase<IsConst>::operator++() noexcept {
     if (current_->right) {
         current_ = FindLeftmost(current_->right);
         return *this;
@@ -194,22 +307,23 @@ RedBlackTree<ValueTp,
     return *this;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-[[nodiscard]] constexpr RedBlackTree<ValueTp,
-                                     AllocatorTp>::NodeIteratorBase<IsConst>
-RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<IsConst>::operator++(
-    int) noexcept {
+[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp,
+                                     Layout>::NodeIteratorBase<IsConst>
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeIteratorBase<
+    IsConst>::operator++(int) noexcept {
     auto temp = *this;
     ++(*this);
     return temp;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<IsConst>&
-RedBlackTree<ValueTp,
-             AllocatorTp>::NodeIteratorBase<IsConst>::operator--() noexcept {
+constexpr RedBlackTree<ValueTp, AllocatorTp,
+                       Layout>::NodeIteratorBase<IsConst>&
+RedBlackTree<ValueTp, AllocatorTp,
+             Layout>::NodeIteratorBase<IsConst>::operator--() noexcept {
     if (is_sentinel_) {
         current_ = FindRightmost(current_);
         is_sentinel_ = false;
@@ -229,70 +343,108 @@ RedBlackTree<ValueTp,
     return *this;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-[[nodiscard]] constexpr RedBlackTree<ValueTp,
-                                     AllocatorTp>::NodeIteratorBase<IsConst>
-RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<IsConst>::operator--(
-    int) noexcept {
+[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp,
+                                     Layout>::NodeIteratorBase<IsConst>
+RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeIteratorBase<
+    IsConst>::operator--(int) noexcept {
     auto temp = *this;
     --(*this);
     return temp;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-[[nodiscard]] constexpr bool
-RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<IsConst>::operator==(
-    const NodeIteratorBase& other) const noexcept {
+[[nodiscard]] constexpr bool RedBlackTree<ValueTp, AllocatorTp, Layout>::
+    NodeIteratorBase<IsConst>::operator==(
+        const NodeIteratorBase& other) const noexcept {
     return (is_sentinel_ == other.is_sentinel_) && (current_ == other.current_);
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-/*static*/ constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<
-    IsConst>::pointer_type
-RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<IsConst>::FindLeftmost(
-    pointer_type node) noexcept {
+/*static*/ constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::
+    NodeIteratorBase<IsConst>::pointer_type
+    RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeIteratorBase<
+        IsConst>::FindLeftmost(pointer_type node) noexcept {
     for (; node->left; node = node->left);
     return node;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 template <bool IsConst>
-/*static*/ constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<
-    IsConst>::pointer_type
-RedBlackTree<ValueTp, AllocatorTp>::NodeIteratorBase<IsConst>::FindRightmost(
-    pointer_type node) noexcept {
+/*static*/ constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::
+    NodeIteratorBase<IsConst>::pointer_type
+    RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeIteratorBase<
+        IsConst>::FindRightmost(pointer_type node) noexcept {
     for (; node->right; node = node->right);
     return node;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodePtr&
-RedBlackTree<ValueTp, AllocatorTp>::root() noexcept {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePtr&
+RedBlackTree<ValueTp, AllocatorTp, Layout>::root() noexcept {
     return root_;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr const RedBlackTree<ValueTp, AllocatorTp>::NodePtr&
-RedBlackTree<ValueTp, AllocatorTp>::root() const noexcept {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr const RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePtr&
+RedBlackTree<ValueTp, AllocatorTp, Layout>::root() const noexcept {
     return root_;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodePtr
-RedBlackTree<ValueTp, AllocatorTp>::InsertNode(ValueTp value) {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::Parent(
+    const Node* node) const noexcept {
+    return pool_.Resolve(node->parent);
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::Left(
+    const Node* node) const noexcept {
+    return pool_.Resolve(node->left);
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::Right(
+    const Node* node) const noexcept {
+    return pool_.Resolve(node->right);
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::SetParent(
+    Node* node, const Node* parent) noexcept {
+    node->parent = pool_.MakeLink(parent);
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::SetLeft(
+    Node* node, const Node* left) noexcept {
+    node->left = pool_.MakeLink(left);
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::SetRight(
+    Node* node, const Node* right) noexcept {
+    node->right = pool_.MakeLink(right);
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodePtr
+RedBlackTree<ValueTp, AllocatorTp, Layout>::InsertNode(ValueTp value) {
     if (!root_) [[unlikely]] {
         root_ = pool_.GetNode(std::move(value));
         CheckInvariants();
         return root_;
     }
     if (auto inserted = this->FindInsertionLocation(value)) {
-        Node* new_node =
-            BuildNode(std::move(value), inserted->first, inserted->second);
-        assert(new_node->parent && "Parent has to exist");
-        if (new_node->parent->color == Node::Color::kRed) {
+        Node* new_node = BuildNode(std::move(value), *inserted);
+        assert(Parent(new_node) && "Parent has to exist");
+        if (Parent(new_node)->color == Node::Color::kRed) {
             FixInsertionImbalance(new_node);
         }
         CheckInvariants();
@@ -301,15 +453,18 @@ RedBlackTree<ValueTp, AllocatorTp>::InsertNode(ValueTp value) {
     return nullptr;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveNode(NodePtr node) {
-    if (node->left && node->right) {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveNode(
+    NodePtr node) {
+    Node* left = Left(node);
+    Node* right = Right(node);
+    if (left && right) {
         RemoveNodeWithTwoChildren(node);
         return CheckInvariants();
     }
 
-    if (node->left || node->right) {
-        RemoveNodeWithOneChild(node, node->left ? node->left : node->right);
+    if (left || right) {
+        RemoveNodeWithOneChild(node, left ? left : right);
         return CheckInvariants();
     }
 
@@ -317,87 +472,146 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveNode(NodePtr node) {
     CheckInvariants();
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIterator
-RedBlackTree<ValueTp, AllocatorTp>::node_begin() noexcept {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::Rebuild(
+    Invocable<bool, const ValueTp&> auto&& retain) {
+    if (!root_) {
+        return;
+    }
+    // Visited nodes are threaded through their left links in the reversed
+    // order since neither the traversal nor the successor lookup reads them
+    Node* retained = nullptr;
+    Node* dropped = nullptr;
+    size_t count = 0;
+    for (Node* node = FindSuccessor(root_); node;) {
+        Node* next = FindNextInOrder(node);
+        if (retain(std::as_const(node->value))) {
+            SetLeft(node, retained);
+            retained = node;
+            ++count;
+        } else {
+            SetLeft(node, dropped);
+            dropped = node;
+        }
+        node = next;
+    }
+
+    while (dropped) {
+        pool_.ReturnNode(std::exchange(dropped, Left(dropped)));
+    }
+
+    // Only the last level can be incomplete, its nodes are left red so every
+    // path holds the same number of black nodes
+    root_ = LinkBalanced(retained, count, 0, std::bit_width(count + 1) - 1);
+    if (root_) {
+        SetParent(root_, nullptr);
+    }
+    CheckInvariants();
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::ReserveNodes(
+    size_t count) {
+    pool_.Reserve(count);
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeIterator
+RedBlackTree<ValueTp, AllocatorTp, Layout>::node_begin() noexcept
+    requires(!kIndexed)
+{
     return NodeIterator{root_, kIteratorFromBegining};
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeConstIterator
-RedBlackTree<ValueTp, AllocatorTp>::node_begin() const noexcept {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeConstIterator
+RedBlackTree<ValueTp, AllocatorTp, Layout>::node_begin() const noexcept
+    requires(!kIndexed)
+{
     return NodeConstIterator{root_, kIteratorFromBegining};
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeIterator
-RedBlackTree<ValueTp, AllocatorTp>::node_end() noexcept {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeIterator
+RedBlackTree<ValueTp, AllocatorTp, Layout>::node_end() noexcept
+    requires(!kIndexed)
+{
     return NodeIterator{root_, kIteratorFromSentinel};
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::NodeConstIterator
-RedBlackTree<ValueTp, AllocatorTp>::node_end() const noexcept {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::NodeConstIterator
+RedBlackTree<ValueTp, AllocatorTp, Layout>::node_end() const noexcept
+    requires(!kIndexed)
+{
     return NodeConstIterator{root_, kIteratorFromSentinel};
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::RotateLeft(Node* node) {
-    Node* right = node->right;
-    Node* right_left = right->left;
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::RotateLeft(
+    Node* node) {
+    Node* right = Right(node);
+    Node* right_left = Left(right);
 
-    node->right = right_left;
-    right->left = node;
+    SetRight(node, right_left);
+    SetLeft(right, node);
 
     RotateHelper(node, right_left, right);
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::RotateRight(Node* node) {
-    Node* left = node->left;
-    Node* left_right = left->right;
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::RotateRight(
+    Node* node) {
+    Node* left = Left(node);
+    Node* left_right = Right(left);
 
-    node->left = left_right;
-    left->right = node;
+    SetLeft(node, left_right);
+    SetRight(left, node);
 
     RotateHelper(node, left_right, left);
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::RotateHelper(Node* node,
-                                                                Node* child,
-                                                                Node* root) {
-    Node* parent = node->parent;
-    root->parent = parent;
-    node->parent = root;
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::RotateHelper(
+    Node* node, Node* child, Node* root) {
+    Node* parent = Parent(node);
+    SetParent(root, parent);
+    SetParent(node, root);
     if (child) {
-        child->parent = node;
+        SetParent(child, node);
     }
     if (parent) {
-        if (node == parent->right) {
-            parent->right = root;
+        if (node == Right(parent)) {
+            SetRight(parent, root);
         } else {
-            parent->left = root;
+            SetLeft(parent, root);
         }
     } else {
         root_ = root;
     }
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::Node*
-RedBlackTree<ValueTp, AllocatorTp>::BuildNode(ValueTp&& value, Node*& node,
-                                              Node* parent) {
-    return node = pool_.GetNode(std::move(value), parent, Node::Color::kRed);
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::BuildNode(
+    ValueTp&& value, const InsertionPoint& location) {
+    Node* node =
+        pool_.GetNode(std::move(value), location.parent, Node::Color::kRed);
+    if (location.is_right_child) {
+        SetRight(location.parent, node);
+    } else {
+        SetLeft(location.parent, node);
+    }
+    return node;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::FixInsertionImbalance(
-    Node* node) {
-    Node* parent = node->parent;
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void
+RedBlackTree<ValueTp, AllocatorTp, Layout>::FixInsertionImbalance(Node* node) {
+    Node* parent = Parent(node);
 
     for (; parent && parent->color == Node::Color::kRed;) {
-        Node* grand_parent = parent->parent;
+        Node* grand_parent = Parent(parent);
 
         if (!grand_parent) {
             parent->color = Node::Color::kBlack;
@@ -411,17 +625,18 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::FixInsertionImbalance(
         parent->color = Node::Color::kBlack;
         grand_parent->color = Node::Color::kRed;
         node = grand_parent;
-        parent = node->parent;
+        parent = Parent(node);
     }
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr bool RedBlackTree<ValueTp, AllocatorTp>::FixLocalInsertionImbalance(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr bool
+RedBlackTree<ValueTp, AllocatorTp, Layout>::FixLocalInsertionImbalance(
     Node*& node, Node*& parent, Node*& grand_parent) {
-    Node* uncle = grand_parent->right == parent ? grand_parent->left
-                                                : grand_parent->right;
+    const bool is_right_parent = Right(grand_parent) == parent;
+    Node* uncle = is_right_parent ? Left(grand_parent) : Right(grand_parent);
     if (!uncle || uncle->color == Node::Color::kBlack) {
-        if (grand_parent->right == parent) {
+        if (is_right_parent) {
             FixLocalInsertionImbalanceRight(node, parent, grand_parent, uncle);
         } else {
             FixLocalInsertionImbalanceLeft(node, parent, grand_parent, uncle);
@@ -434,64 +649,108 @@ constexpr bool RedBlackTree<ValueTp, AllocatorTp>::FixLocalInsertionImbalance(
     return false;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr void
-RedBlackTree<ValueTp, AllocatorTp>::FixLocalInsertionImbalanceRight(
+RedBlackTree<ValueTp, AllocatorTp, Layout>::FixLocalInsertionImbalanceRight(
     Node*& node, Node*& parent, Node*& grand_parent, Node* uncle) {
-    if (node == parent->left) {
+    if (node == Left(parent)) {
         RotateRight(parent);
         node = parent;
-        parent = grand_parent->right;
+        parent = Right(grand_parent);
     }
     RotateLeft(grand_parent);
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr void
-RedBlackTree<ValueTp, AllocatorTp>::FixLocalInsertionImbalanceLeft(
+RedBlackTree<ValueTp, AllocatorTp, Layout>::FixLocalInsertionImbalanceLeft(
     Node*& node, Node*& parent, Node*& grand_parent, Node* uncle) {
-    if (node == parent->right) {
+    if (node == Right(parent)) {
         RotateLeft(parent);
         node = parent;
-        parent = grand_parent->left;
+        parent = Left(grand_parent);
     }
     RotateRight(grand_parent);
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr RedBlackTree<ValueTp, AllocatorTp>::Node*
-RedBlackTree<ValueTp, AllocatorTp>::FindSuccessor(Node* node) {
-    for (; node->left; node = node->left);
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::FindSuccessor(Node* node) {
+    for (Node* left; (left = Left(node)); node = left);
+    return node;
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::FindNextInOrder(Node* node) {
+    if (Node* right = Right(node)) {
+        return FindSuccessor(right);
+    }
+    Node* parent;
+    while ((parent = Parent(node)) && node == Right(parent)) {
+        node = parent;
+    }
+    return parent;
+}
+
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr RedBlackTree<ValueTp, AllocatorTp, Layout>::Node*
+RedBlackTree<ValueTp, AllocatorTp, Layout>::LinkBalanced(Node*& nodes,
+                                                         size_t count,
+                                                         size_t depth,
+                                                         size_t red_depth) {
+    if (!count) {
+        return nullptr;
+    }
+    // Nodes are taken in the descending order so the right subtree goes first
+    const size_t right_count = count / 2;
+    Node* right = LinkBalanced(nodes, right_count, depth + 1, red_depth);
+    Node* node = std::exchange(nodes, Left(nodes));
+    Node* left =
+        LinkBalanced(nodes, count - right_count - 1, depth + 1, red_depth);
+
+    SetLeft(node, left);
+    SetRight(node, right);
+    if (left) {
+        SetParent(left, node);
+    }
+    if (right) {
+        SetParent(right, node);
+    }
+    node->color = depth == red_depth ? Node::Color::kRed : Node::Color::kBlack;
     return node;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeWithTwoChildren(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void
+RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveNodeWithTwoChildren(
     Node* node) {
-    Node* successor = FindSuccessor(node->right);
+    Node* successor = FindSuccessor(Right(node));
 
     auto allocator = pool_.get_allocator();
     ValueTraits::destroy(allocator, std::addressof(node->value));
     ValueTraits::construct(allocator, std::addressof(node->value),
                            std::move(successor->value));
 
-    if (successor->right) {
-        return RemoveNodeWithOneChild(successor, successor->right);
+    if (Node* successor_right = Right(successor)) {
+        return RemoveNodeWithOneChild(successor, successor_right);
     }
     RemoveChildlessNode(successor);
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeWithOneChild(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void
+RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveNodeWithOneChild(
     Node* node, Node* children) {
+    Node* parent = Parent(node);
     children->color = Node::Color::kBlack;
-    children->parent = node->parent;
+    SetParent(children, parent);
 
-    if (node->parent) {
-        if (node == node->parent->left) {
-            node->parent->left = children;
+    if (parent) {
+        if (node == Left(parent)) {
+            SetLeft(parent, children);
         } else {
-            node->parent->right = children;
+            SetRight(parent, children);
         }
     } else {
         root_ = children;
@@ -500,24 +759,25 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeWithOneChild(
     pool_.ReturnNode(node);
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveRootNode() {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveRootNode() {
     pool_.ReturnNode(std::exchange(root_, nullptr));
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr void
-RedBlackTree<ValueTp, AllocatorTp>::PrepareToRemoveRedChildlessNode(
+RedBlackTree<ValueTp, AllocatorTp, Layout>::PrepareToRemoveRedChildlessNode(
     Node* node) {
-    if (node->parent->right == node) {
-        node->parent->right = nullptr;
+    Node* parent = Parent(node);
+    if (Right(parent) == node) {
+        SetRight(parent, nullptr);
     } else {
-        node->parent->left = nullptr;
+        SetLeft(parent, nullptr);
     }
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::
     RemoveBlackChildlessNodeRightPathSiblingIsRed(Node* node, Node* parent,
                                                   Node* sibling,
                                                   Node* left_nephew,
@@ -527,11 +787,11 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::
     sibling->color = Node::Color::kBlack;
     sibling = right_nephew;
 
-    left_nephew = right_nephew->left;
+    left_nephew = Left(right_nephew);
     if (left_nephew && left_nephew->color == Node::Color::kRed) {
         return RemoveNodeRotateParentRightPath(parent, sibling, left_nephew);
     }
-    right_nephew = right_nephew->right;
+    right_nephew = Right(right_nephew);
     if (right_nephew && right_nephew->color == Node::Color::kRed) {
         return RemoveNodeRotateSiblingRightPath(parent, sibling, right_nephew);
     }
@@ -540,13 +800,13 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::
     parent->color = Node::Color::kBlack;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr bool
-RedBlackTree<ValueTp, AllocatorTp>::RemoveBlackChildlessNodeRightPath(
+RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveBlackChildlessNodeRightPath(
     Node* node, Node* parent) {
-    Node* sibling = parent->left;
-    Node* left_nephew = sibling->left;
-    Node* right_nephew = sibling->right;
+    Node* sibling = Left(parent);
+    Node* left_nephew = Left(sibling);
+    Node* right_nephew = Right(sibling);
 
     if (sibling->color == Node::Color::kRed) {
         RemoveBlackChildlessNodeRightPathSiblingIsRed(
@@ -573,8 +833,8 @@ RedBlackTree<ValueTp, AllocatorTp>::RemoveBlackChildlessNodeRightPath(
     return false;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::
     RemoveBlackChildlessNodeLeftPathSiblingIsRed(Node* node, Node* parent,
                                                  Node* sibling,
                                                  Node* left_nephew,
@@ -584,11 +844,11 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::
     sibling->color = Node::Color::kBlack;
     sibling = left_nephew;
 
-    right_nephew = left_nephew->right;
+    right_nephew = Right(left_nephew);
     if (right_nephew && right_nephew->color == Node::Color::kRed) {
         return RemoveNodeRotateParentLeftPath(parent, sibling, right_nephew);
     }
-    left_nephew = left_nephew->left;
+    left_nephew = Left(left_nephew);
     if (left_nephew && left_nephew->color == Node::Color::kRed) {
         return RemoveNodeRotateSiblingLeftPath(parent, sibling, left_nephew);
     }
@@ -597,13 +857,13 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::
     parent->color = Node::Color::kBlack;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr bool
-RedBlackTree<ValueTp, AllocatorTp>::RemoveBlackChildlessNodeLeftPath(
+RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveBlackChildlessNodeLeftPath(
     Node* node, Node* parent) {
-    Node* sibling = parent->right;
-    Node* left_nephew = sibling->left;
-    Node* right_nephew = sibling->right;
+    Node* sibling = Right(parent);
+    Node* left_nephew = Left(sibling);
+    Node* right_nephew = Right(sibling);
 
     if (sibling->color == Node::Color::kRed) {
         RemoveBlackChildlessNodeLeftPathSiblingIsRed(node, parent, sibling,
@@ -630,24 +890,25 @@ RedBlackTree<ValueTp, AllocatorTp>::RemoveBlackChildlessNodeLeftPath(
     return false;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveBlackChildlessNode(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void
+RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveBlackChildlessNode(
     Node* node) {
-    if (node->parent->right == node) {
-        node->parent->right = nullptr;
-        if (RemoveBlackChildlessNodeRightPath(node, node->parent)) {
+    Node* parent = Parent(node);
+    if (Right(parent) == node) {
+        SetRight(parent, nullptr);
+        if (RemoveBlackChildlessNodeRightPath(node, parent)) {
             return;
         }
     } else {
-        node->parent->left = nullptr;
-        if (RemoveBlackChildlessNodeLeftPath(node, node->parent)) {
+        SetLeft(parent, nullptr);
+        if (RemoveBlackChildlessNodeLeftPath(node, parent)) {
             return;
         }
     }
 
-    for (node = node->parent; Node* parent = node->parent;
-         node = node->parent) {
-        if (parent->right == node) {
+    for (node = parent; (parent = Parent(node)); node = parent) {
+        if (Right(parent) == node) {
             if (RemoveBlackChildlessNodeRightPath(node, parent)) {
                 return;
             }
@@ -659,8 +920,8 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveBlackChildlessNode(
     }
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveChildlessNode(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveChildlessNode(
     Node* node) {
     if (node == root_) {
         return RemoveRootNode();
@@ -676,9 +937,9 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::RemoveChildlessNode(
     RemoveBlackChildlessNode(node);
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr void
-RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeRotateSiblingRightPath(
+RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveNodeRotateSiblingRightPath(
     Node* parent, Node* sibling, Node* nephew) {
     RotateLeft(sibling);
     sibling->color = Node::Color::kRed;
@@ -686,9 +947,9 @@ RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeRotateSiblingRightPath(
     RemoveNodeRotateParentRightPath(parent, nephew, sibling);
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr void
-RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeRotateSiblingLeftPath(
+RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveNodeRotateSiblingLeftPath(
     Node* parent, Node* sibling, Node* nephew) {
     RotateRight(sibling);
     sibling->color = Node::Color::kRed;
@@ -696,9 +957,9 @@ RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeRotateSiblingLeftPath(
     RemoveNodeRotateParentLeftPath(parent, nephew, sibling);
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr void
-RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeRotateParentRightPath(
+RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveNodeRotateParentRightPath(
     Node* parent, Node* sibling, Node* nephew) {
     RotateRight(parent);
     sibling->color = parent->color;
@@ -706,9 +967,9 @@ RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeRotateParentRightPath(
     nephew->color = Node::Color::kBlack;
 }
 
-template <typename ValueTp, typename AllocatorTp>
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr void
-RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeRotateParentLeftPath(
+RedBlackTree<ValueTp, AllocatorTp, Layout>::RemoveNodeRotateParentLeftPath(
     Node* parent, Node* sibling, Node* nephew) {
     RotateLeft(parent);
     sibling->color = parent->color;
@@ -716,24 +977,25 @@ RedBlackTree<ValueTp, AllocatorTp>::RemoveNodeRotateParentLeftPath(
     nephew->color = Node::Color::kBlack;
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::Destroy() {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::Destroy() {
     // Instead of calling a recursive destructor call, deallocate tree in place
     // in order to avoid stack overflow for large structures!
     for (Node* node = root_; root_;) {
-        if (node->left != nullptr) {
-            node = std::exchange(node->left, nullptr);
+        if (Node* left = Left(node)) {
+            SetLeft(node, nullptr);
+            node = left;
             continue;
         }
 
-        if (node->right != nullptr) {
-            node = std::exchange(node->right, nullptr);
+        if (Node* right = Right(node)) {
+            SetRight(node, nullptr);
+            node = right;
             continue;
         }
 
-        Node* parent = node->parent;
-        NodeTraits::destroy(pool_.get_node_allocator(), node);
-        NodeTraits::deallocate(pool_.get_node_allocator(), node, 1);
+        Node* parent = Parent(node);
+        pool_.ReleaseNode(node);
         if (!parent) {
             return;  // root can be left with dangling pointer
         }
@@ -741,60 +1003,59 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::Destroy() {
     }
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::CloneNodeChildren(
-    const Node* node, Node* clone)
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::CloneNodeChildren(
+    const RedBlackTree& source, const Node* node, Node* clone)
     requires std::is_copy_constructible_v<ValueTp>
 {
-    if (node->left) {
-        clone->left =
-            pool_.GetNode(node->left->value, clone, node->left->color);
+    if (const Node* left = source.Left(node)) {
+        SetLeft(clone, pool_.GetNode(left->value, clone, left->color));
     }
-    if (node->right) {
-        clone->right =
-            pool_.GetNode(node->right->value, clone, node->right->color);
+    if (const Node* right = source.Right(node)) {
+        SetRight(clone, pool_.GetNode(right->value, clone, right->color));
     }
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::PopulateClonedRoot(
-    const Node* root)
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::PopulateClonedRoot(
+    const RedBlackTree& source)
     requires std::is_copy_constructible_v<ValueTp>
 {
-    const Node* node = root;
+    const Node* node = source.root_;
     Node* clone = root_;
 
     while (node) {
-        CloneNodeChildren(node, clone);
+        CloneNodeChildren(source, node, clone);
 
-        if (node->left) {
-            node = node->left;
-            clone = clone->left;
+        if (const Node* left = source.Left(node)) {
+            node = left;
+            clone = Left(clone);
             continue;
         }
 
-        if (node->right) {
-            node = node->right;
-            clone = clone->right;
+        if (const Node* right = source.Right(node)) {
+            node = right;
+            clone = Right(clone);
             continue;
         }
 
         const Node* previous;
         do {
             previous = node;
-            node = node->parent;
-            clone = clone->parent;
-        } while (node && (previous == node->right || !node->right));
+            node = source.Parent(node);
+            clone = Parent(clone);
+        } while (node &&
+                 (previous == source.Right(node) || !source.Right(node)));
 
         if (node) {
-            node = node->right;
-            clone = clone->right;
+            node = source.Right(node);
+            clone = Right(clone);
         }
     }
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::CloneFrom(
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::CloneFrom(
     const RedBlackTree& source)
     requires std::is_copy_constructible_v<ValueTp>
 {
@@ -804,90 +1065,58 @@ constexpr void RedBlackTree<ValueTp, AllocatorTp>::CloneFrom(
     }
 
     root_ = pool_.GetNode(source.root_->value, nullptr, source.root_->color);
-    PopulateClonedRoot(source.root_);
+    PopulateClonedRoot(source);
 }
 
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::CheckInvariants() const {
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void RedBlackTree<ValueTp, AllocatorTp, Layout>::CheckInvariants()
+    const {
 #ifdef KODA_CHECKED_BUILD
-    ValidateRedNodeConstraint();
-    ValidateBlackNodeConstraint();
+    ValidateRedNodeConstraint(root_);
+    ValidateBlackNodeConstraint(root_);
 #endif  // KODA_CHECKED_BUILD
 }
 
 #ifdef KODA_CHECKED_BUILD
 
-template <typename ValueTp, typename AllocatorTp>
-/*static*/ constexpr std::ranges::subrange<
-    typename RedBlackTree<ValueTp, AllocatorTp>::NodeConstIterator,
-    typename RedBlackTree<ValueTp, AllocatorTp>::NodeConstIterator>
-RedBlackTree<ValueTp, AllocatorTp>::nodes(const Node* root) noexcept {
-    return {NodeConstIterator{root, kIteratorFromBegining},
-            NodeConstIterator{root, kIteratorFromSentinel}};
-}
-
 // A red node does not have a red child
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::ValidateRedNodeConstraint()
-    const {
-    for (const Node& node : nodes(root_)) {
-        if (node.color == Node::Color::kRed) {
-            if (node.left && node.left->color == Node::Color::kRed) {
-                throw std::logic_error{"Red node invariant broken!"};
-            }
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void
+RedBlackTree<ValueTp, AllocatorTp, Layout>::ValidateRedNodeConstraint(
+    const Node* node) const {
+    if (!node) {
+        return;
+    }
+    const Node* left = Left(node);
+    const Node* right = Right(node);
+    if (node->color == Node::Color::kRed) {
+        if (left && left->color == Node::Color::kRed) {
+            throw std::logic_error{"Red node invariant broken!"};
+        }
 
-            if (node.right && node.right->color == Node::Color::kRed) {
-                throw std::logic_error{"Red node invariant broken!"};
-            }
+        if (right && right->color == Node::Color::kRed) {
+            throw std::logic_error{"Red node invariant broken!"};
         }
     }
+    ValidateRedNodeConstraint(left);
+    ValidateRedNodeConstraint(right);
 }
 
 // Every path from a given node to any of its leaf nodes goes through
-// the same number of black nodes
-template <typename ValueTp, typename AllocatorTp>
-constexpr void RedBlackTree<ValueTp, AllocatorTp>::ValidateBlackNodeConstraint()
-    const {
-    class SubtreeDetacher {
-       public:
-        constexpr SubtreeDetacher(const Node& node) noexcept
-            : node_{node}, parent_{node.parent} {
-            const_cast<Node&>(node_).parent = nullptr;
-        }
-
-        constexpr ~SubtreeDetacher() {
-            const_cast<Node&>(node_).parent = parent_;
-        }
-
-       private:
-        const Node& node_;
-        Node* parent_;
-    };
-
-    for (const Node& node : nodes(root_)) {
-        int64_t total_black_count = -1;
-
-        // temporarly remove parent!
-        // Otherwise it will start seeking higher nodes and will miss
-        // sentinel!
-        SubtreeDetacher detacher{node};
-        for (const Node& child : nodes(&node)) {
-            if (!child.left && !child.right) {
-                int64_t count = 0;
-                for (auto* path_node = &child; path_node != &node;
-                     path_node = path_node->parent) {
-                    if (path_node->color == Node::Color::kBlack) {
-                        ++count;
-                    }
-                }
-                if (total_black_count == -1) {
-                    total_black_count = count;
-                } else if (total_black_count != count) {
-                    throw std::logic_error{"Black node invariant broken!"};
-                }
-            }
-        }
+// the same number of black nodes. Recursion depth is bounded by the tree
+// height which is logarithmic as long as the invariants hold
+template <typename ValueTp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr size_t
+RedBlackTree<ValueTp, AllocatorTp, Layout>::ValidateBlackNodeConstraint(
+    const Node* node) const {
+    if (!node) {
+        return 0;
+    }
+    const size_t left_height = ValidateBlackNodeConstraint(Left(node));
+    if (left_height != ValidateBlackNodeConstraint(Right(node))) {
+        throw std::logic_error{"Black node invariant broken!"};
     }
+    return left_height + (node->color == Node::Color::kBlack);
 }
 
 #endif  // KODA_CHECKED_BUILD
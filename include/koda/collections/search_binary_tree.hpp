@@ -1,8 +1,11 @@
 #pragma once
 
+#include <koda/collections/match_finder.hpp>
 #include <koda/collections/red_black_tree.hpp>
+#include <koda/utils/comparation.hpp>
 
 #include <cinttypes>
+#include <concepts>
 #include <cstdlib>
 #include <memory>
 #include <optional>
@@ -14,33 +17,36 @@ namespace koda {
 
 namespace details {
 
+// Strings held by the tree lie less than 2^32 positions apart so only the
+// low half of the insertion index is stored, which shrinks the indexed node
+// down to 40 bytes
 template <typename Tp>
 struct SearchBinaryTreeEntry {
-    size_t ref_counter = 1;
-    size_t insertion_index;
+    uint32_t ref_counter = 1;
+    uint32_t insertion_index;
     const Tp* key;
+    // First symbols of the byte keys packed in the big-endian order so most
+    // of the branch decisions are made without touching the window
+    uint64_t key_prefix = 0;
 };
 
 }  // namespace details
 
-template <typename Tp, typename AllocatorTp = std::allocator<Tp>>
+/// Layout selects how the underlying red black tree stores its nodes, the
+/// indexed one keeps them in the slabs that can be reserved for the whole
+/// window up front. With a non-zero expiry period the strings leaving the
+/// window are only marked as expired, skipped by the searches and pruned
+/// all at once when the given number of them piles up
+template <typename Tp, typename AllocatorTp = std::allocator<Tp>,
+          RedBlackTreeLayout Layout = RedBlackTreeLayout::kPointer>
 class SearchBinaryTree
-    : public RedBlackTree<details::SearchBinaryTreeEntry<Tp>, AllocatorTp> {
+    : public RedBlackTree<details::SearchBinaryTreeEntry<Tp>, AllocatorTp,
+                          Layout> {
    public:
     using ValueType = Tp;
     using StringView = std::basic_string_view<ValueType>;
 
-    struct [[nodiscard]] RepeatitionMarker {
-        size_t match_position;
-        size_t match_length;
-
-        [[nodiscard]] inline constexpr operator bool() const noexcept {
-            return match_length != 0;
-        }
-
-        [[nodiscard]] constexpr auto operator<=>(
-            const RepeatitionMarker&) const noexcept = default;
-    };
+    using RepeatitionMarker = koda::RepeatitionMarker;
 
     constexpr explicit SearchBinaryTree(
         size_t string_size,
@@ -65,17 +71,44 @@ class SearchBinaryTree
 
     [[nodiscard]] constexpr size_t size() const noexcept;
 
+    // Prepares the nodes for the given number of strings
+    constexpr void reserve(size_t count);
+
+    // Zero removes every string eagerly. Has to be chosen before any string
+    // is added. Expired strings still point into the window so the period
+    // cannot exceed the part of the window retained behind the dictionary,
+    // the LZ encoders reject such periods
+    constexpr void set_expiry_period(size_t expiry_period) noexcept;
+
+    [[nodiscard]] constexpr size_t expiry_period() const noexcept;
+
     constexpr ~SearchBinaryTree() override = default;
 
    private:
     using Entry = details::SearchBinaryTreeEntry<Tp>;
-    using RedBlackImpl = RedBlackTree<Entry, AllocatorTp>;
+    using RedBlackImpl = RedBlackTree<Entry, AllocatorTp, Layout>;
     using Node = RedBlackImpl::Node;
     using NodeInsertionLocation = RedBlackImpl::NodeInsertionLocation;
 
+    // Only the byte keys whose symbols are ordered as unsigned values can be
+    // compared by their packed prefixes
+    static constexpr bool kCachesKeyPrefix =
+        sizeof(Tp) == 1 &&
+        (std::same_as<Tp, char> || std::unsigned_integral<Tp>);
+    static constexpr size_t kKeyPrefixLength = sizeof(uint64_t);
+
     size_t dictionary_start_index_ = 0;
     size_t buffer_start_index_ = 0;
     size_t string_size_;
+    size_t expiry_period_ = 0;
+    size_t expired_strings_ = 0;
+
+    [[nodiscard]] constexpr size_t InsertionIndex(
+        const Entry& entry) const noexcept;
+
+    [[nodiscard]] constexpr bool IsExpired(const Entry& entry) const noexcept;
+
+    constexpr void ExpireString();
 
     constexpr void UpdateNodeReference(Node* node, const ValueType* key);
 
@@ -85,13 +118,20 @@ class SearchBinaryTree
     constexpr std::pair<size_t, size_t> FindString(const ValueType* buffer,
                                                    size_t length) const;
 
-    constexpr static void UpdateMatchInfo(std::pair<size_t, size_t>& match_info,
-                                          size_t prefix_length,
-                                          const Node* node) noexcept;
+    constexpr void UpdateMatchInfo(std::pair<size_t, size_t>& match_info,
+                                   size_t prefix_length,
+                                   const Node* node) const noexcept;
+
+    // Common prefix length and the ordering of both strings in a single pass
+    constexpr static std::pair<size_t, WeakOrdering> CompareStrings(
+        const ValueType* left, const ValueType* right, size_t length) noexcept;
+
+    constexpr static std::pair<size_t, WeakOrdering> CompareWithNode(
+        const ValueType* string, uint64_t string_prefix, const Entry& entry,
+        size_t length) noexcept;
 
-    constexpr size_t FindCommonPrefixSize(const ValueType* buffer,
-                                          const ValueType* node,
-                                          size_t length) const noexcept;
+    constexpr static uint64_t PackKeyPrefix(const ValueType* key,
+                                            size_t length) noexcept;
 
     constexpr Node* FindNodeToRemoval(StringView key_view);
 };
@@ -1,26 +1,43 @@
-#include <koda/utils/comparation.hpp>
+#include <koda/utils/utils.hpp>
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <climits>
 
 namespace koda {
 
-template <typename Tp, typename AllocatorTp>
-constexpr SearchBinaryTree<Tp, AllocatorTp>::SearchBinaryTree(
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr SearchBinaryTree<Tp, AllocatorTp, Layout>::SearchBinaryTree(
     size_t string_size, const AllocatorTp& allocator) noexcept
     : RedBlackImpl{allocator}, string_size_{string_size} {}
 
-template <typename Tp, typename AllocatorTp>
-constexpr void SearchBinaryTree<Tp, AllocatorTp>::AddString(StringView string) {
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void SearchBinaryTree<Tp, AllocatorTp, Layout>::AddString(
+    StringView string) {
     assert(string.size() == string_size_ &&
            "Inserted string have to have fixed size equal to string_size_");
+    assert(size() + expiry_period_ < (size_t{1} << 32) &&
+           "Strings held by the tree have to lie less than 2^32 positions "
+           "apart");
 
-    this->InsertNode(Entry{1, buffer_start_index_, string.data()});
+    this->InsertNode(Entry{1, static_cast<uint32_t>(buffer_start_index_),
+                           string.data(),
+                           PackKeyPrefix(string.data(), string_size_)});
     ++buffer_start_index_;
 }
 
-template <typename Tp, typename AllocatorTp>
-constexpr bool SearchBinaryTree<Tp, AllocatorTp>::RemoveString(
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr bool SearchBinaryTree<Tp, AllocatorTp, Layout>::RemoveString(
     StringView string) {
+    if (expiry_period_) {
+        if (!size()) [[unlikely]] {
+            return false;
+        }
+        ExpireString();
+        return true;
+    }
+
     Node* node = FindNodeToRemoval(string);
 
     if (!node) [[unlikely]] {
@@ -35,9 +52,9 @@ constexpr bool SearchBinaryTree<Tp, AllocatorTp>::RemoveString(
     return true;
 }
 
-template <typename Tp, typename AllocatorTp>
-constexpr SearchBinaryTree<Tp, AllocatorTp>::RepeatitionMarker
-SearchBinaryTree<Tp, AllocatorTp>::FindMatch(StringView buffer) const {
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr SearchBinaryTree<Tp, AllocatorTp, Layout>::RepeatitionMarker
+SearchBinaryTree<Tp, AllocatorTp, Layout>::FindMatch(StringView buffer) const {
     assert(
         buffer.size() <= string_size_ &&
         "Inserted string have to have fixed size not bigger than string_size_");
@@ -52,112 +69,215 @@ SearchBinaryTree<Tp, AllocatorTp>::FindMatch(StringView buffer) const {
             position - dictionary_start_index_, length};
 }
 
-template <typename Tp, typename AllocatorTp>
-[[nodiscard]] constexpr size_t SearchBinaryTree<Tp, AllocatorTp>::string_size()
-    const noexcept {
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr size_t
+SearchBinaryTree<Tp, AllocatorTp, Layout>::string_size() const noexcept {
     return string_size_;
 }
 
-template <typename Tp, typename AllocatorTp>
-[[nodiscard]] constexpr size_t SearchBinaryTree<Tp, AllocatorTp>::size()
-    const noexcept {
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr size_t
+SearchBinaryTree<Tp, AllocatorTp, Layout>::size() const noexcept {
     return buffer_start_index_ - dictionary_start_index_;
 }
 
-template <typename Tp, typename AllocatorTp>
-constexpr void SearchBinaryTree<Tp, AllocatorTp>::UpdateNodeReference(
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void SearchBinaryTree<Tp, AllocatorTp, Layout>::reserve(
+    size_t count) {
+    this->ReserveNodes(count);
+}
+
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void SearchBinaryTree<Tp, AllocatorTp, Layout>::set_expiry_period(
+    size_t expiry_period) noexcept {
+    assert(!buffer_start_index_ &&
+           "Expiry period has to be set before any string is added");
+    expiry_period_ = expiry_period;
+}
+
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr size_t
+SearchBinaryTree<Tp, AllocatorTp, Layout>::expiry_period() const noexcept {
+    return expiry_period_;
+}
+
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr size_t
+SearchBinaryTree<Tp, AllocatorTp, Layout>::InsertionIndex(
+    const Entry& entry) const noexcept {
+    // Distance to the next insertion is computed modulo 2^32 so the index
+    // is restored even after the low halves have wrapped around
+    return buffer_start_index_ -
+           static_cast<uint32_t>(static_cast<uint32_t>(buffer_start_index_) -
+                                 entry.insertion_index);
+}
+
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+[[nodiscard]] constexpr bool
+SearchBinaryTree<Tp, AllocatorTp, Layout>::IsExpired(
+    const Entry& entry) const noexcept {
+    // Equivalent strings share the node holding the newest of them so the
+    // node expires together with it
+    return InsertionIndex(entry) < dictionary_start_index_;
+}
+
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void SearchBinaryTree<Tp, AllocatorTp, Layout>::ExpireString() {
+    ++dictionary_start_index_;
+    if (++expired_strings_ < expiry_period_) {
+        return;
+    }
+    // Reference counters are not maintained in this mode, the newest
+    // insertion index alone decides whether the node is still alive
+    this->Rebuild([this](const Entry& entry) { return !IsExpired(entry); });
+    expired_strings_ = 0;
+}
+
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void SearchBinaryTree<Tp, AllocatorTp, Layout>::UpdateNodeReference(
     Node* node, const ValueType* key) {
     ++node->value.ref_counter;
     node->value.key = key;
-    node->value.insertion_index = buffer_start_index_;
+    node->value.insertion_index = static_cast<uint32_t>(buffer_start_index_);
 }
 
-template <typename Tp, typename AllocatorTp>
-constexpr SearchBinaryTree<Tp, AllocatorTp>::NodeInsertionLocation
-SearchBinaryTree<Tp, AllocatorTp>::FindInsertionLocation(const Entry& entry) {
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr SearchBinaryTree<Tp, AllocatorTp, Layout>::NodeInsertionLocation
+SearchBinaryTree<Tp, AllocatorTp, Layout>::FindInsertionLocation(
+    const Entry& entry) {
     const ValueType* key = entry.key;
-    const StringView key_view{key, string_size_};
-    Node** node = &this->root();
     Node* parent = nullptr;
-    while (*node) {
-        switch (OrderCast(key_view <=>
-                          StringView{(*node)->value.key, string_size_})) {
+    bool is_right_child = false;
+    for (Node* node = this->root(); node;) {
+        switch (
+            CompareWithNode(key, entry.key_prefix, node->value, string_size_)
+                .second) {
             case WeakOrdering::kEquivalent:
-                UpdateNodeReference(*node, key);
+                // Expired node is revived by the string equivalent to it
+                UpdateNodeReference(node, key);
                 return std::nullopt;
             case WeakOrdering::kLess:
-                parent = *node;
-                node = &(*node)->left;
+                is_right_child = false;
                 break;
             case WeakOrdering::kGreater:
-                parent = *node;
-                node = &(*node)->right;
+                is_right_child = true;
                 break;
             default:
                 std::unreachable();
         };
+        parent = std::exchange(
+            node, is_right_child ? this->Right(node) : this->Left(node));
     }
-    return NodeInsertionLocation{std::in_place, *node, parent};
+    return NodeInsertionLocation{std::in_place, parent, is_right_child};
 }
 
-template <typename Tp, typename AllocatorTp>
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
 constexpr std::pair<size_t, size_t>
-SearchBinaryTree<Tp, AllocatorTp>::FindString(const ValueType* buffer,
-                                              size_t length) const {
+SearchBinaryTree<Tp, AllocatorTp, Layout>::FindString(
+    const ValueType* buffer, size_t length) const {
     std::pair<size_t, size_t> match{};
+    const uint64_t buffer_prefix = PackKeyPrefix(buffer, length);
     for (const Node* node = this->root(); node;) {
-        auto prefix_length =
-            FindCommonPrefixSize(buffer, node->value.key, length);
-        if (prefix_length == length) {
-            return {node->value.insertion_index, length};
-        }
-        UpdateMatchInfo(match, prefix_length, node);
-
-        if (StringView{buffer, length} <
-            StringView{node->value.key, string_size_}) {
-            node = node->left;
-        } else {
-            node = node->right;
+        auto [prefix_length, ordering] =
+            CompareWithNode(buffer, buffer_prefix, node->value, length);
+        // Expired nodes still direct the descent but are never matched
+        if (!IsExpired(node->value)) {
+            if (ordering == WeakOrdering::kEquivalent) {
+                return {InsertionIndex(node->value), length};
+            }
+            UpdateMatchInfo(match, prefix_length, node);
         }
+        node = ordering == WeakOrdering::kGreater ? this->Right(node)
+                                                  : this->Left(node);
     }
     return match;
 }
 
-template <typename Tp, typename AllocatorTp>
-/*static*/ constexpr void SearchBinaryTree<Tp, AllocatorTp>::UpdateMatchInfo(
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr void SearchBinaryTree<Tp, AllocatorTp, Layout>::UpdateMatchInfo(
     std::pair<size_t, size_t>& match_info, size_t prefix_length,
-    const Node* node) noexcept {
+    const Node* node) const noexcept {
     if (match_info.second < prefix_length) {
-        match_info.first = node->value.insertion_index;
+        match_info.first = InsertionIndex(node->value);
         match_info.second = prefix_length;
     }
 }
 
-template <typename Tp, typename AllocatorTp>
-constexpr size_t SearchBinaryTree<Tp, AllocatorTp>::FindCommonPrefixSize(
-    const ValueType* buffer, const ValueType* node,
-    size_t length) const noexcept {
-    for (size_t i = 0; i < length; ++i) {
-        if (buffer[i] != node[i]) {
-            return i;
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+/*static*/ constexpr std::pair<size_t, WeakOrdering>
+SearchBinaryTree<Tp, AllocatorTp, Layout>::CompareStrings(
+    const ValueType* left, const ValueType* right, size_t length) noexcept {
+    const size_t prefix_length = CommonPrefixLength(left, right, length);
+    if (prefix_length == length) {
+        return {length, WeakOrdering::kEquivalent};
+    }
+    // Mismatching symbols are ordered the same way as the string views are
+    return {prefix_length, StringView::traits_type::lt(left[prefix_length],
+                                                       right[prefix_length])
+                               ? WeakOrdering::kLess
+                               : WeakOrdering::kGreater};
+}
+
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+/*static*/ constexpr std::pair<size_t, WeakOrdering>
+SearchBinaryTree<Tp, AllocatorTp, Layout>::CompareWithNode(
+    const ValueType* string, uint64_t string_prefix, const Entry& entry,
+    size_t length) noexcept {
+    if constexpr (kCachesKeyPrefix) {
+        const size_t cached = std::min(length, kKeyPrefixLength);
+        const uint64_t mask =
+            cached ? ~uint64_t{0} << (CHAR_BIT * (kKeyPrefixLength - cached))
+                   : 0;
+        // Highest differing bit belongs to the first mismatching symbol
+        const uint64_t difference = (string_prefix ^ entry.key_prefix) & mask;
+        if (difference) {
+            return {std::countl_zero(difference) / CHAR_BIT,
+                    string_prefix < entry.key_prefix ? WeakOrdering::kLess
+                                                     : WeakOrdering::kGreater};
+        }
+        // Window is touched only when the cached prefixes tie
+        auto [prefix_length, ordering] = CompareStrings(
+            string + cached, entry.key + cached, length - cached);
+        return {cached + prefix_length, ordering};
+    }
+    return CompareStrings(string, entry.key, length);
+}
+
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+/*static*/ constexpr uint64_t
+SearchBinaryTree<Tp, AllocatorTp, Layout>::PackKeyPrefix(
+    const ValueType* key, size_t length) noexcept {
+    uint64_t prefix = 0;
+    if constexpr (kCachesKeyPrefix) {
+        const size_t cached = std::min(length, kKeyPrefixLength);
+        for (size_t i = 0; i < cached; ++i) {
+            prefix |= uint64_t{static_cast<uint8_t>(key[i])}
+                      << (CHAR_BIT * (kKeyPrefixLength - 1 - i));
         }
     }
-    return length;
+    return prefix;
 }
 
-template <typename Tp, typename AllocatorTp>
-constexpr SearchBinaryTree<Tp, AllocatorTp>::Node*
-SearchBinaryTree<Tp, AllocatorTp>::FindNodeToRemoval(StringView key_view) {
+template <typename Tp, typename AllocatorTp, RedBlackTreeLayout Layout>
+constexpr SearchBinaryTree<Tp, AllocatorTp, Layout>::Node*
+SearchBinaryTree<Tp, AllocatorTp, Layout>::FindNodeToRemoval(
+    StringView key_view) {
+    if (key_view.size() != string_size_) [[unlikely]] {
+        return nullptr;
+    }
+
+    const uint64_t key_prefix = PackKeyPrefix(key_view.data(), string_size_);
     for (Node* node = this->root(); node;) {
-        switch (
-            OrderCast(key_view <=> StringView{node->value.key, string_size_})) {
+        switch (CompareWithNode(key_view.data(), key_prefix, node->value,
+                                string_size_)
+                    .second) {
             case WeakOrdering::kEquivalent:
                 return node;
             case WeakOrdering::kLess:
-                node = node->left;
+                node = this->Left(node);
                 break;
             case WeakOrdering::kGreater:
-                node = node->right;
+                node = this->Right(node);
                 break;
             default:
                 std::unreachable();
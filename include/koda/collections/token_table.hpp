@@ -0,0 +1,121 @@
+#pragma once
+
+#include <koda/collections/map.hpp>
+
+#include <cinttypes>
+#include <concepts>
+#include <memory>
+#include <new>
+#include <ranges>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+namespace koda {
+
+/// Tokens that can index the flat array by their offset from the smallest
+/// token of the table
+template <typename Token>
+concept DenselyIndexableToken =
+    std::integral<Token> && !std::same_as<Token, bool>;
+
+namespace details {
+
+/// Allocates the storage aligned to the given boundary outside of the
+/// constant evaluation (which uses std::allocator regardless)
+template <typename Tp, size_t Alignment>
+class AlignedAllocator {
+   public:
+    using value_type = Tp;
+
+    template <typename Up>
+    struct rebind {
+        using other = AlignedAllocator<Up, Alignment>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template <typename Up>
+    constexpr AlignedAllocator(
+        const AlignedAllocator<Up, Alignment>& other) noexcept;
+
+    [[nodiscard]] constexpr Tp* allocate(size_t count);
+
+    constexpr void deallocate(Tp* pointer, size_t count) noexcept;
+
+    [[nodiscard]] constexpr bool operator==(
+        const AlignedAllocator& other) const noexcept = default;
+};
+
+}  // namespace details
+
+/// Token indexed lookup table. Tokens satisfying the DenselyIndexableToken
+/// are kept in the flat array spanning from the smallest to the largest
+/// inserted token so the lookup is a single indexed load. Once the span
+/// reaches the kMaxDenseSpan (and for the other tokens) the Map is used
+template <typename Token, typename ValueTp>
+class TokenTable {
+   public:
+    static constexpr bool kCanBeDense = DenselyIndexableToken<Token>;
+    static constexpr size_t kMaxDenseSpan = 1 << 16;
+
+    constexpr TokenTable() = default;
+
+    template <std::ranges::input_range Range>
+        requires SpecializationOf<std::ranges::range_value_t<Range>, std::pair>
+    constexpr explicit TokenTable(Range&& range);
+
+    /// Inserts the value or replaces the already present one
+    constexpr void Insert(const Token& token, ValueTp value);
+
+    [[nodiscard]] constexpr bool Contains(const Token& token) const;
+
+    [[nodiscard]] constexpr auto&& At(this auto&& self, const Token& token);
+
+    /// Returns the pointer to the token's value or nullptr when the token is
+    /// not a part of the table
+    [[nodiscard]] constexpr auto* Find(this auto&& self, const Token& token);
+
+    /// Unchecked lookup for the tokens already known to be a part of the
+    /// table
+    [[nodiscard]] constexpr auto&& operator[](this auto&& self,
+                                              const Token& token);
+
+    [[nodiscard]] constexpr bool is_dense() const noexcept;
+
+   private:
+    static constexpr size_t kCacheLineSize = 64;
+
+    // Dense storage starts at the cache line boundary so the lookups of the
+    // small alphabets touch as few lines as possible
+    using DenseStorage =
+        std::vector<ValueTp,
+                    details::AlignedAllocator<ValueTp, kCacheLineSize>>;
+    using UnsignedTp =
+        typename std::conditional_t<kCanBeDense, std::make_unsigned<Token>,
+                                    std::type_identity<void>>::type;
+    using DenseOffsetTp =
+        std::conditional_t<kCanBeDense, Token, std::monostate>;
+
+    // Tokens are kept in the dense storage as long as the sparse one is
+    // empty, the dense storage keeps the presence of each token separately
+    DenseStorage dense_values_;
+    std::vector<bool> present_;
+    [[no_unique_address]] DenseOffsetTp dense_offset_ = {};
+    Map<Token, ValueTp> sparse_values_;
+
+    // Tokens below the offset wrap around to the indices past the storage
+    [[nodiscard]] constexpr size_t DenseIndex(const Token& token) const noexcept
+        requires kCanBeDense;
+
+    [[nodiscard]] constexpr bool InsertDense(const Token& token,
+                                             ValueTp& value)
+        requires kCanBeDense;
+
+    constexpr void MoveToSparse()
+        requires kCanBeDense;
+};
+
+}  // namespace koda
+
+#include <koda/collections/token_table.tpp>
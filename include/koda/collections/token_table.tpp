@@ -0,0 +1,188 @@
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <stdexcept>
+#include <utility>
+
+namespace koda {
+
+namespace details {
+
+template <typename Tp, size_t Alignment>
+template <typename Up>
+constexpr AlignedAllocator<Tp, Alignment>::AlignedAllocator(
+    [[maybe_unused]] const AlignedAllocator<Up, Alignment>& other) noexcept {}
+
+template <typename Tp, size_t Alignment>
+[[nodiscard]] constexpr Tp* AlignedAllocator<Tp, Alignment>::allocate(
+    size_t count) {
+    if consteval {
+        return std::allocator<Tp>{}.allocate(count);
+    }
+    return static_cast<Tp*>(
+        ::operator new(count * sizeof(Tp), std::align_val_t{Alignment}));
+}
+
+template <typename Tp, size_t Alignment>
+constexpr void AlignedAllocator<Tp, Alignment>::deallocate(
+    Tp* pointer, size_t count) noexcept {
+    if consteval {
+        std::allocator<Tp>{}.deallocate(pointer, count);
+        return;
+    }
+    ::operator delete(pointer, count * sizeof(Tp),
+                      std::align_val_t{Alignment});
+}
+
+}  // namespace details
+
+template <typename Token, typename ValueTp>
+template <std::ranges::input_range Range>
+    requires SpecializationOf<std::ranges::range_value_t<Range>, std::pair>
+constexpr TokenTable<Token, ValueTp>::TokenTable(Range&& range) {
+    for (const auto& [token, value] : range) {
+        Insert(token, value);
+    }
+}
+
+template <typename Token, typename ValueTp>
+constexpr void TokenTable<Token, ValueTp>::Insert(const Token& token,
+                                                  ValueTp value) {
+    if constexpr (kCanBeDense) {
+        if (sparse_values_.empty()) {
+            if (InsertDense(token, value)) {
+                return;
+            }
+            MoveToSparse();
+        }
+    }
+    if (auto iter = sparse_values_.Find(token); iter != sparse_values_.end()) {
+        iter->second = std::move(value);
+    } else {
+        sparse_values_.Emplace(token, std::move(value));
+    }
+}
+
+template <typename Token, typename ValueTp>
+[[nodiscard]] constexpr bool TokenTable<Token, ValueTp>::Contains(
+    const Token& token) const {
+    return Find(token) != nullptr;
+}
+
+template <typename Token, typename ValueTp>
+[[nodiscard]] constexpr auto&& TokenTable<Token, ValueTp>::At(
+    this auto&& self, const Token& token) {
+    auto* value = self.Find(token);
+    if (!value) [[unlikely]] {
+        throw std::runtime_error{"Element is not a part of the table!"};
+    }
+    return std::forward_like<decltype(self)>(*value);
+}
+
+template <typename Token, typename ValueTp>
+[[nodiscard]] constexpr auto* TokenTable<Token, ValueTp>::Find(
+    this auto&& self, const Token& token) {
+    using PointerTp = decltype(&self.sparse_values_.begin()->second);
+
+    if constexpr (kCanBeDense) {
+        if (self.sparse_values_.empty()) {
+            const size_t index = self.DenseIndex(token);
+            if (index < self.present_.size() && self.present_[index]) {
+                return PointerTp{&self.dense_values_[index]};
+            }
+            return PointerTp{nullptr};
+        }
+    }
+    if (auto iter = self.sparse_values_.Find(token);
+        iter != self.sparse_values_.end()) {
+        return PointerTp{&iter->second};
+    }
+    return PointerTp{nullptr};
+}
+
+template <typename Token, typename ValueTp>
+[[nodiscard]] constexpr auto&& TokenTable<Token, ValueTp>::operator[](
+    this auto&& self, const Token& token) {
+    assert(self.Contains(token));
+    if constexpr (kCanBeDense) {
+        if (self.sparse_values_.empty()) [[likely]] {
+            return std::forward_like<decltype(self)>(
+                self.dense_values_[self.DenseIndex(token)]);
+        }
+    }
+    return std::forward_like<decltype(self)>(
+        self.sparse_values_.Find(token)->second);
+}
+
+template <typename Token, typename ValueTp>
+[[nodiscard]] constexpr bool TokenTable<Token, ValueTp>::is_dense()
+    const noexcept {
+    if constexpr (kCanBeDense) {
+        return sparse_values_.empty();
+    } else {
+        return false;
+    }
+}
+
+template <typename Token, typename ValueTp>
+[[nodiscard]] constexpr size_t TokenTable<Token, ValueTp>::DenseIndex(
+    const Token& token) const noexcept
+    requires kCanBeDense
+{
+    return static_cast<UnsignedTp>(static_cast<UnsignedTp>(token) -
+                                   static_cast<UnsignedTp>(dense_offset_));
+}
+
+template <typename Token, typename ValueTp>
+[[nodiscard]] constexpr bool TokenTable<Token, ValueTp>::InsertDense(
+    const Token& token, ValueTp& value)
+    requires kCanBeDense
+{
+    if (present_.empty()) {
+        dense_offset_ = token;
+        dense_values_.resize(1);
+        present_.resize(1);
+    }
+    if (DenseIndex(token) >= present_.size()) {
+        const Token last = static_cast<Token>(
+            static_cast<UnsignedTp>(dense_offset_) + present_.size() - 1);
+        const Token first = std::min(token, dense_offset_);
+        const auto span = static_cast<UnsignedTp>(
+            static_cast<UnsignedTp>(std::max(token, last)) -
+            static_cast<UnsignedTp>(first));
+        if (span >= kMaxDenseSpan) {
+            return false;
+        }
+        // Prepends the slots of the tokens below the current offset
+        const size_t shift = static_cast<UnsignedTp>(
+            static_cast<UnsignedTp>(dense_offset_) -
+            static_cast<UnsignedTp>(first));
+        dense_values_.insert(dense_values_.begin(), shift, ValueTp{});
+        present_.insert(present_.begin(), shift, false);
+        dense_values_.resize(static_cast<size_t>(span) + 1);
+        present_.resize(static_cast<size_t>(span) + 1);
+        dense_offset_ = first;
+    }
+    dense_values_[DenseIndex(token)] = std::move(value);
+    present_[DenseIndex(token)] = true;
+    return true;
+}
+
+template <typename Token, typename ValueTp>
+constexpr void TokenTable<Token, ValueTp>::MoveToSparse()
+    requires kCanBeDense
+{
+    for (size_t index = 0; index < present_.size(); ++index) {
+        if (present_[index]) {
+            sparse_values_.Emplace(
+                static_cast<Token>(static_cast<UnsignedTp>(dense_offset_) +
+                                   index),
+                std::move(dense_values_[index]));
+        }
+    }
+    dense_values_ = DenseStorage{};
+    present_ = std::vector<bool>{};
+}
+
+}  // namespace koda
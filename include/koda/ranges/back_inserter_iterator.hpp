@@ -11,6 +11,7 @@ template <typename ContainterTp>
 struct BackInserterIterator : public std::back_insert_iterator<ContainterTp> {
     using difference_type = ptrdiff_t;
     using value_type = typename ContainterTp::value_type;
+    using unbounded = void;
 
     using std::back_insert_iterator<ContainterTp>::back_insert_iterator;
 
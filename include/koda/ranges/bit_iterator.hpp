@@ -29,6 +29,39 @@ template <class Range>
 concept BitOutputRange = std::ranges::output_range<Range, bool> &&
                          BitOutputIterator<std::ranges::iterator_t<Range>>;
 
+template <class Iter>
+concept BitWordInputIterator =
+    BitInputIterator<Iter> &&
+    requires(Iter iter, const Iter citer, uint8_t count) {
+        { citer.Peek(count) } -> std::same_as<uint64_t>;
+        iter.Consume(count);
+        { iter.ReadBits(count) } -> std::same_as<uint64_t>;
+        { citer.Available() } -> std::same_as<size_t>;
+        { Iter::MaxPeekLength() } -> std::same_as<size_t>;
+    };
+
+template <class Range>
+concept BitWordInputRange =
+    BitInputRange<Range> &&
+    BitWordInputIterator<std::ranges::iterator_t<Range>>;
+
+template <class Iter>
+concept BitWordOutputIterator =
+    BitOutputIterator<Iter> &&
+    requires(Iter iter, uint64_t value, uint8_t count) {
+        iter.WriteBits(value, count);
+    };
+
+template <class Range>
+concept BitWordOutputRange =
+    BitOutputRange<Range> &&
+    BitWordOutputIterator<std::ranges::iterator_t<Range>>;
+
+// Output iterators that can never be exhausted (like inserters) are marked
+// with the unbounded tag
+template <typename Iter>
+concept UnboundedOutputIterator = requires { typename Iter::unbounded; };
+
 template <typename Iter>
 concept BitIteratorUnderlyingInputIterator =
     std::input_iterator<Iter> && std::integral<std::iter_value_t<Iter>>;
@@ -176,6 +209,8 @@ class LittleEndianOutputBitIter : public BitIteratorBase<Iter> {
 
     constexpr LittleEndianOutputBitIter& operator=(bit value) noexcept;
 
+    constexpr void WriteBits(uint64_t value, uint8_t count) noexcept;
+
     [[nodiscard]] constexpr LittleEndianOutputBitIter& operator*(void) noexcept;
 
     constexpr LittleEndianOutputBitIter& operator++() noexcept;
@@ -267,6 +302,27 @@ class BigEndianOutputBitIter : public BitIteratorBase<Iter> {
     [[nodiscard]] constexpr size_t Position() const noexcept;
 };
 
+/// Writes the count least significant bits of the value to the output
+/// starting from the least significant one. Written bits are consumed from
+/// both the value and the count so the emission can be resumed once the
+/// output is exhausted. Multi-bit writes are performed in one step whenever
+/// the iterator supports them and the output is known to have a room for
+/// the whole sequence
+template <BitOutputIterator Iter, typename Sent>
+[[nodiscard]] constexpr Iter WriteBits(Iter iter, const Sent& sent,
+                                       uint64_t& value, uint8_t& count);
+
+/// Reads bits from the input until the received counter reaches the given
+/// length. Bits are stored in the value starting from the least significant
+/// one, the counter keeps the number of the already stored bits so the
+/// reading can be resumed once more input is available. Iterators that
+/// support multi-bit reads fetch the whole sequence in one step when enough
+/// bits are available
+template <BitInputIterator Iter, typename Sent>
+[[nodiscard]] constexpr Iter ReadBits(Iter iter, const Sent& sent,
+                                      uint64_t& value, uint8_t& received,
+                                      uint8_t length);
+
 namespace details {
 
 template <typename RangeTp, template <typename> class BitIteratorTp>
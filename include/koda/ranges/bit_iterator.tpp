@@ -1,5 +1,9 @@
 #pragma once
 
+#include <koda/utils/utils.hpp>
+
+#include <algorithm>
+
 namespace koda {
 
 template <BitIteratorUnderlyingInputOrOutputIterator Iter>
@@ -84,6 +88,25 @@ LittleEndianOutputBitIter<Iter>::operator=(bit value) noexcept {
     return *this;
 }
 
+template <BitIteratorUnderlyingOutputIterator Iter>
+constexpr void LittleEndianOutputBitIter<Iter>::WriteBits(
+    uint64_t value, uint8_t count) noexcept {
+    value &= LowBitsMask<uint64_t>(count);
+    while (count) {
+        const uint8_t taken = std::min<size_t>(
+            count, this->ByteLength() - this->bit_iter_);
+        // Bits that do not fit are cut off by the cast
+        this->current_value_ |= static_cast<typename BitIteratorBase<
+            Iter>::TemporaryTp>(value << this->bit_iter_);
+        value = taken == 64 ? 0 : value >> taken;
+        count -= taken;
+        if ((this->bit_iter_ += taken) == this->ByteLength()) {
+            *(this->iter_)++ = this->current_value_;
+            this->bit_iter_ = this->current_value_ = 0;
+        }
+    }
+}
+
 template <BitIteratorUnderlyingOutputIterator Iter>
 [[nodiscard]] constexpr LittleEndianOutputBitIter<Iter>&
 LittleEndianOutputBitIter<Iter>::operator*(void) noexcept {
@@ -199,6 +222,64 @@ template <BitIteratorUnderlyingOutputIterator Iter>
 
 namespace details {
 
+template <typename Iter, typename Sent>
+[[nodiscard]] constexpr bool HasRoomForBits(const Iter& iter, const Sent& sent,
+                                            size_t count) {
+    if constexpr (std::same_as<Sent, std::default_sentinel_t> &&
+                  requires {
+                      requires UnboundedOutputIterator<std::remove_cvref_t<
+                          decltype(std::declval<const Iter&>().Base())>>;
+                  }) {
+        return true;
+    } else if constexpr (requires {
+                             {
+                                 sent - iter
+                             } -> std::convertible_to<std::ptrdiff_t>;
+                         }) {
+        return static_cast<size_t>(sent - iter) >= count;
+    } else {
+        return false;
+    }
+}
+
+}  // namespace details
+
+template <BitOutputIterator Iter, typename Sent>
+[[nodiscard]] constexpr Iter WriteBits(Iter iter, const Sent& sent,
+                                       uint64_t& value, uint8_t& count) {
+    if constexpr (BitWordOutputIterator<Iter>) {
+        if (details::HasRoomForBits(iter, sent, count)) {
+            iter.WriteBits(value, count);
+            value = count = 0;
+            return iter;
+        }
+    }
+    for (; count && (iter != sent); --count, value >>= 1) {
+        *iter = static_cast<bool>(value & 1);
+        ++iter;
+    }
+    return iter;
+}
+
+template <BitInputIterator Iter, typename Sent>
+[[nodiscard]] constexpr Iter ReadBits(Iter iter, const Sent& sent,
+                                      uint64_t& value, uint8_t& received,
+                                      uint8_t length) {
+    if constexpr (BitWordInputIterator<Iter>) {
+        if (received != length && iter.Available() >= length - received) {
+            value |= iter.ReadBits(length - received) << received;
+            received = length;
+            return iter;
+        }
+    }
+    for (; (received != length) && (iter != sent); ++iter, ++received) {
+        value |= static_cast<uint64_t>(*iter) << received;
+    }
+    return iter;
+}
+
+namespace details {
+
 template <typename RangeTp, template <typename> class BitIteratorTp>
 [[nodiscard]] constexpr BitIteratorTp<
     typename BitView<RangeTp, BitIteratorTp>::iterator_type>
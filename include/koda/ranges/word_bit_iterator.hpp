@@ -0,0 +1,387 @@
+#pragma once
+
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/utils/concepts.hpp>
+
+#include <cinttypes>
+#include <climits>
+#include <iterator>
+#include <ranges>
+
+namespace koda {
+
+/// Little endian output bit iterator that gathers bits in a 64-bit
+/// accumulator and stores them into the underlying range one word at a time.
+/// The produced byte stream is identical to the one produced by the
+/// LittleEndianOutputBitIter. When the underlying iterator is contiguous the
+/// whole word is stored with a single copy
+template <BitIteratorUnderlyingOutputIterator Iter>
+class LittleEndianWordOutputBitIter {
+   public:
+    using bit = bool;
+    using value_type = bit;
+    using difference_type = std::ptrdiff_t;
+    using WordTp = uint64_t;
+
+    explicit constexpr LittleEndianWordOutputBitIter(Iter iterator) noexcept(
+        std::is_nothrow_move_constructible_v<Iter>);
+
+    explicit constexpr LittleEndianWordOutputBitIter() noexcept(
+        std::is_nothrow_move_constructible_v<Iter>)
+        requires std::constructible_from<Iter>
+    = default;
+
+    [[nodiscard]] friend constexpr bool operator==(
+        LittleEndianWordOutputBitIter const& left,
+        LittleEndianWordOutputBitIter const& right) noexcept {
+        if constexpr (std::random_access_iterator<Iter>) {
+            return (left - right) == 0;
+        } else {
+            return (left.iter_ == right.iter_) &&
+                   (left.bit_iter_ == right.bit_iter_);
+        }
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(
+        LittleEndianWordOutputBitIter const& left,
+        std::default_sentinel_t sentinel) noexcept
+        requires(WeaklyEqualityComparable<Iter, std::default_sentinel_t>)
+    {
+        return left.iter_ == sentinel;
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(
+        std::default_sentinel_t sentinel,
+        LittleEndianWordOutputBitIter const& right) noexcept
+        requires(WeaklyEqualityComparable<std::default_sentinel_t, Iter>)
+    {
+        return sentinel == right.iter_;
+    }
+
+    /// Returns the distance between iterators in bits
+    [[nodiscard]] friend constexpr difference_type operator-(
+        LittleEndianWordOutputBitIter const& left,
+        LittleEndianWordOutputBitIter const& right) noexcept
+        requires std::random_access_iterator<Iter>
+    {
+        return (left.iter_ - right.iter_) *
+                   static_cast<difference_type>(ByteLength()) +
+               left.bit_iter_ - right.bit_iter_;
+    }
+
+    constexpr LittleEndianWordOutputBitIter& operator=(bit value) noexcept;
+
+    constexpr void WriteBits(WordTp value, uint8_t count) noexcept;
+
+    [[nodiscard]] constexpr LittleEndianWordOutputBitIter& operator*() noexcept;
+
+    constexpr LittleEndianWordOutputBitIter& operator++() noexcept;
+
+    [[nodiscard]] constexpr LittleEndianWordOutputBitIter& operator++(
+        int) noexcept;
+
+    constexpr void Flush() noexcept;
+
+    [[nodiscard]] constexpr size_t Position() const noexcept;
+
+    [[nodiscard]] static inline consteval size_t ByteLength() noexcept;
+
+    [[nodiscard]] constexpr auto Rebind(this auto&& self, Iter other);
+
+    [[nodiscard]] constexpr auto&& Base(this auto&& self);
+
+   private:
+    using TemporaryTp = std::iter_value_t<Iter>;
+
+    static constexpr size_t kWordLength = sizeof(WordTp) * CHAR_BIT;
+    static constexpr size_t kElementsPerWord =
+        sizeof(WordTp) / sizeof(TemporaryTp);
+
+    static_assert(kWordLength % (sizeof(TemporaryTp) * CHAR_BIT) == 0,
+                  "Underlying elements have to evenly divide the word");
+
+    Iter iter_ = {};
+    WordTp word_ = 0;
+    uint8_t bit_iter_ = 0;
+
+    constexpr void StoreWord() noexcept;
+
+    constexpr void StoreElements(size_t count) noexcept;
+};
+
+/// Little endian input bit iterator backed by a 64-bit register that is
+/// refilled from the underlying range (a whole word at a time for contiguous
+/// byte ranges). Besides the regular bit by bit interface it allows to peek
+/// and consume up to MaxPeekLength bits in one step. The iterator holds the
+/// end of the underlying range so the refills never cross it, therefore it
+/// is compared against the default sentinel
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+class LittleEndianWordInputBitIter {
+   public:
+    using bit = bool;
+    using value_type = bit;
+    using difference_type = std::ptrdiff_t;
+    using WordTp = uint64_t;
+
+    explicit constexpr LittleEndianWordInputBitIter(
+        Iter iterator, Iter sentinel,
+        size_t position =
+            0) noexcept(std::is_nothrow_move_constructible_v<Iter>);
+
+    explicit constexpr LittleEndianWordInputBitIter() noexcept(
+        std::is_nothrow_move_constructible_v<Iter>)
+        requires std::constructible_from<Iter>
+    = default;
+
+    [[nodiscard]] friend constexpr bool operator==(
+        LittleEndianWordInputBitIter const& left,
+        LittleEndianWordInputBitIter const& right) noexcept {
+        return (left.iter_ - right.iter_) *
+                   static_cast<difference_type>(ByteLength()) ==
+               static_cast<difference_type>(left.bit_count_) -
+                   static_cast<difference_type>(right.bit_count_);
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(
+        LittleEndianWordInputBitIter const& left,
+        [[maybe_unused]] std::default_sentinel_t sentinel) noexcept {
+        return !left.bit_count_ && (left.iter_ == left.end_);
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(
+        [[maybe_unused]] std::default_sentinel_t sentinel,
+        LittleEndianWordInputBitIter const& right) noexcept {
+        return !right.bit_count_ && (right.iter_ == right.end_);
+    }
+
+    [[nodiscard]] constexpr bit operator*() const noexcept;
+
+    constexpr LittleEndianWordInputBitIter& operator++() noexcept;
+
+    [[nodiscard]] constexpr LittleEndianWordInputBitIter operator++(
+        int) noexcept;
+
+    /// Returns the next count bits without consuming them, the first one
+    /// is the least significant. Bits past the end are equal to zero
+    [[nodiscard]] constexpr WordTp Peek(uint8_t count) const noexcept;
+
+    constexpr void Consume(uint8_t count) noexcept;
+
+    [[nodiscard]] constexpr WordTp ReadBits(uint8_t count) noexcept;
+
+    [[nodiscard]] constexpr size_t Available() const noexcept;
+
+    [[nodiscard]] constexpr size_t Position() const noexcept;
+
+    /// Returns the iterator pointing to the element holding the next bit
+    [[nodiscard]] constexpr Iter Base() const;
+
+    [[nodiscard]] static inline consteval size_t ByteLength() noexcept;
+
+    [[nodiscard]] static inline consteval size_t MaxPeekLength() noexcept;
+
+   private:
+    using TemporaryTp = std::iter_value_t<Iter>;
+
+    static constexpr size_t kWordLength = sizeof(WordTp) * CHAR_BIT;
+
+    static_assert(sizeof(TemporaryTp) * CHAR_BIT * 2 <= kWordLength,
+                  "Underlying elements have to fit twice in the word");
+
+    mutable Iter iter_ = {};
+    Iter end_ = {};
+    mutable WordTp buffer_ = 0;
+    mutable uint8_t bit_count_ = 0;
+
+    constexpr void Refill() const noexcept;
+};
+
+/// Input bit iterator reading the little endian bit stream backwards, from
+/// its last bit towards the first one (the order in which the ANS family
+/// decoders consume the stream). Each refill loads the preceding elements
+/// and reverses their bits so the next bit is always the least significant
+/// one of the register and the Peek/Consume interface matches the
+/// LittleEndianWordInputBitIter. The padding is the number of unused most
+/// significant bits of the last element
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+class BackwardWordInputBitIter {
+   public:
+    using bit = bool;
+    using value_type = bit;
+    using difference_type = std::ptrdiff_t;
+    using WordTp = uint64_t;
+
+    explicit constexpr BackwardWordInputBitIter(
+        Iter begin, Iter end,
+        size_t padding =
+            0) noexcept(std::is_nothrow_move_constructible_v<Iter>);
+
+    explicit constexpr BackwardWordInputBitIter() noexcept(
+        std::is_nothrow_move_constructible_v<Iter>)
+        requires std::constructible_from<Iter>
+    = default;
+
+    [[nodiscard]] friend constexpr bool operator==(
+        BackwardWordInputBitIter const& left,
+        BackwardWordInputBitIter const& right) noexcept {
+        return (right.iter_ - left.iter_) *
+                   static_cast<difference_type>(ByteLength()) ==
+               static_cast<difference_type>(left.bit_count_) -
+                   static_cast<difference_type>(right.bit_count_);
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(
+        BackwardWordInputBitIter const& left,
+        [[maybe_unused]] std::default_sentinel_t sentinel) noexcept {
+        return !left.bit_count_ && (left.iter_ == left.begin_);
+    }
+
+    [[nodiscard]] friend constexpr bool operator==(
+        [[maybe_unused]] std::default_sentinel_t sentinel,
+        BackwardWordInputBitIter const& right) noexcept {
+        return !right.bit_count_ && (right.iter_ == right.begin_);
+    }
+
+    [[nodiscard]] constexpr bit operator*() const noexcept;
+
+    constexpr BackwardWordInputBitIter& operator++() noexcept;
+
+    [[nodiscard]] constexpr BackwardWordInputBitIter operator++(int) noexcept;
+
+    /// Returns the next count bits without consuming them, the first one
+    /// is the least significant. Bits past the beginning are equal to zero
+    [[nodiscard]] constexpr WordTp Peek(uint8_t count) const noexcept;
+
+    constexpr void Consume(uint8_t count) noexcept;
+
+    [[nodiscard]] constexpr WordTp ReadBits(uint8_t count) noexcept;
+
+    [[nodiscard]] constexpr size_t Available() const noexcept;
+
+    [[nodiscard]] static inline consteval size_t ByteLength() noexcept;
+
+    [[nodiscard]] static inline consteval size_t MaxPeekLength() noexcept;
+
+   private:
+    using TemporaryTp = std::iter_value_t<Iter>;
+    using UnsignedTp = std::make_unsigned_t<TemporaryTp>;
+
+    static constexpr size_t kWordLength = sizeof(WordTp) * CHAR_BIT;
+
+    static_assert(sizeof(TemporaryTp) * CHAR_BIT * 2 <= kWordLength,
+                  "Underlying elements have to fit twice in the word");
+
+    Iter begin_ = {};
+    // Points past the next element to be loaded
+    mutable Iter iter_ = {};
+    mutable WordTp buffer_ = 0;
+    mutable uint8_t bit_count_ = 0;
+
+    constexpr void Refill() const noexcept;
+};
+
+namespace ranges {
+
+template <std::ranges::view RangeTp>
+    requires(std::ranges::random_access_range<RangeTp> &&
+             std::ranges::common_range<RangeTp>)
+class LittleEndianWordInputView
+    : public std::ranges::view_interface<LittleEndianWordInputView<RangeTp>> {
+   public:
+    using iterator_type = std::ranges::iterator_t<RangeTp>;
+
+    template <std::ranges::viewable_range RangeFwdTp>
+    constexpr LittleEndianWordInputView(RangeFwdTp&& range)
+        : range_{std::forward<RangeFwdTp>(range)} {}
+
+    [[nodiscard]] constexpr LittleEndianWordInputBitIter<iterator_type> begin()
+        const;
+
+    [[nodiscard]] static consteval std::default_sentinel_t end() noexcept;
+
+   private:
+    RangeTp range_;
+};
+
+template <std::ranges::viewable_range Range>
+LittleEndianWordInputView(Range&& range)
+    -> LittleEndianWordInputView<std::ranges::views::all_t<Range>>;
+
+template <std::ranges::view RangeTp>
+    requires(std::ranges::random_access_range<RangeTp> &&
+             std::ranges::common_range<RangeTp>)
+class BackwardWordInputView
+    : public std::ranges::view_interface<BackwardWordInputView<RangeTp>> {
+   public:
+    using iterator_type = std::ranges::iterator_t<RangeTp>;
+
+    template <std::ranges::viewable_range RangeFwdTp>
+    constexpr BackwardWordInputView(RangeFwdTp&& range, size_t padding = 0)
+        : range_{std::forward<RangeFwdTp>(range)}, padding_{padding} {}
+
+    [[nodiscard]] constexpr BackwardWordInputBitIter<iterator_type> begin()
+        const;
+
+    [[nodiscard]] static consteval std::default_sentinel_t end() noexcept;
+
+   private:
+    RangeTp range_;
+    size_t padding_;
+};
+
+template <std::ranges::viewable_range Range>
+BackwardWordInputView(Range&& range)
+    -> BackwardWordInputView<std::ranges::views::all_t<Range>>;
+
+template <std::ranges::viewable_range Range>
+BackwardWordInputView(Range&& range, size_t padding)
+    -> BackwardWordInputView<std::ranges::views::all_t<Range>>;
+
+template <typename RangeTp>
+using LittleEndianWordOutputView =
+    details::BitView<RangeTp, LittleEndianWordOutputBitIter>;
+
+}  // namespace ranges
+
+namespace views {
+
+struct LittleEndianWordInputAdaptorClosure
+    : public std::ranges::range_adaptor_closure<
+          LittleEndianWordInputAdaptorClosure> {
+    template <std::ranges::viewable_range Range>
+    [[nodiscard]] constexpr auto operator()(Range&& range) const;
+};
+
+inline constexpr LittleEndianWordInputAdaptorClosure LittleEndianWordInput{};
+
+struct BackwardWordInputAdaptorClosure
+    : public std::ranges::range_adaptor_closure<
+          BackwardWordInputAdaptorClosure> {
+    template <std::ranges::viewable_range Range>
+    [[nodiscard]] constexpr auto operator()(Range&& range) const;
+};
+
+inline constexpr BackwardWordInputAdaptorClosure BackwardWordInput{};
+
+using LittleEndianWordOutputAdaptorClosure =
+    details::BitViewAdaptorClosure<ranges::LittleEndianWordOutputView>;
+
+inline constexpr LittleEndianWordOutputAdaptorClosure LittleEndianWordOutput{};
+
+}  // namespace views
+
+/// Bit ranges over contiguous elements that can be transparently read
+/// through the LittleEndianWordInputBitIter
+template <typename Range>
+concept WordReadableBitRange =
+    BitInputRange<Range> && std::ranges::common_range<Range> &&
+    SpecializationOf<std::ranges::iterator_t<Range>,
+                     LittleEndianInputBitIter> &&
+    std::contiguous_iterator<std::remove_cvref_t<
+        decltype(std::declval<std::ranges::iterator_t<Range>>().Base())>>;
+
+}  // namespace koda
+
+#include <koda/ranges/word_bit_iterator.tpp>
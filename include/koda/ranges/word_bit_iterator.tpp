@@ -0,0 +1,443 @@
+#pragma once
+
+#include <koda/utils/utils.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstring>
+#include <memory>
+
+namespace koda {
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+constexpr LittleEndianWordOutputBitIter<Iter>::LittleEndianWordOutputBitIter(
+    Iter iterator) noexcept(std::is_nothrow_move_constructible_v<Iter>)
+    : iter_{std::move(iterator)} {}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+constexpr LittleEndianWordOutputBitIter<Iter>&
+LittleEndianWordOutputBitIter<Iter>::operator=(bit value) noexcept {
+    word_ |= static_cast<WordTp>(value ? 1 : 0) << bit_iter_;
+    if (++bit_iter_ == kWordLength) {
+        StoreWord();
+        word_ = bit_iter_ = 0;
+    }
+    return *this;
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+constexpr void LittleEndianWordOutputBitIter<Iter>::WriteBits(
+    WordTp value, uint8_t count) noexcept {
+    assert(count <= kWordLength);
+    value &= LowBitsMask<WordTp>(count);
+    word_ |= value << bit_iter_;
+    const size_t length = bit_iter_ + count;
+    if (length < kWordLength) {
+        bit_iter_ = length;
+        return;
+    }
+    StoreWord();
+    bit_iter_ = length - kWordLength;
+    // Carry the bits that did not fit into the stored word
+    word_ = bit_iter_ ? value >> (count - bit_iter_) : 0;
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+[[nodiscard]] constexpr LittleEndianWordOutputBitIter<Iter>&
+LittleEndianWordOutputBitIter<Iter>::operator*() noexcept {
+    return *this;
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+constexpr LittleEndianWordOutputBitIter<Iter>&
+LittleEndianWordOutputBitIter<Iter>::operator++() noexcept {
+    return *this;
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+[[nodiscard]] constexpr LittleEndianWordOutputBitIter<Iter>&
+LittleEndianWordOutputBitIter<Iter>::operator++(int) noexcept {
+    return *this;
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+constexpr void LittleEndianWordOutputBitIter<Iter>::Flush() noexcept {
+    StoreElements((bit_iter_ + ByteLength() - 1) / ByteLength());
+    word_ = bit_iter_ = 0;
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+[[nodiscard]] constexpr size_t LittleEndianWordOutputBitIter<Iter>::Position()
+    const noexcept {
+    return bit_iter_ % ByteLength();
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+[[nodiscard]] /*static*/ inline consteval size_t
+LittleEndianWordOutputBitIter<Iter>::ByteLength() noexcept {
+    return sizeof(TemporaryTp) * CHAR_BIT;
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+[[nodiscard]] constexpr auto LittleEndianWordOutputBitIter<Iter>::Rebind(
+    this auto&& self, Iter other) {
+    auto copy = self;
+    copy.iter_ = other;
+    return copy;
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+[[nodiscard]] constexpr auto&& LittleEndianWordOutputBitIter<Iter>::Base(
+    this auto&& self) {
+    return std::forward_like<decltype(self)>(self.iter_);
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+constexpr void LittleEndianWordOutputBitIter<Iter>::StoreWord() noexcept {
+    if constexpr (std::contiguous_iterator<Iter> && sizeof(TemporaryTp) == 1) {
+        if !consteval {
+            const WordTp word = std::endian::native == std::endian::little
+                                    ? word_
+                                    : std::byteswap(word_);
+            std::memcpy(std::to_address(iter_), &word, sizeof(WordTp));
+            iter_ += kElementsPerWord;
+            return;
+        }
+    }
+    StoreElements(kElementsPerWord);
+}
+
+template <BitIteratorUnderlyingOutputIterator Iter>
+constexpr void LittleEndianWordOutputBitIter<Iter>::StoreElements(
+    size_t count) noexcept {
+    for (size_t i = 0; i < count; ++i) {
+        *iter_++ = static_cast<TemporaryTp>(word_ >> (i * ByteLength()));
+    }
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+constexpr LittleEndianWordInputBitIter<Iter>::LittleEndianWordInputBitIter(
+    Iter iterator, Iter sentinel,
+    size_t position) noexcept(std::is_nothrow_move_constructible_v<Iter>)
+    : iter_{std::move(iterator)}, end_{std::move(sentinel)} {
+    if (position) {
+        assert(position < ByteLength());
+        buffer_ = static_cast<std::make_unsigned_t<TemporaryTp>>(*iter_++) >>
+                  position;
+        bit_count_ = ByteLength() - position;
+    }
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr LittleEndianWordInputBitIter<Iter>::bit
+LittleEndianWordInputBitIter<Iter>::operator*() const noexcept {
+    return Peek(1);
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+constexpr LittleEndianWordInputBitIter<Iter>&
+LittleEndianWordInputBitIter<Iter>::operator++() noexcept {
+    Consume(1);
+    return *this;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr LittleEndianWordInputBitIter<Iter>
+LittleEndianWordInputBitIter<Iter>::operator++(int) noexcept {
+    auto temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr LittleEndianWordInputBitIter<Iter>::WordTp
+LittleEndianWordInputBitIter<Iter>::Peek(uint8_t count) const noexcept {
+    assert(count <= MaxPeekLength());
+    if (bit_count_ < count) {
+        Refill();
+    }
+    return buffer_ & LowBitsMask<WordTp>(std::min<size_t>(count, bit_count_));
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+constexpr void LittleEndianWordInputBitIter<Iter>::Consume(
+    uint8_t count) noexcept {
+    assert(count <= MaxPeekLength());
+    if (bit_count_ < count) {
+        Refill();
+    }
+    assert(count <= bit_count_);
+    buffer_ >>= count;
+    bit_count_ -= count;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr LittleEndianWordInputBitIter<Iter>::WordTp
+LittleEndianWordInputBitIter<Iter>::ReadBits(uint8_t count) noexcept {
+    assert(count <= kWordLength);
+    if (count > MaxPeekLength()) {
+        const WordTp low = ReadBits(MaxPeekLength());
+        return low | (ReadBits(count - MaxPeekLength()) << MaxPeekLength());
+    }
+    const WordTp value = Peek(count);
+    Consume(count);
+    return value;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr size_t LittleEndianWordInputBitIter<Iter>::Available()
+    const noexcept {
+    return bit_count_ + static_cast<size_t>(end_ - iter_) * ByteLength();
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr size_t LittleEndianWordInputBitIter<Iter>::Position()
+    const noexcept {
+    return (ByteLength() - bit_count_ % ByteLength()) % ByteLength();
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr Iter LittleEndianWordInputBitIter<Iter>::Base() const {
+    return iter_ - static_cast<difference_type>(
+                       (bit_count_ + ByteLength() - 1) / ByteLength());
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] /*static*/ inline consteval size_t
+LittleEndianWordInputBitIter<Iter>::ByteLength() noexcept {
+    return sizeof(TemporaryTp) * CHAR_BIT;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] /*static*/ inline consteval size_t
+LittleEndianWordInputBitIter<Iter>::MaxPeekLength() noexcept {
+    return kWordLength - ByteLength();
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+constexpr void LittleEndianWordInputBitIter<Iter>::Refill() const noexcept {
+    if constexpr (std::contiguous_iterator<Iter> && sizeof(TemporaryTp) == 1) {
+        if !consteval {
+            if (end_ - iter_ >= static_cast<difference_type>(sizeof(WordTp))) {
+                WordTp word;
+                std::memcpy(&word, std::to_address(iter_), sizeof(WordTp));
+                if constexpr (std::endian::native == std::endian::big) {
+                    word = std::byteswap(word);
+                }
+                // Only whole bytes that fit are accounted, the remaining bits
+                // of the next byte are loaded again by the following refill
+                buffer_ |= word << bit_count_;
+                iter_ += (kWordLength - 1 - bit_count_) / CHAR_BIT;
+                bit_count_ |= kWordLength - CHAR_BIT;
+                return;
+            }
+        }
+    }
+    for (; (bit_count_ <= kWordLength - ByteLength()) && (iter_ != end_);
+         ++iter_) {
+        buffer_ |= static_cast<WordTp>(
+                       static_cast<std::make_unsigned_t<TemporaryTp>>(*iter_))
+                   << bit_count_;
+        bit_count_ += ByteLength();
+    }
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+constexpr BackwardWordInputBitIter<Iter>::BackwardWordInputBitIter(
+    Iter begin, Iter end,
+    size_t padding) noexcept(std::is_nothrow_move_constructible_v<Iter>)
+    : begin_{std::move(begin)}, iter_{std::move(end)} {
+    if (padding && (iter_ != begin_)) {
+        assert(padding < ByteLength());
+        buffer_ =
+            ReverseBits(static_cast<UnsignedTp>(*--iter_), ByteLength()) >>
+            padding;
+        bit_count_ = ByteLength() - padding;
+    }
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr BackwardWordInputBitIter<Iter>::bit
+BackwardWordInputBitIter<Iter>::operator*() const noexcept {
+    return Peek(1);
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+constexpr BackwardWordInputBitIter<Iter>&
+BackwardWordInputBitIter<Iter>::operator++() noexcept {
+    Consume(1);
+    return *this;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr BackwardWordInputBitIter<Iter>
+BackwardWordInputBitIter<Iter>::operator++(int) noexcept {
+    auto temp = *this;
+    ++(*this);
+    return temp;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr BackwardWordInputBitIter<Iter>::WordTp
+BackwardWordInputBitIter<Iter>::Peek(uint8_t count) const noexcept {
+    assert(count <= MaxPeekLength());
+    if (bit_count_ < count) {
+        Refill();
+    }
+    return buffer_ & LowBitsMask<WordTp>(std::min<size_t>(count, bit_count_));
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+constexpr void BackwardWordInputBitIter<Iter>::Consume(
+    uint8_t count) noexcept {
+    assert(count <= MaxPeekLength());
+    if (bit_count_ < count) {
+        Refill();
+    }
+    assert(count <= bit_count_);
+    buffer_ >>= count;
+    bit_count_ -= count;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr BackwardWordInputBitIter<Iter>::WordTp
+BackwardWordInputBitIter<Iter>::ReadBits(uint8_t count) noexcept {
+    assert(count <= kWordLength);
+    if (count > MaxPeekLength()) {
+        const WordTp low = ReadBits(MaxPeekLength());
+        return low | (ReadBits(count - MaxPeekLength()) << MaxPeekLength());
+    }
+    const WordTp value = Peek(count);
+    Consume(count);
+    return value;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] constexpr size_t BackwardWordInputBitIter<Iter>::Available()
+    const noexcept {
+    return bit_count_ + static_cast<size_t>(iter_ - begin_) * ByteLength();
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] /*static*/ inline consteval size_t
+BackwardWordInputBitIter<Iter>::ByteLength() noexcept {
+    return sizeof(TemporaryTp) * CHAR_BIT;
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+[[nodiscard]] /*static*/ inline consteval size_t
+BackwardWordInputBitIter<Iter>::MaxPeekLength() noexcept {
+    return kWordLength - ByteLength();
+}
+
+template <BitIteratorUnderlyingInputIterator Iter>
+    requires std::random_access_iterator<Iter>
+constexpr void BackwardWordInputBitIter<Iter>::Refill() const noexcept {
+    if constexpr (std::contiguous_iterator<Iter> && sizeof(TemporaryTp) == 1) {
+        if !consteval {
+            if (iter_ - begin_ >=
+                static_cast<difference_type>(sizeof(WordTp))) {
+                WordTp word;
+                std::memcpy(&word, std::to_address(iter_) - sizeof(WordTp),
+                            sizeof(WordTp));
+                if constexpr (std::endian::native == std::endian::big) {
+                    word = std::byteswap(word);
+                }
+                // The last loaded bit has to become the least significant one
+                buffer_ |= ReverseBits(word, kWordLength) << bit_count_;
+                iter_ -= (kWordLength - 1 - bit_count_) / CHAR_BIT;
+                bit_count_ |= kWordLength - CHAR_BIT;
+                return;
+            }
+        }
+    }
+    for (; (bit_count_ <= kWordLength - ByteLength()) && (iter_ != begin_);
+         bit_count_ += ByteLength()) {
+        buffer_ |= static_cast<WordTp>(ReverseBits(
+                       static_cast<UnsignedTp>(*--iter_), ByteLength()))
+                   << bit_count_;
+    }
+}
+
+namespace ranges {
+
+template <std::ranges::view RangeTp>
+    requires(std::ranges::random_access_range<RangeTp> &&
+             std::ranges::common_range<RangeTp>)
+[[nodiscard]] constexpr LittleEndianWordInputBitIter<
+    typename LittleEndianWordInputView<RangeTp>::iterator_type>
+LittleEndianWordInputView<RangeTp>::begin() const {
+    return LittleEndianWordInputBitIter<iterator_type>{
+        std::ranges::begin(range_), std::ranges::end(range_)};
+}
+
+template <std::ranges::view RangeTp>
+    requires(std::ranges::random_access_range<RangeTp> &&
+             std::ranges::common_range<RangeTp>)
+[[nodiscard]] /*static*/ consteval std::default_sentinel_t
+LittleEndianWordInputView<RangeTp>::end() noexcept {
+    return std::default_sentinel;
+}
+
+template <std::ranges::view RangeTp>
+    requires(std::ranges::random_access_range<RangeTp> &&
+             std::ranges::common_range<RangeTp>)
+[[nodiscard]] constexpr BackwardWordInputBitIter<
+    typename BackwardWordInputView<RangeTp>::iterator_type>
+BackwardWordInputView<RangeTp>::begin() const {
+    return BackwardWordInputBitIter<iterator_type>{
+        std::ranges::begin(range_), std::ranges::end(range_), padding_};
+}
+
+template <std::ranges::view RangeTp>
+    requires(std::ranges::random_access_range<RangeTp> &&
+             std::ranges::common_range<RangeTp>)
+[[nodiscard]] /*static*/ consteval std::default_sentinel_t
+BackwardWordInputView<RangeTp>::end() noexcept {
+    return std::default_sentinel;
+}
+
+}  // namespace ranges
+
+namespace views {
+
+template <std::ranges::viewable_range Range>
+[[nodiscard]] constexpr auto LittleEndianWordInputAdaptorClosure::operator()(
+    Range&& range) const {
+    return ranges::LittleEndianWordInputView{std::forward<Range>(range)};
+}
+
+
+template <std::ranges::viewable_range Range>
+[[nodiscard]] constexpr auto BackwardWordInputAdaptorClosure::operator()(
+    Range&& range) const {
+    return ranges::BackwardWordInputView{std::forward<Range>(range)};
+}
+
+}  // namespace views
+
+}  // namespace koda
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <concepts>
+#include <cstdlib>
+
+namespace koda {
+
+/// Invokes the task with every index below the count on the given number of
+/// threads (the calling one included). Indices are taken in the increasing
+/// order, so the task can wait for the lower ones. The first exception stops
+/// the remaining indices from being taken and is rethrown after all of the
+/// threads are joined
+void ParallelFor(size_t count, size_t thread_count,
+                 std::invocable<size_t> auto&& task);
+
+}  // namespace koda
+
+#include <koda/utils/parallel.ipp>
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace koda {
+
+void ParallelFor(size_t count, size_t thread_count,
+                 std::invocable<size_t> auto&& task) {
+    const size_t worker_count = std::min(std::max<size_t>(thread_count, 1),
+                                         std::max<size_t>(count, 1));
+    std::atomic<size_t> next_index = 0;
+    std::vector<std::exception_ptr> errors(worker_count);
+
+    auto worker = [&](size_t worker_index) {
+        try {
+            for (size_t index = next_index++; index < count;
+                 index = next_index++) {
+                task(index);
+            }
+        } catch (...) {
+            errors[worker_index] = std::current_exception();
+            next_index = count;
+        }
+    };
+
+    {
+        std::vector<std::jthread> workers;
+        workers.reserve(worker_count - 1);
+        for (size_t i = 1; i < worker_count; ++i) {
+            workers.emplace_back(worker, i);
+        }
+        worker(0);
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace koda
@@ -50,6 +50,19 @@ template <std::integral Tp>
 template <std::integral Tp>
 [[nodiscard]] constexpr Tp IntCeilLog2(Tp value) noexcept;
 
+template <std::unsigned_integral Tp>
+[[nodiscard]] constexpr Tp LowBitsMask(size_t count) noexcept;
+
+template <std::unsigned_integral Tp>
+[[nodiscard]] constexpr Tp ReverseBits(Tp value, size_t count) noexcept;
+
+/// Byte sequences are compared by whole 64-bit words outside of the constant
+/// evaluation, the first mismatch is located by the zero count of their xor
+template <typename Tp>
+[[nodiscard]] constexpr size_t CommonPrefixLength(const Tp* left,
+                                                  const Tp* right,
+                                                  size_t length) noexcept;
+
 }  // namespace koda
 
 #include <koda/utils/utils.tpp>
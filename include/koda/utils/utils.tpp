@@ -2,7 +2,9 @@
 
 #include <algorithm>
 #include <bit>
+#include <cassert>
 #include <climits>
+#include <cstdint>
 #include <cstring>
 #include <memory>
 
@@ -81,4 +83,61 @@ template <std::integral Tp>
     return IntFloorLog2(value) + (IsPowerOf2(value) ? 0 : 1);
 }
 
+template <std::unsigned_integral Tp>
+[[nodiscard]] constexpr Tp LowBitsMask(size_t count) noexcept {
+    assert(count <= sizeof(Tp) * CHAR_BIT);
+    // Shifting by the type's width is undefined
+    return count == sizeof(Tp) * CHAR_BIT
+               ? static_cast<Tp>(~Tp{0})
+               : static_cast<Tp>((Tp{1} << count) - 1);
+}
+
+template <std::unsigned_integral Tp>
+[[nodiscard]] constexpr Tp ReverseBits(Tp value, size_t count) noexcept {
+    static_assert(sizeof(Tp) <= sizeof(uint64_t));
+    assert(count <= sizeof(Tp) * CHAR_BIT);
+    if (!count) {
+        return 0;
+    }
+    // Swaps adjacent bits, pairs and nibbles, bytes are swapped at the end
+    uint64_t word = value;
+    word = ((word >> 1) & 0x5555'5555'5555'5555) |
+           ((word & 0x5555'5555'5555'5555) << 1);
+    word = ((word >> 2) & 0x3333'3333'3333'3333) |
+           ((word & 0x3333'3333'3333'3333) << 2);
+    word = ((word >> 4) & 0x0F0F'0F0F'0F0F'0F0F) |
+           ((word & 0x0F0F'0F0F'0F0F'0F0F) << 4);
+    return static_cast<Tp>(std::byteswap(word) >> (64 - count));
+}
+
+template <typename Tp>
+[[nodiscard]] constexpr size_t CommonPrefixLength(const Tp* left,
+                                                  const Tp* right,
+                                                  size_t length) noexcept {
+    size_t index = 0;
+    if constexpr (sizeof(Tp) == 1 &&
+                  std::has_unique_object_representations_v<Tp>) {
+        if !consteval {
+            for (; index + sizeof(uint64_t) <= length;
+                 index += sizeof(uint64_t)) {
+                uint64_t left_word, right_word;
+                std::memcpy(&left_word, left + index, sizeof(uint64_t));
+                std::memcpy(&right_word, right + index, sizeof(uint64_t));
+                if (const uint64_t difference = left_word ^ right_word) {
+                    const int bit = std::endian::native == std::endian::little
+                                        ? std::countr_zero(difference)
+                                        : std::countl_zero(difference);
+                    return index + bit / CHAR_BIT;
+                }
+            }
+        }
+    }
+    for (; index < length; ++index) {
+        if (left[index] != right[index]) {
+            return index;
+        }
+    }
+    return length;
+}
+
 }  // namespace koda
@@ -0,0 +1,71 @@
+#include <koda/coders/coder.hpp>
+#include <koda/coders/golomb/elias_delta_decoder.hpp>
+#include <koda/coders/golomb/elias_delta_encoder.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/ranges/word_bit_iterator.hpp>
+#include <koda/tests/tests.hpp>
+
+#include <iterator>
+#include <vector>
+
+static_assert(koda::Decoder<koda::EliasDeltaDecoder<uint16_t>, uint16_t>);
+
+BeginConstexprTest(EliasDeltaDecoderTest, DecodeBits) {
+    const std::vector<uint16_t> kInput{{0, 1, 4, 16, 0xFFFF, 300}};
+    std::vector<bool> stream;
+    std::vector<uint16_t> result;
+
+    koda::EliasDeltaEncoder<uint16_t> encoder;
+
+    encoder(kInput, stream | koda::views::InsertFromBack);
+
+    koda::EliasDeltaDecoder<uint16_t> decoder;
+
+    decoder(stream, result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kInput, result);
+}
+EndConstexprTest;
+
+BeginConstexprTest(EliasDeltaDecoderTest, DecodeBufferedWords) {
+    const std::vector<uint32_t> kInput{
+        {0, 1, 17, 4096, 0xFFFF'FFFF, 3, 0x8000'0000, 42}};
+    std::vector<uint8_t> stream;
+    std::vector<uint32_t> result;
+
+    koda::EliasDeltaEncoder<uint32_t> encoder;
+
+    encoder(kInput, stream | koda::views::InsertFromBack |
+                        koda::views::LittleEndianOutput);
+
+    koda::EliasDeltaDecoder<uint32_t> decoder;
+
+    decoder.DecodeN(kInput.size(),
+                    stream | koda::views::LittleEndianWordInput,
+                    result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kInput, result);
+}
+EndConstexprTest;
+
+BeginConstexprTest(EliasDeltaDecoderTest, PartialInputDecoding) {
+    const std::vector<uint16_t> kInput{{16, 300, 7}};
+    std::vector<bool> stream;
+    std::vector<uint16_t> result;
+
+    koda::EliasDeltaEncoder<uint16_t> encoder;
+
+    encoder(kInput, stream | koda::views::InsertFromBack);
+
+    koda::EliasDeltaDecoder<uint16_t> decoder;
+
+    // Splits the stream inside the length field of the first code word
+    decoder.Decode(stream | koda::views::Take(4),
+                   result | koda::views::InsertFromBack);
+    decoder.Decode(stream | std::views::drop(4),
+                   result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kInput, result);
+}
+EndConstexprTest;
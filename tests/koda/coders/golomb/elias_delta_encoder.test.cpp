@@ -0,0 +1,39 @@
+#include <koda/coders/coder.hpp>
+#include <koda/coders/golomb/elias_delta_encoder.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/tests/tests.hpp>
+
+#include <iterator>
+#include <vector>
+
+static_assert(
+    koda::SizeAwareEncoder<koda::EliasDeltaEncoder<uint16_t>, uint16_t>);
+
+BeginConstexprTest(EliasDeltaEncoderTest, Encode) {
+    const std::vector<uint16_t> kInput{{0, 1, 4, 16}};
+    const std::vector<bool> kExpected = {
+        1,                          // 0
+        0, 1, 0, 0,                 // 1
+        0, 1, 1, 0, 1,              // 4
+        0, 0, 1, 0, 1, 0, 0, 0, 1,  // 16
+    };
+    std::vector<bool> target;
+
+    koda::EliasDeltaEncoder<uint16_t> encoder;
+
+    encoder(kInput, target | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kExpected, target);
+}
+EndConstexprTest;
+
+BeginConstexprTest(EliasDeltaEncoderTest, TokenBitSize) {
+    koda::EliasDeltaEncoder<uint32_t> encoder;
+
+    ConstexprAssertEqual(encoder.TokenBitSize(0), 1.f);
+    ConstexprAssertEqual(encoder.TokenBitSize(4), 5.f);
+    ConstexprAssertEqual(encoder.TokenBitSize(16), 9.f);
+    ConstexprAssertEqual(encoder.TokenBitSize(0xFFFF'FFFF), 43.f);
+}
+EndConstexprTest;
@@ -0,0 +1,72 @@
+#include <koda/coders/coder.hpp>
+#include <koda/coders/golomb/exp_golomb_decoder.hpp>
+#include <koda/coders/golomb/exp_golomb_encoder.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/ranges/word_bit_iterator.hpp>
+#include <koda/tests/tests.hpp>
+
+#include <iterator>
+#include <vector>
+
+static_assert(koda::Decoder<koda::ExpGolombDecoder<uint8_t>, uint8_t>);
+static_assert(koda::Decoder<koda::EliasGammaDecoder<uint32_t>, uint32_t>);
+
+BeginConstexprTest(ExpGolombDecoderTest, DecodeBits) {
+    const std::vector<uint8_t> kInput{{0, 1, 2, 3, 7, 255, 128}};
+    std::vector<bool> stream;
+    std::vector<uint8_t> result;
+
+    koda::ExpGolombEncoder<uint8_t> encoder{3};
+
+    encoder(kInput, stream | koda::views::InsertFromBack);
+
+    koda::ExpGolombDecoder<uint8_t> decoder{3};
+
+    decoder(stream, result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kInput, result);
+}
+EndConstexprTest;
+
+BeginConstexprTest(ExpGolombDecoderTest, DecodeBufferedWords) {
+    const std::vector<uint32_t> kInput{
+        {0, 1, 17, 4096, 0xFFFF'FFFF, 3, 0x8000'0000, 42}};
+    std::vector<uint8_t> stream;
+    std::vector<uint32_t> result;
+
+    koda::EliasGammaEncoder<uint32_t> encoder;
+
+    encoder(kInput, stream | koda::views::InsertFromBack |
+                        koda::views::LittleEndianOutput);
+
+    koda::EliasGammaDecoder<uint32_t> decoder;
+
+    decoder.DecodeN(kInput.size(),
+                    stream | koda::views::LittleEndianWordInput,
+                    result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kInput, result);
+}
+EndConstexprTest;
+
+BeginConstexprTest(ExpGolombDecoderTest, PartialInputDecoding) {
+    const std::vector<uint8_t> kInput{{1, 4, 8, 13, 22, 17, 19}};
+    std::vector<bool> stream;
+    std::vector<uint8_t> result;
+
+    koda::ExpGolombEncoder<uint8_t> encoder{1};
+
+    encoder(kInput, stream | koda::views::InsertFromBack);
+
+    koda::ExpGolombDecoder<uint8_t> decoder{1};
+
+    // Splits the stream in the middle of the second code word
+    decoder.Decode(stream | koda::views::Take(5),
+                   result | koda::views::InsertFromBack);
+    decoder.Decode(stream | std::views::drop(5),
+                   result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kInput, result);
+}
+EndConstexprTest;
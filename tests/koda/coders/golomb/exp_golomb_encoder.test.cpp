@@ -0,0 +1,77 @@
+#include <koda/coders/coder.hpp>
+#include <koda/coders/golomb/exp_golomb_encoder.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/tests/tests.hpp>
+
+#include <iterator>
+#include <vector>
+
+static_assert(
+    koda::SizeAwareEncoder<koda::ExpGolombEncoder<uint8_t>, uint8_t>);
+static_assert(
+    koda::SizeAwareEncoder<koda::EliasGammaEncoder<uint32_t>, uint32_t>);
+
+BeginConstexprTest(ExpGolombEncoderTest, EncodeZeroOrder) {
+    const std::vector<uint8_t> kInput{{0, 1, 2, 3, 7}};
+    const std::vector<bool> kExpected = {
+        1,                    // 0
+        0, 1, 0,              // 1
+        0, 1, 1,              // 2
+        0, 0, 1, 0, 0,        // 3
+        0, 0, 0, 1, 0, 0, 0,  // 7
+    };
+    std::vector<bool> target;
+
+    koda::EliasGammaEncoder<uint8_t> encoder;
+
+    encoder(kInput, target | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kExpected, target);
+}
+EndConstexprTest;
+
+BeginConstexprTest(ExpGolombEncoderTest, EncodeSecondOrder) {
+    const std::vector<uint8_t> kInput{{0, 5, 12}};
+    const std::vector<bool> kExpected = {
+        1, 0, 0,              // 0
+        0, 1, 0, 0, 1,        // 5
+        0, 0, 1, 0, 0, 0, 0,  // 12
+    };
+    std::vector<bool> target;
+
+    koda::ExpGolombEncoder<uint8_t> encoder{2};
+
+    encoder(kInput, target | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kExpected, target);
+}
+EndConstexprTest;
+
+BeginConstexprTest(ExpGolombEncoderTest, PartialOutput) {
+    const std::vector<uint8_t> kInput{{3, 7}};
+    const std::vector<bool> kExpected = {
+        0, 0, 1, 0, 0,        // 3
+        0, 0, 0, 1, 0, 0, 0,  // 7
+    };
+    std::vector<bool> target;
+
+    koda::ExpGolombEncoder<uint8_t> encoder;
+
+    auto [input, _] = encoder.Encode(
+        kInput, target | koda::views::InsertFromBack | koda::views::Take(3));
+    encoder.Encode(input, target | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(kExpected, target);
+}
+EndConstexprTest;
+
+BeginConstexprTest(ExpGolombEncoderTest, TokenBitSize) {
+    koda::ExpGolombEncoder<uint32_t> encoder{2};
+
+    ConstexprAssertEqual(encoder.TokenBitSize(0), 3.f);
+    ConstexprAssertEqual(encoder.TokenBitSize(5), 5.f);
+    ConstexprAssertEqual(encoder.TokenBitSize(12), 7.f);
+    ConstexprAssertEqual(encoder.TokenBitSize(0xFFFF'FFFF), 63.f);
+}
+EndConstexprTest;
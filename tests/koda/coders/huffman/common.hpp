@@ -1,6 +1,8 @@
 #pragma once
 
 #include <koda/coders/huffman/huffman_table.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
 
 #include <vector>
 
@@ -13,3 +15,17 @@ constexpr std::vector<bool> ConcatenateSymbols(
     }
     return result;
 }
+
+template <typename Token>
+constexpr std::vector<uint8_t> PackSymbols(
+    const koda::HuffmanTable<Token>& table, const auto& tokens) {
+    std::vector<uint8_t> result;
+    auto iter = (result | koda::views::InsertFromBack |
+                 koda::views::LittleEndianOutput)
+                    .begin();
+    for (const bool bit : ConcatenateSymbols(table, tokens)) {
+        *iter++ = bit;
+    }
+    iter.Flush();
+    return result;
+}
@@ -36,3 +36,26 @@ BeginConstexprTest(HuffmanTest, Test) {
     ConstexprAssertTrue(result.size() * CHAR_BIT > stream.size());
 }
 EndConstexprTest;
+
+BeginConstexprTest(HuffmanTest, CanonicalTable) {
+    const auto kCount = koda::Counter{kTestString}.counted();
+    const auto kTable = koda::MakeCanonicalHuffmanTable(kCount);
+
+    std::vector<uint8_t> stream;
+    std::string result;
+
+    koda::HuffmanEncoder encoder{kTable};
+    koda::HuffmanDecoder decoder{kTable};
+
+    encoder(kTestString, stream | koda::views::InsertFromBack |
+                             koda::views::LittleEndianOutput)
+        .output_range.begin()
+        .Flush();
+
+    decoder(stream | koda::views::LittleEndianInput,
+            result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(result | koda::views::Take(kTestString.size()),
+                         kTestString);
+}
+EndConstexprTest;
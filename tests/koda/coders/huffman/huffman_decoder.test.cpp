@@ -179,3 +179,62 @@ BeginConstexprTest(HuffmanDecoderTest, PartialOutputDecoding) {
     ConstexprAssertEqual(result, kExpected);
 }
 EndConstexprTest;
+
+BeginConstexprTest(HuffmanDecoderTest, LookupTableDecoding) {
+    using HuffmanEntry = koda::HuffmanTable<uint32_t>::entry_type;
+
+    const koda::HuffmanTable<char> kTable = {
+        HuffmanEntry{'t', std::vector<bool>{1}},
+        HuffmanEntry{'r', std::vector<bool>{0, 1}},
+        HuffmanEntry{'x', std::vector<bool>{0, 0, 1}},
+        HuffmanEntry{'o', std::vector<bool>{0, 0, 0, 1}},
+        HuffmanEntry{'e', std::vector<bool>{0, 0, 0, 0, 1}},
+        HuffmanEntry{'a', std::vector<bool>{0, 0, 0, 0, 0}}};
+
+    const std::string kExpected = "trxxaxetrorxooeatt";
+    const std::vector<uint8_t> stream = PackSymbols(kTable, kExpected);
+
+    // Two bit lookup covers the codes up to four bits with the secondary
+    // tables, the longest ones are resolved by walking the tree
+    koda::HuffmanDecoder decoder{kTable, 2};
+
+    std::string result;
+
+    decoder(kExpected.size(), stream | koda::views::LittleEndianInput,
+            result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(result, kExpected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(HuffmanDecoderTest, PairLookupDecoding) {
+    using HuffmanEntry = koda::HuffmanTable<uint32_t>::entry_type;
+
+    const koda::HuffmanTable<char> kTable = {
+        HuffmanEntry{'t', std::vector<bool>{1}},
+        HuffmanEntry{'r', std::vector<bool>{0, 1}},
+        HuffmanEntry{'x', std::vector<bool>{0, 0, 1}},
+        HuffmanEntry{'o', std::vector<bool>{0, 0, 0, 1}},
+        HuffmanEntry{'e', std::vector<bool>{0, 0, 0, 0, 1}},
+        HuffmanEntry{'a', std::vector<bool>{0, 0, 0, 0, 0}}};
+
+    const std::string kExpected = "trxxaxetrorxooeattt";
+    const std::vector<uint8_t> stream = PackSymbols(kTable, kExpected);
+
+    koda::HuffmanDecoder decoder{kTable, 4, true};
+
+    std::string result;
+
+    // Output ends in the middle of the "tt" pair
+    auto [istream, _] =
+        decoder.DecodeN(17, stream | koda::views::LittleEndianWordInput,
+                        result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(result, kExpected | koda::views::Take(17));
+
+    decoder.DecodeN(2, std::move(istream),
+                    result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(result, kExpected);
+}
+EndConstexprTest;
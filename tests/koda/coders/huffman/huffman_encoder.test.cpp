@@ -198,3 +198,51 @@ BeginConstexprTest(HuffmanEncoderTest, PartialOutputEncoding) {
     ConstexprAssertEqual(stream, kExpected);
 }
 EndConstexprTest;
+
+BeginConstexprTest(HuffmanEncoderTest, EncodeSparseTokens) {
+    using HuffmanEntry = koda::HuffmanTable<int32_t>::entry_type;
+
+    // Tokens span too wide range to be kept in the dense table
+    const koda::HuffmanTable<int32_t> kTable = {
+        HuffmanEntry{-1 << 20, std::vector<bool>{0}},
+        HuffmanEntry{-7, std::vector<bool>{1, 0}},
+        HuffmanEntry{1 << 20, std::vector<bool>{1, 1}}};
+
+    std::vector<int32_t> tokens = {-7, 1 << 20, -1 << 20, -1 << 20, -7};
+    const std::vector<bool> kExpected = ConcatenateSymbols(kTable, tokens);
+
+    koda::HuffmanEncoder encoder{kTable};
+
+    std::vector<bool> stream;
+
+    encoder(tokens, stream | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(stream, kExpected);
+    ConstexprAssertEqual(encoder.TokenBitSize(1 << 20), 2);
+}
+EndConstexprTest;
+
+BeginConstexprTest(HuffmanEncoderTest, EncodeNegativeTokens) {
+    using HuffmanEntry = koda::HuffmanTable<int8_t>::entry_type;
+
+    const koda::HuffmanTable<int8_t> kTable = {
+        HuffmanEntry{-128, std::vector<bool>{0, 0}},
+        HuffmanEntry{-1, std::vector<bool>{0, 1}},
+        HuffmanEntry{0, std::vector<bool>{1, 0}},
+        HuffmanEntry{127, std::vector<bool>{1, 1}}};
+
+    std::vector<int8_t> tokens = {127, -128, 0, -1, -1, 0, 127, -128};
+    const std::vector<bool> kExpected = ConcatenateSymbols(kTable, tokens);
+
+    koda::HuffmanEncoder encoder{kTable};
+
+    std::vector<uint8_t> stream;
+
+    encoder(tokens, stream | koda::views::InsertFromBack |
+                        koda::views::LittleEndianOutput)
+        .output_range.begin()
+        .Flush();
+
+    ConstexprAssertEqual(stream | koda::views::LittleEndianInput, kExpected);
+}
+EndConstexprTest;
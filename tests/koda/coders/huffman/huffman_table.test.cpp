@@ -1,5 +1,8 @@
 #include <koda/coders/huffman/huffman_table.hpp>
 #include <koda/tests/tests.hpp>
+#include <koda/utils/formatted_exception.hpp>
+
+#include <gtest/gtest.h>
 
 BeginConstexprTest(HuffmanTable, FirstScenario) {
     using HuffmanEntry = koda::HuffmanTable<uint32_t>::entry_type;
@@ -77,3 +80,122 @@ BeginConstexprTest(HuffmanTable, OneElementScenario) {
     ConstexprAssertEqual(table, kExpected);
 }
 EndConstexprTest;
+
+BeginConstexprTest(HuffmanTable, CanonicalScenario) {
+    using HuffmanEntry = koda::HuffmanTable<uint32_t>::entry_type;
+
+    // Two-queue construction yields different but equally optimal lengths
+    // than the ones in the FirstScenario
+    const koda::HuffmanTable<uint32_t> kExpected = {
+        HuffmanEntry{0, std::vector<bool>{0, 0}},
+        HuffmanEntry{5, std::vector<bool>{0, 1}},
+        HuffmanEntry{16, std::vector<bool>{1, 0}},
+        HuffmanEntry{43, std::vector<bool>{1, 1, 0}},
+        HuffmanEntry{1, std::vector<bool>{1, 1, 1, 0}},
+        HuffmanEntry{32, std::vector<bool>{1, 1, 1, 1}}};
+
+    koda::Map<uint32_t, size_t> counts = {{5, 32},  {1, 4},   {0, 54},
+                                          {32, 16}, {43, 16}, {16, 22}};
+
+    auto table = koda::MakeCanonicalHuffmanTable(counts);
+
+    ConstexprAssertEqual(table, kExpected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(HuffmanTable, CanonicalFromTable) {
+    using HuffmanEntry = koda::HuffmanTable<char>::entry_type;
+
+    const koda::HuffmanTable<char> kTable = {
+        HuffmanEntry{'t', std::vector<bool>{1}},
+        HuffmanEntry{'r', std::vector<bool>{0, 1}},
+        HuffmanEntry{'x', std::vector<bool>{0, 0, 1}},
+        HuffmanEntry{'o', std::vector<bool>{0, 0, 0, 1}},
+        HuffmanEntry{'e', std::vector<bool>{0, 0, 0, 0, 1}},
+        HuffmanEntry{'a', std::vector<bool>{0, 0, 0, 0, 0}}};
+
+    const koda::HuffmanTable<char> kExpected = {
+        HuffmanEntry{'t', std::vector<bool>{0}},
+        HuffmanEntry{'r', std::vector<bool>{1, 0}},
+        HuffmanEntry{'x', std::vector<bool>{1, 1, 0}},
+        HuffmanEntry{'o', std::vector<bool>{1, 1, 1, 0}},
+        HuffmanEntry{'a', std::vector<bool>{1, 1, 1, 1, 0}},
+        HuffmanEntry{'e', std::vector<bool>{1, 1, 1, 1, 1}}};
+
+    ConstexprAssertEqual(koda::MakeCanonicalHuffmanTable(kTable), kExpected);
+}
+EndConstexprTest;
+
+// Exceptions cannot be thrown during the constant evaluation until
+// https://wg21.link/P3068R6 is implemented, hence the runtime test
+TEST(HuffmanTable, CanonicalInvalidLengths) {
+    using HuffmanEntry = koda::HuffmanTable<char>::entry_type;
+
+    const koda::HuffmanTable<char> kTable = {
+        HuffmanEntry{'a', std::vector<bool>{0}},
+        HuffmanEntry{'b', std::vector<bool>{1}},
+        HuffmanEntry{'c', std::vector<bool>{1, 1}}};
+
+    EXPECT_THROW(static_cast<void>(koda::MakeCanonicalHuffmanTable(kTable)),
+                 koda::FormattedException);
+}
+
+BeginConstexprTest(HuffmanTable, LengthLimitedScenario) {
+    using HuffmanEntry = koda::HuffmanTable<char>::entry_type;
+
+    // Regular code for these counts is 5 bits deep (see ListScenario)
+    const koda::HuffmanTable<char> kExpected = {
+        HuffmanEntry{'r', std::vector<bool>{0, 0}},
+        HuffmanEntry{'t', std::vector<bool>{0, 1}},
+        HuffmanEntry{'a', std::vector<bool>{1, 0, 0}},
+        HuffmanEntry{'e', std::vector<bool>{1, 0, 1}},
+        HuffmanEntry{'o', std::vector<bool>{1, 1, 0}},
+        HuffmanEntry{'x', std::vector<bool>{1, 1, 1}}};
+
+    koda::Map<char, size_t> counts = {{'a', 1}, {'e', 2},  {'o', 4},
+                                      {'x', 8}, {'r', 16}, {'t', 32}};
+
+    auto table = koda::MakeHuffmanTable(counts, 3);
+
+    ConstexprAssertEqual(koda::HuffmanMaxCodeLength(table), 3);
+    ConstexprAssertEqual(table, kExpected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(HuffmanTable, LengthLimitNotReached) {
+    koda::Map<char, size_t> counts = {{'a', 1}, {'e', 2},  {'o', 4},
+                                      {'x', 8}, {'r', 16}, {'t', 32}};
+
+    auto table = koda::MakeHuffmanTable(counts, 5);
+
+    ConstexprAssertEqual(table, koda::MakeCanonicalHuffmanTable(counts));
+}
+EndConstexprTest;
+
+TEST(HuffmanTable, LengthLimitTooShort) {
+    koda::Map<char, size_t> counts = {{'a', 1}, {'e', 2},  {'o', 4},
+                                      {'x', 8}, {'r', 16}, {'t', 32}};
+
+    EXPECT_THROW(static_cast<void>(koda::MakeHuffmanTable(counts, 2)),
+                 koda::FormattedException);
+}
+
+BeginConstexprTest(HuffmanTable, CodeLengths) {
+    const koda::Map<uint32_t, size_t> kExpected = {{0, 2},  {1, 4},  {5, 2},
+                                                   {16, 2}, {32, 4}, {43, 3}};
+
+    koda::Map<uint32_t, size_t> counts = {{5, 32},  {1, 4},   {0, 54},
+                                          {32, 16}, {43, 16}, {16, 22}};
+
+    ConstexprAssertEqual(koda::MakeHuffmanCodeLengths(counts), kExpected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(HuffmanTable, CodeLengthsOneElement) {
+    const koda::Map<char, size_t> kExpected = {{'a', 0}};
+
+    koda::Map<char, size_t> counts = {{'a', 7}};
+
+    ConstexprAssertEqual(koda::MakeHuffmanCodeLengths(counts), kExpected);
+}
+EndConstexprTest;
@@ -8,6 +8,7 @@
 #include <koda/coders/rice/rice_encoder.hpp>
 #include <koda/coders/uniform/uniform_decoder.hpp>
 #include <koda/coders/uniform/uniform_encoder.hpp>
+#include <koda/collections/hash_chain.hpp>
 #include <koda/ranges/back_inserter_iterator.hpp>
 #include <koda/ranges/bit_iterator.hpp>
 #include <koda/tests/tests.hpp>
@@ -47,6 +48,10 @@ using IMDecoder =
 using Lz77Encoder = koda::Lz77Encoder<char, IMEncoder>;
 using Lz77Decoder = koda::Lz77Decoder<char, IMDecoder>;
 
+using HashChainLz77Encoder =
+    koda::Lz77Encoder<char, IMEncoder, std::allocator<char>,
+                      koda::HashChain<char>>;
+
 BeginConstexprTest(Lz77Test, NormalTest) {
     const auto kHuffmanTable = BuildHuffmanTable();
 
@@ -127,3 +132,65 @@ BeginConstexprTest(Lz77Test, SmallDictionaryTest) {
     ConstexprAssertEqual(kTestString, decoded);
 }
 EndConstexprTest;
+
+BeginConstexprTest(Lz77Test, LazyMatchingTest) {
+    const auto kHuffmanTable = BuildHuffmanTable();
+
+    for (size_t lazy_good_length : {4, 8, 16}) {
+        Lz77Encoder encoder{
+            1024, 16,
+            IMEncoder{TokenEncoder{kHuffmanTable}, PositionEncoder{10},
+                      LengthEncoder{2}}};
+        encoder.set_lazy_good_length(lazy_good_length);
+        ConstexprAssertEqual(encoder.lazy_good_length(), lazy_good_length);
+
+        std::vector<uint8_t> encoded;
+
+        encoder(kTestString, encoded | koda::views::InsertFromBack |
+                                 koda::views::LittleEndianOutput)
+            .output_range.begin()
+            .Flush();
+
+        std::string decoded;
+
+        Lz77Decoder decoder{1024, 16,
+                            IMDecoder{TokenDecoder{kHuffmanTable},
+                                      PositionDecoder{10}, LengthDecoder{2}}};
+
+        decoder(kTestString.size(), encoded | koda::views::LittleEndianInput,
+                decoded | koda::views::InsertFromBack);
+
+        ConstexprAssertEqual(kTestString, decoded);
+    }
+};
+EndConstexprTest;
+
+BeginConstexprTest(Lz77Test, HashChainTest) {
+    const auto kHuffmanTable = BuildHuffmanTable();
+
+    for (size_t dictionary_size : {16, 1024}) {
+        HashChainLz77Encoder encoder{
+            dictionary_size, 16,
+            IMEncoder{TokenEncoder{kHuffmanTable}, PositionEncoder{10},
+                      LengthEncoder{2}}};
+
+        std::vector<uint8_t> encoded;
+
+        encoder(kTestString, encoded | koda::views::InsertFromBack |
+                                 koda::views::LittleEndianOutput)
+            .output_range.begin()
+            .Flush();
+
+        std::string decoded;
+
+        Lz77Decoder decoder{dictionary_size, 16,
+                            IMDecoder{TokenDecoder{kHuffmanTable},
+                                      PositionDecoder{10}, LengthDecoder{2}}};
+
+        decoder(kTestString.size(), encoded | koda::views::LittleEndianInput,
+                decoded | koda::views::InsertFromBack);
+
+        ConstexprAssertEqual(kTestString, decoded);
+    }
+};
+EndConstexprTest;
@@ -8,10 +8,16 @@
 #include <koda/coders/rice/rice_encoder.hpp>
 #include <koda/coders/uniform/uniform_decoder.hpp>
 #include <koda/coders/uniform/uniform_encoder.hpp>
+#include <koda/collections/hash_binary_tree.hpp>
+#include <koda/collections/hash_chain.hpp>
+#include <koda/collections/search_binary_tree.hpp>
 #include <koda/ranges/back_inserter_iterator.hpp>
 #include <koda/ranges/bit_iterator.hpp>
 #include <koda/tests/tests.hpp>
 #include <koda/utils/counter.hpp>
+#include <koda/utils/formatted_exception.hpp>
+
+#include <gtest/gtest.h>
 
 static constexpr std::string_view kTestString =
     "The number theoretic transform is based on generalizing the $ N$ th "
@@ -47,6 +53,54 @@ using IMDecoder =
 using LzssEncoder = koda::LzssEncoder<char, IMEncoder>;
 using LzssDecoder = koda::LzssDecoder<char, IMDecoder>;
 
+using HashChainLzssEncoder =
+    koda::LzssEncoder<char, IMEncoder, std::allocator<char>,
+                      koda::HashChain<char>>;
+
+using HashBinaryTreeLzssEncoder =
+    koda::LzssEncoder<char, IMEncoder, std::allocator<char>,
+                      koda::HashBinaryTree<char>>;
+
+using IndexedLzssEncoder = koda::LzssEncoder<
+    char, IMEncoder, std::allocator<char>,
+    koda::SearchBinaryTree<char, std::allocator<char>,
+                           koda::RedBlackTreeLayout::kIndexed>>;
+
+template <typename Encoder = LzssEncoder>
+static constexpr Encoder MakeEncoder(size_t dictionary_size) {
+    return Encoder{dictionary_size, 16,
+                   IMEncoder{TokenEncoder{BuildHuffmanTable()},
+                             PositionEncoder{10}, LengthEncoder{2}}};
+}
+
+static constexpr LzssDecoder MakeDecoder(size_t dictionary_size) {
+    return LzssDecoder{dictionary_size, 16,
+                       IMDecoder{TokenDecoder{BuildHuffmanTable()},
+                                 PositionDecoder{10}, LengthDecoder{2}}};
+}
+
+static constexpr std::vector<uint8_t> EncodeString(auto&& encoder,
+                                                   std::string_view input) {
+    std::vector<uint8_t> encoded;
+
+    encoder(input, encoded | koda::views::InsertFromBack |
+                       koda::views::LittleEndianOutput)
+        .output_range.begin()
+        .Flush();
+
+    return encoded;
+}
+
+static constexpr std::string DecodeString(auto&& decoder, size_t size,
+                                          const std::vector<uint8_t>& encoded) {
+    std::string decoded;
+
+    decoder(size, encoded | koda::views::LittleEndianInput,
+            decoded | koda::views::InsertFromBack);
+
+    return decoded;
+}
+
 BeginConstexprTest(LzssTest, NormalTest) {
     const auto kHuffmanTable = BuildHuffmanTable();
     LzssEncoder encoder{1024, 16,
@@ -124,3 +178,300 @@ BeginConstexprTest(LzssTest, SmallDictionaryTest) {
     ConstexprAssertEqual(kTestString, decoded);
 };
 EndConstexprTest;
+
+BeginConstexprTest(LzssTest, OptimalParsingTest) {
+    for (size_t dictionary_size : {16, 1024}) {
+        auto encoder = MakeEncoder(dictionary_size);
+        encoder.set_parsing(koda::LzssParsing::kOptimal);
+        ConstexprAssertEqual(encoder.parsing(), koda::LzssParsing::kOptimal);
+
+        auto encoded = EncodeString(encoder, kTestString);
+        auto greedy_encoded =
+            EncodeString(MakeEncoder(dictionary_size), kTestString);
+
+        // Greedy choices are also considered by the optimal parser
+        ConstexprAssertTrue(encoded.size() <= greedy_encoded.size());
+        ConstexprAssertEqual(DecodeString(MakeDecoder(dictionary_size),
+                                          kTestString.size(), encoded),
+                             kTestString);
+    }
+};
+EndConstexprTest;
+
+BeginConstexprTest(LzssTest, LazyMatchingTest) {
+    for (size_t dictionary_size : {16, 1024}) {
+        auto greedy_encoded =
+            EncodeString(MakeEncoder(dictionary_size), kTestString);
+
+        // Good lengths cannot exceed the look-ahead size
+        for (size_t lazy_good_length : {4, 8, 16}) {
+            auto encoder = MakeEncoder(dictionary_size);
+            encoder.set_lazy_good_length(lazy_good_length);
+            ConstexprAssertEqual(encoder.lazy_good_length(), lazy_good_length);
+
+            auto encoded = EncodeString(encoder, kTestString);
+
+            ConstexprAssertTrue(encoded.size() <= greedy_encoded.size());
+            ConstexprAssertEqual(DecodeString(MakeDecoder(dictionary_size),
+                                              kTestString.size(), encoded),
+                                 kTestString);
+        }
+    }
+};
+EndConstexprTest;
+
+BeginConstexprTest(LzssTest, HashChainTest) {
+    for (size_t dictionary_size : {16, 1024}) {
+        auto shallow_encoder =
+            MakeEncoder<HashChainLzssEncoder>(dictionary_size);
+        shallow_encoder.match_finder().set_max_chain_depth(1);
+
+        auto encoded =
+            EncodeString(MakeEncoder<HashChainLzssEncoder>(dictionary_size),
+                         kTestString);
+        auto shallow_encoded = EncodeString(shallow_encoder, kTestString);
+
+        // Only the newest string of each chain is tried by the shallow search
+        ConstexprAssertTrue(encoded.size() <= shallow_encoded.size());
+        ConstexprAssertEqual(DecodeString(MakeDecoder(dictionary_size),
+                                          kTestString.size(), encoded),
+                             kTestString);
+        ConstexprAssertEqual(DecodeString(MakeDecoder(dictionary_size),
+                                          kTestString.size(), shallow_encoded),
+                             kTestString);
+    }
+};
+EndConstexprTest;
+
+BeginConstexprTest(LzssTest, HashBinaryTreeTest) {
+    for (size_t dictionary_size : {16, 1024}) {
+        auto shallow_encoder =
+            MakeEncoder<HashBinaryTreeLzssEncoder>(dictionary_size);
+        shallow_encoder.match_finder().set_max_search_depth(1);
+
+        auto encoded = EncodeString(
+            MakeEncoder<HashBinaryTreeLzssEncoder>(dictionary_size),
+            kTestString);
+        auto shallow_encoded = EncodeString(shallow_encoder, kTestString);
+
+        // Only the root of each bucket tree is tried by the shallow search
+        ConstexprAssertTrue(encoded.size() <= shallow_encoded.size());
+        ConstexprAssertEqual(DecodeString(MakeDecoder(dictionary_size),
+                                          kTestString.size(), encoded),
+                             kTestString);
+        ConstexprAssertEqual(DecodeString(MakeDecoder(dictionary_size),
+                                          kTestString.size(), shallow_encoded),
+                             kTestString);
+    }
+};
+EndConstexprTest;
+
+BeginConstexprTest(LzssTest, IndexedLayoutTest) {
+    for (size_t dictionary_size : {16, 1024}) {
+        auto pointer_encoded =
+            EncodeString(MakeEncoder(dictionary_size), kTestString);
+        auto indexed_encoded = EncodeString(
+            MakeEncoder<IndexedLzssEncoder>(dictionary_size), kTestString);
+
+        // Node layout changes only the memory so the streams are identical
+        ConstexprAssertEqual(pointer_encoded, indexed_encoded);
+    }
+};
+EndConstexprTest;
+
+BeginConstexprTest(LzssTest, LazyExpiryTest) {
+    for (size_t dictionary_size : {16, 1024}) {
+        for (size_t expiry_period : {size_t{7}, dictionary_size}) {
+            auto encoder = MakeEncoder(dictionary_size);
+            encoder.match_finder().set_expiry_period(expiry_period);
+
+            // Expired strings can steer the descent away from the live ones
+            // sharing their prefix, so the matches may differ from the eager
+            // ones but always point into the dictionary
+            auto encoded = EncodeString(encoder, kTestString);
+
+            ConstexprAssertEqual(DecodeString(MakeDecoder(dictionary_size),
+                                              kTestString.size(), encoded),
+                                 kTestString);
+        }
+    }
+};
+EndConstexprTest;
+
+namespace {
+
+// Records the intermediate tokens chosen by the LZSS encoder
+class RecordingIMEncoder : public IMEncoder {
+   public:
+    using IMEncoder::IMEncoder;
+
+    std::vector<token_type> tokens = {};
+
+    constexpr auto Encode(koda::InputRange<token_type> auto&& input,
+                          koda::BitOutputRange auto&& output) {
+        std::ranges::copy(input, std::back_inserter(tokens));
+        return IMEncoder::Encode(std::forward<decltype(input)>(input),
+                                 std::forward<decltype(output)>(output));
+    }
+};
+
+}  // namespace
+
+BeginConstexprTest(LzssTest, RepeatedOffsetTest) {
+    // Fixed width records whose fields vary so the matches keep recurring at
+    // the record width
+    std::string input;
+    for (size_t i = 0; i < 32; ++i) {
+        input += "W_";
+        input += "0123"[i % 4];
+        input += "=exp(";
+        input += "abcdefg"[i % 7];
+        input += ")$ ";
+    }
+
+    for (size_t dictionary_size : {16, 1024}) {
+        koda::LzssEncoder<char, RecordingIMEncoder> encoder{
+            dictionary_size, 16,
+            RecordingIMEncoder{TokenEncoder{BuildHuffmanTable()},
+                               PositionEncoder{10}, LengthEncoder{2}}};
+        encoder.auxiliary_encoder().set_repeated_offsets(true);
+
+        auto encoded = EncodeString(encoder, input);
+        const auto& expected = encoder.auxiliary_encoder().tokens;
+
+        ConstexprAssertTrue(
+            std::ranges::any_of(expected, [](const auto& token) {
+                return token.holds_repeated_offset();
+            }));
+
+        IMDecoder token_decoder{TokenDecoder{BuildHuffmanTable()},
+                                PositionDecoder{10}, LengthDecoder{2}};
+        token_decoder.set_repeated_offsets(true);
+
+        std::vector<IMDecoder::token_type> tokens;
+
+        token_decoder(expected.size(), encoded | koda::views::LittleEndianInput,
+                      tokens | koda::views::InsertFromBack);
+
+        ConstexprAssertEqual(tokens, expected);
+
+        auto decoder = MakeDecoder(dictionary_size);
+        decoder.auxiliary_decoder().set_repeated_offsets(true);
+
+        ConstexprAssertEqual(DecodeString(decoder, input.size(), encoded),
+                             input);
+    }
+};
+EndConstexprTest;
+
+BeginConstexprTest(LzssTest, PrimingTest) {
+    for (size_t dictionary_size : {16, 1024}) {
+        for (size_t primer_size : {size_t{5}, kTestString.size() / 2}) {
+            auto primer = kTestString.substr(0, primer_size);
+            auto input = kTestString.substr(primer_size);
+
+            auto encoder = MakeEncoder(dictionary_size);
+            encoder.Prime(primer);
+
+            auto decoder = MakeDecoder(dictionary_size);
+            decoder.Prime(primer);
+
+            ConstexprAssertEqual(
+                DecodeString(decoder, input.size(),
+                             EncodeString(encoder, input)),
+                input);
+        }
+    }
+};
+EndConstexprTest;
+
+BeginConstexprTest(LzssTest, DictionaryTest) {
+    const auto kPrefix = kTestString.substr(0, kTestString.size() / 2);
+    const auto kInput = kTestString.substr(kTestString.size() / 2);
+    const koda::LzssDictionary<char> kDictionary{kPrefix};
+
+    for (size_t dictionary_size : {16, 1024}) {
+        auto encoder = MakeEncoder(dictionary_size);
+        encoder.set_dictionary(kDictionary);
+
+        auto decoder = MakeDecoder(dictionary_size);
+        decoder.set_dictionary(kDictionary);
+
+        ConstexprAssertEqual(
+            DecodeString(decoder, kInput.size(), EncodeString(encoder, kInput)),
+            kInput);
+    }
+};
+EndConstexprTest;
+
+// Exceptions cannot be thrown during the constant evaluation until
+// https://wg21.link/P3068R6 is implemented, hence the runtime test
+TEST(LzssTest, DictionaryMismatch) {
+    const auto kPrefix = kTestString.substr(0, kTestString.size() / 2);
+    const auto kInput = kTestString.substr(kTestString.size() / 2);
+    const koda::LzssDictionary<char> kDictionary{kPrefix};
+
+    auto encoder = MakeEncoder(1024);
+    encoder.set_dictionary(kDictionary);
+    auto encoded = EncodeString(encoder, kInput);
+
+    auto decoder = MakeDecoder(1024);
+    decoder.set_dictionary(
+        koda::LzssDictionary<char>{kDictionary.id() + 1, kPrefix});
+
+    EXPECT_THROW(DecodeString(decoder, kInput.size(), encoded),
+                 koda::FormattedException);
+
+    auto truncated_decoder = MakeDecoder(1024);
+    truncated_decoder.set_dictionary(kDictionary);
+
+    EXPECT_THROW(DecodeString(truncated_decoder, kInput.size(),
+                              std::vector<uint8_t>(2)),
+                 koda::FormattedException);
+}
+
+TEST(LzssTest, ExpiryPeriodExceedingWindow) {
+    // Smallest cyclic buffer retains no symbols behind the dictionary
+    constexpr size_t kCyclicBufferSize = 16 + 2 * 16 - 1;
+    const auto make_encoder = [](size_t retained_size) {
+        return LzssEncoder{16, 16,
+                           IMEncoder{TokenEncoder{BuildHuffmanTable()},
+                                     PositionEncoder{10}, LengthEncoder{2}},
+                           kCyclicBufferSize + retained_size};
+    };
+
+    auto encoder = make_encoder(0);
+    encoder.match_finder().set_expiry_period(1);
+
+    EXPECT_THROW(EncodeString(encoder, kTestString), koda::FormattedException);
+
+    auto retaining_encoder = make_encoder(7);
+    retaining_encoder.match_finder().set_expiry_period(7);
+
+    EXPECT_EQ(DecodeString(MakeDecoder(16), kTestString.size(),
+                           EncodeString(retaining_encoder, kTestString)),
+              kTestString);
+}
+
+BeginConstexprTest(LzssTest, AdaptiveLengthTest) {
+    const auto kHuffmanTable = BuildHuffmanTable();
+    // Backward adaptation emits the lengths right away, so it can share the
+    // stream with the symbols and positions
+    const koda::RicePartitioning kPartitioning{
+        8, koda::RiceAdaptation::kBackward};
+
+    auto encoded = EncodeString(
+        LzssEncoder{1024, 16,
+                    IMEncoder{TokenEncoder{kHuffmanTable}, PositionEncoder{10},
+                              LengthEncoder{kPartitioning}}},
+        kTestString);
+
+    LzssDecoder decoder{1024, 16,
+                        IMDecoder{TokenDecoder{kHuffmanTable},
+                                  PositionDecoder{10},
+                                  LengthDecoder{kPartitioning}}};
+
+    ConstexprAssertEqual(DecodeString(decoder, kTestString.size(), encoded),
+                         kTestString);
+};
+EndConstexprTest;
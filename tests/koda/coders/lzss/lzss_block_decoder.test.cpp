@@ -0,0 +1,155 @@
+#include <koda/coders/huffman/huffman_decoder.hpp>
+#include <koda/coders/huffman/huffman_encoder.hpp>
+#include <koda/coders/lzss/lzss_block_decoder.hpp>
+#include <koda/coders/lzss/lzss_block_encoder.hpp>
+#include <koda/coders/lzss/lzss_decoder.hpp>
+#include <koda/coders/lzss/lzss_encoder.hpp>
+#include <koda/coders/lzss/lzss_intermediate_token_decoder.hpp>
+#include <koda/coders/lzss/lzss_intermediate_token_encoder.hpp>
+#include <koda/coders/rice/rice_decoder.hpp>
+#include <koda/coders/rice/rice_encoder.hpp>
+#include <koda/coders/uniform/uniform_decoder.hpp>
+#include <koda/coders/uniform/uniform_encoder.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/utils/counter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <climits>
+#include <limits>
+#include <string>
+
+static constexpr std::string_view kTestString =
+    "The number theoretic transform is based on generalizing the $ N$ th "
+    "primitive root of unity (see §3.12) to a ``quotient ring'' instead of "
+    "the usual field of complex numbers. Let $ W_N$ denote a primitive $ "
+    "N$ th root of unity. We have been using $ W_N = \\exp(-j2\\pi/N)$ in "
+    "the field of complex numbers, and it of course satisfies $ W_N^N=1$ , "
+    "making it a root of unity; it also has the property that $ W_N^k$ "
+    "visits all of the ``DFT frequency points'' on the unit circle in the "
+    "$ z$ plane, as $ k$ goes from 0 to $ N-1$";
+
+static constexpr size_t kDictionarySize = 1024;
+static constexpr size_t kLookAheadSize = 16;
+static constexpr size_t kBlockSize = 100;
+
+using IMEncoder = koda::LzssIntermediateTokenEncoder<
+    char, uint32_t, uint16_t, koda::HuffmanEncoder<char>,
+    koda::UniformEncoder<uint32_t>, koda::RiceEncoder<uint16_t>>;
+
+using IMDecoder = koda::LzssIntermediateTokenDecoder<
+    char, uint32_t, uint16_t, koda::HuffmanDecoder<char>,
+    koda::UniformDecoder<uint32_t>, koda::RiceDecoder<uint16_t>>;
+
+using LzssEncoder = koda::LzssEncoder<char, IMEncoder>;
+using LzssDecoder = koda::LzssDecoder<char, IMDecoder>;
+
+static std::vector<uint8_t> EncodeFrame(size_t thread_count,
+                                        size_t priming_size) {
+    auto table = koda::MakeHuffmanTable(koda::Counter{kTestString}.counted());
+    auto factory = [&table]() {
+        return LzssEncoder{kDictionarySize, kLookAheadSize,
+                           IMEncoder{koda::HuffmanEncoder<char>{table},
+                                     koda::UniformEncoder<uint32_t>{10},
+                                     koda::RiceEncoder<uint16_t>{2}}};
+    };
+
+    koda::LzssBlockEncoder<char, decltype(factory)> encoder{
+        factory, kBlockSize, thread_count};
+    encoder.set_priming_size(priming_size);
+
+    std::vector<uint8_t> frame;
+    encoder.Encode(kTestString, frame | koda::views::InsertFromBack);
+    return frame;
+}
+
+static std::string DecodeFrame(std::span<const uint8_t> frame,
+                               size_t thread_count) {
+    auto table = koda::MakeHuffmanTable(koda::Counter{kTestString}.counted());
+    auto factory = [&table]() {
+        return LzssDecoder{kDictionarySize, kLookAheadSize,
+                           IMDecoder{koda::HuffmanDecoder<char>{table},
+                                     koda::UniformDecoder<uint32_t>{10},
+                                     koda::RiceDecoder<uint16_t>{2}}};
+    };
+
+    koda::LzssBlockDecoder<char, decltype(factory)> decoder{factory,
+                                                            thread_count};
+
+    std::string decoded(koda::LzssFrameHeader::Read(frame).symbol_count, '\0');
+    decoder.Decode(frame, decoded);
+    return decoded;
+}
+
+TEST(LzssBlockDecoderTest, IndependentBlocks) {
+    auto frame = EncodeFrame(4, 0);
+
+    for (size_t thread_count : {1, 2, 4, 8}) {
+        EXPECT_EQ(DecodeFrame(frame, thread_count), kTestString);
+    }
+}
+
+TEST(LzssBlockDecoderTest, PrimedBlocks) {
+    for (size_t priming_size : {kBlockSize / 2, 3 * kBlockSize}) {
+        auto frame = EncodeFrame(4, priming_size);
+
+        for (size_t thread_count : {1, 2, 4, 8}) {
+            EXPECT_EQ(DecodeFrame(frame, thread_count), kTestString);
+        }
+    }
+}
+
+TEST(LzssBlockDecoderTest, TruncatedFrame) {
+    auto frame = EncodeFrame(1, 0);
+    frame.pop_back();
+
+    EXPECT_THROW(DecodeFrame(frame, 4), koda::FormattedException);
+}
+
+static void OverwriteFrameWord(std::vector<uint8_t>& frame, size_t index,
+                               uint64_t word) {
+    for (size_t i = 0; i < sizeof(uint64_t); ++i, word >>= CHAR_BIT) {
+        frame[index * sizeof(uint64_t) + i] = static_cast<uint8_t>(word);
+    }
+}
+
+TEST(LzssBlockDecoderTest, OverflowingFrameHeader) {
+    constexpr uint64_t kMaxWord = std::numeric_limits<uint64_t>::max();
+
+    // Block sizes wrapping around the sum
+    auto frame = EncodeFrame(1, 0);
+    OverwriteFrameWord(frame, 5, kMaxWord);
+
+    EXPECT_THROW(koda::LzssFrameHeader::Read(frame), koda::FormattedException);
+
+    // Block count wrapping around the header size
+    frame = EncodeFrame(1, 0);
+    OverwriteFrameWord(frame, 1, kMaxWord);
+    OverwriteFrameWord(frame, 2, 1);
+    OverwriteFrameWord(frame, 4, kMaxWord);
+
+    EXPECT_THROW(koda::LzssFrameHeader::Read(frame), koda::FormattedException);
+
+    // Symbol count wrapping around the block count
+    OverwriteFrameWord(frame, 2, 2);
+    OverwriteFrameWord(frame, 4, 0);
+
+    EXPECT_THROW(koda::LzssFrameHeader::Read(frame), koda::FormattedException);
+}
+
+TEST(LzssBlockDecoderTest, SmallOutput) {
+    auto frame = EncodeFrame(1, 0);
+    auto table = koda::MakeHuffmanTable(koda::Counter{kTestString}.counted());
+    auto factory = [&table]() {
+        return LzssDecoder{kDictionarySize, kLookAheadSize,
+                           IMDecoder{koda::HuffmanDecoder<char>{table},
+                                     koda::UniformDecoder<uint32_t>{10},
+                                     koda::RiceDecoder<uint16_t>{2}}};
+    };
+
+    koda::LzssBlockDecoder<char, decltype(factory)> decoder{factory};
+    std::string decoded(kTestString.size() - 1, '\0');
+
+    EXPECT_THROW(decoder.Decode(frame, decoded), koda::FormattedException);
+}
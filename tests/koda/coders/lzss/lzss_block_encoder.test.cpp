@@ -0,0 +1,119 @@
+#include <koda/coders/huffman/huffman_decoder.hpp>
+#include <koda/coders/huffman/huffman_encoder.hpp>
+#include <koda/coders/lzss/lzss_block_encoder.hpp>
+#include <koda/coders/lzss/lzss_decoder.hpp>
+#include <koda/coders/lzss/lzss_encoder.hpp>
+#include <koda/coders/lzss/lzss_intermediate_token_decoder.hpp>
+#include <koda/coders/lzss/lzss_intermediate_token_encoder.hpp>
+#include <koda/coders/rice/rice_decoder.hpp>
+#include <koda/coders/rice/rice_encoder.hpp>
+#include <koda/coders/uniform/uniform_decoder.hpp>
+#include <koda/coders/uniform/uniform_encoder.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/utils/counter.hpp>
+
+#include <gtest/gtest.h>
+
+#include <span>
+#include <string>
+
+static constexpr std::string_view kTestString =
+    "The number theoretic transform is based on generalizing the $ N$ th "
+    "primitive root of unity (see §3.12) to a ``quotient ring'' instead of "
+    "the usual field of complex numbers. Let $ W_N$ denote a primitive $ "
+    "N$ th root of unity. We have been using $ W_N = \\exp(-j2\\pi/N)$ in "
+    "the field of complex numbers, and it of course satisfies $ W_N^N=1$ , "
+    "making it a root of unity; it also has the property that $ W_N^k$ "
+    "visits all of the ``DFT frequency points'' on the unit circle in the "
+    "$ z$ plane, as $ k$ goes from 0 to $ N-1$";
+
+static constexpr size_t kDictionarySize = 1024;
+static constexpr size_t kLookAheadSize = 16;
+static constexpr size_t kBlockSize = 100;
+
+using IMEncoder = koda::LzssIntermediateTokenEncoder<
+    char, uint32_t, uint16_t, koda::HuffmanEncoder<char>,
+    koda::UniformEncoder<uint32_t>, koda::RiceEncoder<uint16_t>>;
+
+using IMDecoder = koda::LzssIntermediateTokenDecoder<
+    char, uint32_t, uint16_t, koda::HuffmanDecoder<char>,
+    koda::UniformDecoder<uint32_t>, koda::RiceDecoder<uint16_t>>;
+
+using LzssEncoder = koda::LzssEncoder<char, IMEncoder>;
+using LzssDecoder = koda::LzssDecoder<char, IMDecoder>;
+
+static std::vector<uint8_t> EncodeFrame(size_t thread_count,
+                                        size_t priming_size) {
+    auto table = koda::MakeHuffmanTable(koda::Counter{kTestString}.counted());
+    auto factory = [&table]() {
+        return LzssEncoder{kDictionarySize, kLookAheadSize,
+                           IMEncoder{koda::HuffmanEncoder<char>{table},
+                                     koda::UniformEncoder<uint32_t>{10},
+                                     koda::RiceEncoder<uint16_t>{2}}};
+    };
+
+    koda::LzssBlockEncoder<char, decltype(factory)> encoder{
+        factory, kBlockSize, thread_count};
+    encoder.set_priming_size(priming_size);
+
+    std::vector<uint8_t> frame;
+    encoder.Encode(kTestString, frame | koda::views::InsertFromBack);
+    return frame;
+}
+
+static std::string DecodeFrame(std::span<const uint8_t> frame) {
+    auto table = koda::MakeHuffmanTable(koda::Counter{kTestString}.counted());
+    auto header = koda::LzssFrameHeader::Read(frame);
+
+    std::string decoded;
+    for (size_t i = 0; i < header.block_count(); ++i) {
+        const size_t block_begin = i * header.block_size;
+        const size_t block_length =
+            std::min(header.block_size, header.symbol_count - block_begin);
+
+        LzssDecoder decoder{kDictionarySize, kLookAheadSize,
+                            IMDecoder{koda::HuffmanDecoder<char>{table},
+                                      koda::UniformDecoder<uint32_t>{10},
+                                      koda::RiceDecoder<uint16_t>{2}}};
+        decoder.Prime(std::string_view{decoded}.substr(
+            block_begin - std::min(block_begin, header.priming_size)));
+
+        decoder(block_length,
+                frame.subspan(header.block_offset(i),
+                              header.encoded_block_sizes[i]) |
+                    koda::views::LittleEndianInput,
+                decoded | koda::views::InsertFromBack);
+    }
+    return decoded;
+}
+
+TEST(LzssBlockEncoderTest, IndependentBlocks) {
+    auto frame = EncodeFrame(1, 0);
+
+    EXPECT_EQ(DecodeFrame(frame), kTestString);
+}
+
+TEST(LzssBlockEncoderTest, PrimedBlocks) {
+    auto frame = EncodeFrame(1, kBlockSize);
+
+    EXPECT_EQ(DecodeFrame(frame), kTestString);
+    EXPECT_LT(frame.size(), EncodeFrame(1, 0).size());
+}
+
+TEST(LzssBlockEncoderTest, ThreadCountIndependence) {
+    for (size_t priming_size : {size_t{0}, kBlockSize}) {
+        auto frame = EncodeFrame(1, priming_size);
+
+        for (size_t thread_count : {2, 4, 8}) {
+            EXPECT_EQ(EncodeFrame(thread_count, priming_size), frame);
+        }
+    }
+}
+
+TEST(LzssBlockEncoderTest, InvalidFrame) {
+    auto frame = EncodeFrame(1, 0);
+    frame[0] ^= 1;
+
+    EXPECT_THROW(koda::LzssFrameHeader::Read(frame), koda::FormattedException);
+}
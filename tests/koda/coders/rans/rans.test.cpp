@@ -0,0 +1,134 @@
+#include <koda/coders/lzss/lzss_intermediate_token_encoder.hpp>
+#include <koda/coders/rans/rans_decoder.hpp>
+#include <koda/coders/rans/rans_encoder.hpp>
+#include <koda/coders/rans/rans_table.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/ranges/word_bit_iterator.hpp>
+#include <koda/tests/tests.hpp>
+#include <koda/utils/counter.hpp>
+
+#include <cinttypes>
+
+static constexpr std::string_view kTestString =
+    "The number theoretic transform is based on generalizing the $ N$ th "
+    "primitive root of unity (see §3.12) to a ``quotient ring'' instead of "
+    "the usual field of complex numbers. Let $ W_N$ denote a primitive $ "
+    "N$ th root of unity. We have been using $ W_N = \\exp(-j2\\pi/N)$ in "
+    "the field of complex numbers, and it of course satisfies $ W_N^N=1$ , "
+    "making it a root of unity; it also has the property that $ W_N^k$ "
+    "visits all of the ``DFT frequency points'' on the unit circle in the "
+    "$ z$ plane, as $ k$ goes from 0 to $ N-1$";
+
+static_assert(koda::SizeAwareEncoder<
+              koda::LzssIntermediateTokenEncoder<
+                  char, uint32_t, uint16_t, koda::RansEncoder<char, size_t>,
+                  koda::RansEncoder<uint32_t, size_t, 16>,
+                  koda::RansEncoder<uint16_t, size_t, 16>>,
+              koda::LzssIntermediateToken<char, uint32_t, uint16_t>>);
+
+BeginConstexprTest(RansTest, ByteRenormalization) {
+    std::string sequence{kTestString};
+    koda::RansTable table{koda::Counter{kTestString}.counted()};
+
+    koda::RansEncoder encoder{table};
+    koda::RansDecoder decoder{table};
+
+    std::vector<bool> stream;
+    std::string reconstruction;
+
+    encoder(sequence, stream | koda::views::InsertFromBack);
+
+    decoder(sequence.size(), stream | std::views::reverse,
+            reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(sequence, reconstruction | std::views::reverse);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RansTest, WordRenormalization) {
+    std::string sequence{kTestString};
+    koda::RansTable table{koda::Counter{kTestString}.counted(), 16};
+
+    koda::RansEncoder<char, size_t, 16> encoder{table};
+    koda::RansDecoder<char, size_t, 16> decoder{table};
+
+    std::vector<bool> stream;
+    std::string reconstruction;
+
+    encoder(sequence, stream | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(stream.size() % 16, 0);
+
+    decoder(sequence.size(), stream | std::views::reverse,
+            reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(sequence, reconstruction | std::views::reverse);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RansTest, LargeAlphabet) {
+    std::vector<uint32_t> sequence;
+    for (uint32_t i = 0; i < 1000; ++i) {
+        sequence.push_back((i * i) % 1499 * 4099);
+    }
+    koda::RansTable table{koda::Counter{sequence}.counted(), 11};
+
+    koda::RansEncoder<uint32_t, size_t, 16> encoder{table};
+    koda::RansDecoder<uint32_t, size_t, 16> decoder{table};
+
+    std::vector<bool> stream;
+    std::vector<uint32_t> reconstruction;
+
+    encoder(sequence, stream | koda::views::InsertFromBack);
+
+    decoder(sequence.size(), stream | std::views::reverse,
+            reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(sequence, reconstruction | std::views::reverse);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RansTest, PartialOutput) {
+    std::string sequence{kTestString};
+    koda::RansTable table{koda::Counter{kTestString}.counted()};
+
+    koda::RansEncoder encoder{table};
+    koda::RansDecoder decoder{table};
+
+    std::vector<bool> stream;
+    std::string reconstruction;
+
+    encoder(sequence, stream | koda::views::InsertFromBack);
+
+    auto [istream, _] =
+        decoder.DecodeN(101, stream | std::views::reverse,
+                        reconstruction | koda::views::InsertFromBack);
+
+    decoder.DecodeN(sequence.size() - 101, std::move(istream),
+                    reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(sequence, reconstruction | std::views::reverse);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RansTest, BufferedBackwardInput) {
+    std::string sequence{kTestString};
+    koda::RansTable table{koda::Counter{kTestString}.counted()};
+
+    koda::RansEncoder encoder{table};
+    koda::RansDecoder decoder{table};
+
+    std::vector<uint8_t> bytes;
+    std::string reconstruction;
+
+    // Byte renormalization keeps the stream aligned to whole bytes
+    encoder(sequence, bytes | koda::views::InsertFromBack |
+                          koda::views::LittleEndianOutput);
+
+    decoder(sequence.size(), bytes | koda::views::BackwardWordInput,
+            reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(sequence, reconstruction | std::views::reverse);
+}
+EndConstexprTest;
@@ -0,0 +1,54 @@
+#include <koda/coders/rans/rans_decoder.hpp>
+#include <koda/coders/rans/rans_table.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/tests/tests.hpp>
+
+#include <cinttypes>
+
+static_assert(koda::Decoder<koda::RansDecoder<uint8_t, size_t>, uint8_t>);
+
+static_assert(
+    koda::Decoder<koda::RansDecoder<uint32_t, size_t, 16>, uint32_t>);
+
+static constexpr std::vector<bool> StateBits(uint32_t state) {
+    std::vector<bool> bits;
+    for (size_t i = 0; i < 32; ++i) {
+        bits.push_back((state >> i) & 1);
+    }
+    return bits;
+}
+
+BeginConstexprTest(RansDecoderTest, SingleToken) {
+    const koda::Map<char, size_t> kCounter = {{{'a', 5}}};
+    koda::RansTable table{kCounter};
+    koda::RansDecoder decoder{table};
+
+    const std::vector<bool> kStream = StateBits(uint32_t{1} << 24);
+    const std::string kExpected = "aaaaa";
+
+    std::string result;
+
+    decoder(kExpected.size(), kStream | std::views::reverse,
+            result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(result, kExpected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RansDecoderTest, GeometricDistribution) {
+    const koda::Map<char, size_t> kCounter = {{{'a', 1}, {'b', 3}}};
+    koda::RansTable table{kCounter, 2};
+    koda::RansDecoder decoder{table};
+
+    const std::vector<bool> kStream = StateBits(89478486);
+    const std::string kExpected = "ab";
+
+    std::string result;
+
+    decoder(kExpected.size(), kStream | std::views::reverse,
+            result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(result | std::views::reverse, kExpected);
+}
+EndConstexprTest;
@@ -0,0 +1,81 @@
+#include <koda/coders/rans/rans_encoder.hpp>
+#include <koda/coders/rans/rans_table.hpp>
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/tests/tests.hpp>
+#include <koda/utils/formatted_exception.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cinttypes>
+#include <cmath>
+
+static_assert(
+    koda::SizeAwareEncoder<koda::RansEncoder<uint8_t, size_t>, uint8_t>);
+
+static_assert(koda::SizeAwareEncoder<koda::RansEncoder<uint32_t, size_t, 16>,
+                                     uint32_t>);
+
+static constexpr std::vector<bool> StateBits(uint32_t state) {
+    std::vector<bool> bits;
+    for (size_t i = 0; i < 32; ++i) {
+        bits.push_back((state >> i) & 1);
+    }
+    return bits;
+}
+
+BeginConstexprTest(RansEncoderTest, SingleToken) {
+    const koda::Map<char, size_t> kCounter = {{{'a', 5}}};
+    koda::RansTable table{kCounter};
+    koda::RansEncoder encoder{table};
+
+    std::string sequence = "aaaaa";
+    std::vector<bool> stream;
+
+    encoder(sequence, stream | koda::views::InsertFromBack);
+
+    // State never leaves its initial value
+    ConstexprAssertEqual(stream, StateBits(uint32_t{1} << 24));
+}
+EndConstexprTest;
+
+BeginConstexprTest(RansEncoderTest, GeometricDistribution) {
+    const koda::Map<char, size_t> kCounter = {{{'a', 1}, {'b', 3}}};
+    koda::RansTable table{kCounter, 2};
+    koda::RansEncoder encoder{table};
+
+    std::string sequence = "ab";
+    std::vector<bool> stream;
+
+    encoder(sequence, stream | koda::views::InsertFromBack);
+
+    // 2^24 -> 2^26 -> ((2^26 / 3) << 2) + 2^26 % 3 + 1
+    ConstexprAssertEqual(stream, StateBits(89478486));
+}
+EndConstexprTest;
+
+BeginConstexprTest(RansEncoderTest, TokenBitSize) {
+    const koda::Map<char, size_t> kCounter = {{{'a', 2}, {'b', 4}, {'c', 10}}};
+    koda::RansTable table{kCounter, 4};
+    koda::RansEncoder encoder{table};
+
+    ConstexprAssertEqual(encoder.TokenBitSize('a'), 3.f);
+    ConstexprAssertEqual(encoder.TokenBitSize('b'), 2.f);
+    ConstexprAssertTrue(std::abs(encoder.TokenBitSize('c') - 0.678072f) <
+                        1e-5f);
+}
+EndConstexprTest;
+
+// Exceptions cannot be thrown during the constant evaluation until
+// https://wg21.link/P3068R6 is implemented, hence the runtime test
+TEST(RansEncoderTest, UnknownToken) {
+    const koda::Map<char, size_t> kCounter = {{{'a', 2}, {'b', 2}}};
+    koda::RansTable table{kCounter};
+    koda::RansEncoder encoder{table};
+
+    std::string sequence = "abc";
+    std::vector<bool> stream;
+
+    EXPECT_THROW(encoder(sequence, stream | koda::views::InsertFromBack),
+                 koda::FormattedException);
+}
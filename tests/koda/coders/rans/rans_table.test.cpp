@@ -0,0 +1,49 @@
+#include <koda/coders/rans/rans_table.hpp>
+#include <koda/tests/tests.hpp>
+#include <koda/utils/formatted_exception.hpp>
+
+#include <gtest/gtest.h>
+
+BeginConstexprTest(RansTableTest, Normalization) {
+    const koda::Map<char, size_t> kCounter = {{{'a', 2}, {'b', 4}, {'c', 8}}};
+
+    // Rounding remainder goes to the most frequent token
+    const koda::Map<char, size_t> kExpected = {
+        {{'a', 2}, {'b', 4}, {'c', 10}}};
+
+    koda::RansTable table{kCounter, 4};
+
+    ConstexprAssertEqual(table.frequencies(), kExpected);
+    ConstexprAssertEqual(table.precision(), 4);
+    ConstexprAssertEqual(table.total_frequency(), 16);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RansTableTest, RareTokensKeepSlot) {
+    const koda::Map<char, size_t> kCounter = {
+        {{'a', 1}, {'b', 1}, {'c', 1000}}};
+
+    const koda::Map<char, size_t> kExpected = {{{'a', 1}, {'b', 1}, {'c', 2}}};
+
+    koda::RansTable table{kCounter, 2};
+
+    ConstexprAssertEqual(table.frequencies(), kExpected);
+}
+EndConstexprTest;
+
+TEST(RansTableTest, InvalidParameters) {
+    const koda::Map<char, size_t> kCounter = {{{'a', 1}, {'b', 1}, {'c', 1}}};
+
+    EXPECT_THROW(static_cast<void>(koda::RansTable(kCounter, 1)),
+                 koda::FormattedException);
+    EXPECT_THROW(static_cast<void>(koda::RansTable(kCounter, 17)),
+                 koda::FormattedException);
+    EXPECT_THROW(static_cast<void>(koda::RansTable(koda::Map<char, size_t>{})),
+                 koda::FormattedException);
+    // Precision exceeding the count type
+    EXPECT_THROW(static_cast<void>(koda::RansTable(
+                     koda::Map<char, uint8_t>{{{'a', 1}, {'b', 1}}}, 8)),
+                 koda::FormattedException);
+    EXPECT_NO_THROW(static_cast<void>(koda::RansTable(
+        koda::Map<char, uint8_t>{{{'a', 1}, {'b', 1}}}, 7)));
+}
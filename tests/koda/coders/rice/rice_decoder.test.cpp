@@ -120,3 +120,72 @@ BeginConstexprTest(RiceDecoderTest, PartialOutputDecoding) {
     ConstexprAssertEqual(result, kInput);
 }
 EndConstexprTest;
+
+BeginConstexprTest(RiceDecoderTest, AdaptivePartitions) {
+    const std::vector<bool> kStream = {
+        0, 0, 0,                // order 0
+        0, 1,                   // 1
+        0, 0, 1,                // 2
+        1, 0, 1,                // order 5
+        0, 1, 0, 1, 0, 0, 0,    // 40
+        0, 1, 1, 0, 0, 1, 0,    // 50
+        1, 0, 0,                // order 1, shorter last partition
+        0, 1, 1                 // 3
+    };
+    const std::vector<uint8_t> kExpected{{1, 2, 40, 50, 3}};
+    std::vector<uint8_t> result;
+
+    koda::RiceDecoder<uint8_t> decoder{koda::RicePartitioning{2}};
+
+    decoder(kExpected.size(), kStream, result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(result, kExpected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RiceDecoderTest, AdaptivePartialInput) {
+    std::vector<uint16_t> input;
+    for (uint16_t i = 0; i < 100; ++i) {
+        input.push_back(i < 50 ? i % 3 : i * 37);
+    }
+    std::vector<bool> stream;
+    std::vector<uint16_t> result;
+
+    koda::RiceEncoder<uint16_t> encoder{koda::RicePartitioning{16}};
+
+    encoder(input, stream | koda::views::InsertFromBack);
+
+    koda::RiceDecoder<uint16_t> decoder{koda::RicePartitioning{16}};
+
+    // Input ends in the middle of the first partition header
+    decoder.Decode(stream | koda::views::Take(2),
+                   result | koda::views::InsertFromBack);
+
+    ConstexprAssertTrue(result.empty());
+
+    decoder(input.size(), stream | std::views::drop(2),
+            result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(result, input);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RiceDecoderTest, BackwardAdaptivePartitions) {
+    const std::vector<bool> kStream = {
+        0, 0, 0, 1,        // 3, order 0 in the first partition
+        0, 0, 0, 0, 0, 1,  // 5
+        1, 1,              // 1, order 1 selected for 3 and 5
+        0, 1, 0,           // 2
+        1                  // 0, order 0 selected for 1 and 2
+    };
+    const std::vector<uint8_t> kExpected{{3, 5, 1, 2, 0}};
+    std::vector<uint8_t> result;
+
+    koda::RiceDecoder<uint8_t> decoder{
+        koda::RicePartitioning{2, koda::RiceAdaptation::kBackward}};
+
+    decoder(kExpected.size(), kStream, result | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(result, kExpected);
+}
+EndConstexprTest;
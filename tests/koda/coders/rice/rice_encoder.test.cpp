@@ -126,3 +126,94 @@ BeginConstexprTest(RiceEncoderTest, PartialOutputEncoding) {
     ConstexprAssertEqual(stream, kExpected);
 }
 EndConstexprTest;
+
+BeginConstexprTest(RiceEncoderTest, SelectOrder) {
+    const std::vector<uint8_t> kSmall{{1, 2}};
+    const std::vector<uint8_t> kMedium{{40, 50}};
+    const std::vector<uint8_t> kLarge{{255, 255}};
+
+    ConstexprAssertEqual(koda::SelectRiceOrder<uint8_t>(kSmall), 0);
+    ConstexprAssertEqual(koda::SelectRiceOrder<uint8_t>(kMedium), 5);
+    ConstexprAssertEqual(koda::SelectRiceOrder<uint8_t>(kLarge), 7);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RiceEncoderTest, AdaptivePartitions) {
+    const std::vector<uint8_t> kInput{{1, 2, 40, 50, 3}};
+    const std::vector<bool> kExpected = {
+        0, 0, 0,                // order 0
+        0, 1,                   // 1
+        0, 0, 1,                // 2
+        1, 0, 1,                // order 5
+        0, 1, 0, 1, 0, 0, 0,    // 40
+        0, 1, 1, 0, 0, 1, 0,    // 50
+        1, 0, 0,                // order 1, shorter last partition
+        0, 1, 1                 // 3
+    };
+    std::vector<bool> stream;
+
+    koda::RiceEncoder<uint8_t> encoder{koda::RicePartitioning{2}};
+
+    encoder(kInput, stream | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(stream, kExpected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RiceEncoderTest, AdaptivePartialOutput) {
+    const std::vector<uint8_t> kInput{{1, 2, 40, 50, 3}};
+    std::vector<bool> expected;
+    std::vector<bool> stream;
+
+    koda::RiceEncoder<uint8_t> encoder{koda::RicePartitioning{2}};
+    encoder(kInput, expected | koda::views::InsertFromBack);
+
+    koda::RiceEncoder<uint8_t> bounded_encoder{koda::RicePartitioning{2}};
+
+    // Partition is emitted only when complete, the output ends inside it
+    auto [in_1, _] = bounded_encoder.Encode(
+        kInput, stream | koda::views::InsertFromBack | koda::views::Take(4));
+
+    ConstexprAssertEqual(stream, expected | koda::views::Take(4));
+
+    bounded_encoder(std::move(in_1), stream | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(stream, expected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RiceEncoderTest, BackwardAdaptivePartitions) {
+    const std::vector<uint8_t> kInput{{3, 5, 1, 2, 0}};
+    const std::vector<bool> kExpected = {
+        0, 0, 0, 1,        // 3, order 0 in the first partition
+        0, 0, 0, 0, 0, 1,  // 5
+        1, 1,              // 1, order 1 selected for 3 and 5
+        0, 1, 0,           // 2
+        1                  // 0, order 0 selected for 1 and 2
+    };
+    std::vector<bool> stream;
+
+    koda::RiceEncoder<uint8_t> encoder{
+        koda::RicePartitioning{2, koda::RiceAdaptation::kBackward}};
+
+    encoder(kInput, stream | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(stream, kExpected);
+    // Last partition is still being encoded with order 0
+    ConstexprAssertEqual(encoder.TokenBitSize(4), 5.f);
+}
+EndConstexprTest;
+
+BeginConstexprTest(RiceEncoderTest, AdaptiveTokenBitSize) {
+    std::vector<bool> stream;
+
+    koda::RiceEncoder<uint8_t> encoder{koda::RicePartitioning{2}};
+
+    encoder.Encode(std::vector<uint8_t>{{40}},
+                   stream | koda::views::InsertFromBack);
+
+    // Partition of 40 and 50 is encoded with order 5, its 3 bit header is
+    // split between both tokens
+    ConstexprAssertEqual(encoder.TokenBitSize(50), 8.5f);
+}
+EndConstexprTest;
@@ -3,6 +3,7 @@
 #include <koda/coders/tans/tans_table.hpp>
 #include <koda/ranges/back_inserter_iterator.hpp>
 #include <koda/ranges/bit_iterator.hpp>
+#include <koda/ranges/word_bit_iterator.hpp>
 #include <koda/tests/tests.hpp>
 #include <koda/utils/counter.hpp>
 
@@ -34,3 +35,81 @@ BeginConstexprTest(TansTest, NormalTest) {
     ConstexprAssertEqual(sequence, reconstruction | std::views::reverse);
 }
 EndConstexprTest;
+
+BeginConstexprTest(TansTest, TwoInterleavedStates) {
+    std::string sequence{kTestString};
+    koda::TansInitTable table{koda::Counter{kTestString}.counted(), 0, 1, 512};
+
+    koda::TansEncoder<char, size_t, size_t, 2> encoder{table};
+    koda::TansDecoder<char, size_t, size_t, 2> decoder{table};
+
+    std::vector<bool> stream;
+    std::string reconstruction;
+
+    encoder(sequence, stream | koda::views::InsertFromBack);
+
+    decoder(sequence.size(), stream | std::views::reverse,
+            reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(sequence, reconstruction | std::views::reverse);
+}
+EndConstexprTest;
+
+BeginConstexprTest(TansTest, FourInterleavedStatesPartialOutput) {
+    std::string sequence{kTestString};
+    koda::TansInitTable table{koda::Counter{kTestString}.counted(), 0, 1, 512};
+
+    koda::TansEncoder<char, size_t, size_t, 4> encoder{table};
+    koda::TansDecoder<char, size_t, size_t, 4> decoder{table};
+
+    std::vector<bool> stream;
+    std::string reconstruction;
+
+    encoder(sequence, stream | koda::views::InsertFromBack);
+
+    // Stream is encoded twice by bounded outputs to check flushing resumption
+    std::vector<bool> bounded;
+    koda::TansEncoder<char, size_t, size_t, 4> bounded_encoder{table};
+    bounded_encoder.Encode(sequence, bounded | koda::views::InsertFromBack);
+    bounded_encoder.Flush(bounded | koda::views::InsertFromBack |
+                          koda::views::Take(5));
+    bounded_encoder.Flush(bounded | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(bounded, stream);
+
+    auto [istream, _] =
+        decoder.DecodeN(101, stream | std::views::reverse,
+                        reconstruction | koda::views::InsertFromBack);
+
+    decoder.DecodeN(sequence.size() - 101, std::move(istream),
+                    reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(sequence, reconstruction | std::views::reverse);
+}
+EndConstexprTest;
+
+BeginConstexprTest(TansTest, BufferedBackwardInput) {
+    std::string sequence{kTestString};
+    koda::TansInitTable table{koda::Counter{kTestString}.counted(), 0, 1, 512};
+
+    koda::TansEncoder<char, size_t, size_t, 2> encoder{table};
+    koda::TansDecoder<char, size_t, size_t, 2> decoder{table};
+
+    std::vector<bool> stream;
+    std::string reconstruction;
+
+    encoder(sequence, stream | koda::views::InsertFromBack);
+
+    std::vector<uint8_t> bytes((stream.size() + 7) / 8);
+    for (size_t i = 0; i < stream.size(); ++i) {
+        bytes[i / 8] |= static_cast<uint8_t>(stream[i]) << (i % 8);
+    }
+    const size_t padding = bytes.size() * 8 - stream.size();
+
+    decoder(sequence.size(),
+            koda::ranges::BackwardWordInputView{bytes, padding},
+            reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(sequence, reconstruction | std::views::reverse);
+}
+EndConstexprTest;
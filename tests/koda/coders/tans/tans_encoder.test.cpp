@@ -3,6 +3,9 @@
 #include <koda/ranges/back_inserter_iterator.hpp>
 #include <koda/ranges/bit_iterator.hpp>
 #include <koda/tests/tests.hpp>
+#include <koda/utils/formatted_exception.hpp>
+
+#include <gtest/gtest.h>
 
 #include <cinttypes>
 
@@ -146,3 +149,17 @@ BeginConstexprTest(TansEncoderTest, RandomDistribution) {
     ConstexprAssertEqual(stream, kExpected);
 }
 EndConstexprTest;
+
+// Exceptions cannot be thrown during the constant evaluation until
+// https://wg21.link/P3068R6 is implemented, hence the runtime test
+TEST(TansEncoderTest, UnknownToken) {
+    const koda::Map<char, size_t> kCounter = {{{'a', 2}, {'b', 2}}};
+    koda::TansInitTable table{kCounter};
+    koda::TansEncoder encoder{table};
+
+    std::string sequence = "abc";
+    std::vector<bool> stream;
+
+    EXPECT_THROW(encoder(sequence, stream | koda::views::InsertFromBack),
+                 koda::FormattedException);
+}
@@ -3,10 +3,16 @@
 #include <koda/coders/uniform/uniform_encoder.hpp>
 #include <koda/ranges/back_inserter_iterator.hpp>
 #include <koda/ranges/bit_iterator.hpp>
+#include <koda/ranges/word_bit_iterator.hpp>
 #include <koda/tests/tests.hpp>
+#include <koda/utils/utils.hpp>
+
+#include <gtest/gtest.h>
 
 #include <bitset>
+#include <initializer_list>
 #include <iterator>
+#include <type_traits>
 #include <vector>
 
 static_assert(koda::Decoder<koda::UniformDecoder<uint8_t>, uint8_t>);
@@ -25,6 +31,38 @@ constexpr std::vector<uint8_t> Encode(const std::vector<Tp>& expected) {
     return target;
 }
 
+template <typename Token>
+void ExpectUnpackedBlocksMatchInput(
+    std::initializer_list<size_t> token_bit_sizes) {
+    std::vector<Token> source;
+    for (uint64_t i = 0; i < 300; ++i) {
+        source.push_back(static_cast<Token>(i * 0x9E3779B97F4A7C15));
+    }
+
+    for (size_t token_bit_size : token_bit_sizes) {
+        std::vector<uint8_t> encoded;
+        koda::UniformEncoder<Token> encoder{token_bit_size};
+        encoder(source, encoded | koda::views::InsertFromBack |
+                            koda::views::LittleEndianOutput)
+            .output_range.begin()
+            .Flush();
+
+        std::vector<Token> expected;
+        for (const Token token : source) {
+            expected.push_back(static_cast<Token>(
+                static_cast<std::make_unsigned_t<Token>>(token) &
+                koda::LowBitsMask<uint64_t>(token_bit_size)));
+        }
+
+        koda::UniformDecoder<Token> decoder{token_bit_size};
+        std::vector<Token> reconstruction(source.size());
+        decoder.Decode(encoded | koda::views::LittleEndianWordInput,
+                       reconstruction);
+
+        EXPECT_EQ(reconstruction, expected) << token_bit_size;
+    }
+}
+
 }  // namespace
 
 BeginConstexprTest(UniformDecoderTest, DecodeBytes) {
@@ -110,3 +148,64 @@ BeginConstexprTest(UniformDecoderTest, PartialOutputDecoding) {
     ConstexprAssertEqual(result, kExpected);
 }
 EndConstexprTest;
+
+BeginConstexprTest(UniformDecoderTest, BufferedPartialInputDecoding) {
+    const std::vector<uint16_t> expected{{0x4332, 0x1245, 0x9832, 0x5623}};
+    auto encoded = Encode(expected);
+
+    koda::UniformDecoder<uint16_t> decoder;
+
+    std::vector<uint16_t> reconstruction;
+
+    auto [istream, _] =
+        decoder.DecodeN(2, encoded | koda::views::LittleEndianWordInput,
+                        reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(expected | koda::views::Take(2), reconstruction);
+    ConstexprAssertEqual(std::ranges::begin(istream).Available(), 32);
+
+    decoder.Decode(std::move(istream),
+                   reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(expected, reconstruction);
+}
+EndConstexprTest;
+
+BeginConstexprTest(UniformDecoderTest, UnpackedWordsPartialOutput) {
+    std::vector<uint16_t> expected;
+    for (uint16_t i = 0; i < 50; ++i) {
+        expected.push_back(static_cast<uint16_t>((i * 113 + 7) & 0x1FF));
+    }
+
+    std::vector<uint8_t> encoded;
+    koda::UniformEncoder<uint16_t> encoder{9};
+    encoder(expected, encoded | koda::views::InsertFromBack |
+                          koda::views::LittleEndianOutput);
+
+    koda::UniformDecoder<uint16_t> decoder{9};
+
+    std::vector<uint16_t> reconstruction;
+
+    auto [istream, _] =
+        decoder.DecodeN(7, encoded | koda::views::LittleEndianWordInput,
+                        reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(expected | koda::views::Take(7), reconstruction);
+    ConstexprAssertEqual(std::ranges::begin(istream).Available(),
+                         encoded.size() * 8 - 63);
+
+    decoder.DecodeN(expected.size() - 7, std::move(istream),
+                    reconstruction | koda::views::InsertFromBack);
+
+    ConstexprAssertEqual(expected, reconstruction);
+}
+EndConstexprTest;
+
+// Blocks of the contiguous output are unpacked with the vector kernels only
+// outside of the constant evaluation
+TEST(UniformDecoderTest, UnpackedBlocksMatchInput) {
+    ExpectUnpackedBlocksMatchInput<uint8_t>({1, 3, 8});
+    ExpectUnpackedBlocksMatchInput<int16_t>({5, 11, 16});
+    ExpectUnpackedBlocksMatchInput<uint32_t>({1, 7, 10, 17, 31, 32});
+    ExpectUnpackedBlocksMatchInput<uint64_t>({33, 47, 64});
+}
@@ -5,7 +5,10 @@
 #include <koda/ranges/bit_iterator.hpp>
 #include <koda/tests/tests.hpp>
 
+#include <gtest/gtest.h>
+
 #include <bitset>
+#include <initializer_list>
 #include <iterator>
 #include <vector>
 
@@ -140,3 +143,69 @@ BeginConstexprTest(UniformEncoderTest, PartialOutputEncoding) {
     ConstexprAssertEqual(stream, kExpected);
 }
 EndConstexprTest;
+
+BeginConstexprTest(UniformEncoderTest, PackedWordsMatchBitStream) {
+    std::vector<uint16_t> source;
+    for (uint16_t i = 0; i < 100; ++i) {
+        source.push_back(static_cast<uint16_t>(i * 37 + 5));
+    }
+
+    koda::UniformEncoder<uint16_t> bit_encoder{11};
+    std::vector<bool> bits;
+    bit_encoder(source, bits | koda::views::InsertFromBack);
+
+    koda::UniformEncoder<uint16_t> word_encoder{11};
+    std::vector<uint8_t> target;
+    word_encoder(source, target | koda::views::InsertFromBack |
+                             koda::views::LittleEndianOutput);
+
+    auto expected = target | koda::views::LittleEndianInput |
+                    koda::views::Take(bits.size()) |
+                    std::ranges::to<std::vector<bool>>();
+
+    ConstexprAssertEqual(target.size(), (bits.size() + 7) / 8);
+    ConstexprAssertEqual(bits, expected);
+}
+EndConstexprTest;
+
+namespace {
+
+template <typename Token>
+void ExpectPackedBlocksMatchBitStream(
+    std::initializer_list<size_t> token_bit_sizes) {
+    std::vector<Token> source;
+    for (uint64_t i = 0; i < 300; ++i) {
+        source.push_back(static_cast<Token>(i * 0x9E3779B97F4A7C15));
+    }
+
+    for (size_t token_bit_size : token_bit_sizes) {
+        koda::UniformEncoder<Token> bit_encoder{token_bit_size};
+        std::vector<bool> bits;
+        bit_encoder(source, bits | koda::views::InsertFromBack);
+
+        koda::UniformEncoder<Token> block_encoder{token_bit_size};
+        std::vector<uint8_t> target;
+        block_encoder(source, target | koda::views::InsertFromBack |
+                                  koda::views::LittleEndianOutput)
+            .output_range.begin()
+            .Flush();
+
+        auto expected = target | koda::views::LittleEndianInput |
+                        koda::views::Take(bits.size()) |
+                        std::ranges::to<std::vector<bool>>();
+
+        EXPECT_EQ(target.size(), (bits.size() + 7) / 8) << token_bit_size;
+        EXPECT_EQ(bits, expected) << token_bit_size;
+    }
+}
+
+}  // namespace
+
+// Blocks of the contiguous input are packed with the vector kernels only
+// outside of the constant evaluation
+TEST(UniformEncoderTest, PackedBlocksMatchBitStream) {
+    ExpectPackedBlocksMatchBitStream<uint8_t>({1, 3, 8});
+    ExpectPackedBlocksMatchBitStream<int16_t>({5, 11, 16});
+    ExpectPackedBlocksMatchBitStream<uint32_t>({1, 7, 10, 17, 31, 32});
+    ExpectPackedBlocksMatchBitStream<uint64_t>({33, 47, 64});
+}
@@ -32,6 +32,14 @@ BeginConstexprTest(FusedDictionaryAndBufferTest, Creation) {
 
     ConstexprAssertEqual(dict.get_buffer(), kBufferView);
     ConstexprAssertEqual(dict.get_oldest_dictionary_full_match(), kBufferView);
+    // Default cyclic buffer is four times the dictionary and the buffer
+    ConstexprAssertEqual(dict.retained_size(),
+                         3 * kDictSize + 2 * kBuffer.size() + 1);
+
+    koda::FusedDictionaryAndBuffer<uint8_t> smallest{
+        kDictSize, kBufferView, kDictSize + 2 * kBuffer.size() - 1};
+
+    ConstexprAssertEqual(smallest.retained_size(), 0);
 }
 EndConstexprTest;
 
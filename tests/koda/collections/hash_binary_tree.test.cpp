@@ -0,0 +1,118 @@
+#include <koda/collections/hash_binary_tree.hpp>
+#include <koda/tests/tests.hpp>
+#include <koda/tests/viewable_vector.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace koda::tests;
+
+static_assert(koda::MatchFinder<koda::HashBinaryTree<uint8_t>, uint8_t>);
+
+namespace {
+
+template <size_t Window, size_t Length>
+    requires(Length >= Window)
+constexpr std::array<ViewableVector<uint8_t>, Length - Window>
+BuildSamplesFromString(const char (&sentence)[Length]) {
+    std::array<ViewableVector<uint8_t>, Length - Window> result;
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = ConvertToString(
+            std::ranges::subrange{&sentence[i], &sentence[i + Window]});
+    }
+    return result;
+}
+
+template <size_t Size>
+constexpr auto MakeSamples() {
+    return BuildSamplesFromString<Size>("ala ma kota a kot ma ale");
+}
+
+}  // namespace
+
+BeginConstexprTest(HashBinaryTreeTest, Creation) {
+    auto vector = MakeSamples<5>();
+    koda::HashBinaryTree<uint8_t> tree{5};
+
+    for (auto const& element : vector) {
+        tree.AddString(element);
+    }
+
+    for (auto const& element : vector) {
+        ConstexprAssertEqual(tree.FindMatch(element).match_length, 5);
+    }
+
+    ConstexprAssertEqual(tree.size(), vector.size());
+    ConstexprAssertTrue(tree.FindMatch("ab"_u8));
+    ConstexprAssertFalse(tree.FindMatch("xyzow"_u8));
+    ConstexprAssertFalse(tree.FindMatch("xyzo"_u8));
+    ConstexprAssertFalse(tree.FindMatch("x"_u8));
+}
+EndConstexprTest;
+
+BeginConstexprTest(HashBinaryTreeTest, LongestMatch) {
+    using Marker = koda::HashBinaryTree<uint8_t>::RepeatitionMarker;
+
+    auto vector = MakeSamples<5>();
+    koda::HashBinaryTree<uint8_t> tree{5};
+
+    for (auto const& element : vector) {
+        tree.AddString(element);
+    }
+
+    ConstexprAssertEqual(tree.FindMatch("kota "_u8), Marker(7, 5));
+    ConstexprAssertEqual(tree.FindMatch("kot m"_u8), Marker(14, 5));
+    ConstexprAssertEqual(tree.FindMatch("kot a"_u8), Marker(14, 4));
+    ConstexprAssertEqual(tree.FindMatch(" ma k"_u8), Marker(3, 5));
+    ConstexprAssertEqual(tree.FindMatch(" ma x"_u8).match_length, 4);
+}
+EndConstexprTest;
+
+BeginConstexprTest(HashBinaryTreeTest, SlidingWindow) {
+    using Marker = koda::HashBinaryTree<uint8_t>::RepeatitionMarker;
+
+    auto vector = MakeSamples<5>();
+    koda::HashBinaryTree<uint8_t> tree{5};
+
+    // Only the last eight strings are kept in the window, the older nodes
+    // are cut off lazily
+    for (size_t i = 0; i < vector.size(); ++i) {
+        if (tree.size() == 8) {
+            ConstexprAssertTrue(tree.RemoveString(vector[i - 8]));
+        }
+        tree.AddString(vector[i]);
+    }
+
+    ConstexprAssertEqual(tree.size(), 8);
+    ConstexprAssertEqual(tree.FindMatch("kot m"_u8), Marker(2, 5));
+    ConstexprAssertFalse(tree.FindMatch("kota "_u8));
+    ConstexprAssertFalse(tree.FindMatch("ala m"_u8));
+
+    for (size_t i = 12; i < vector.size(); ++i) {
+        ConstexprAssertTrue(tree.RemoveString(vector[i]));
+    }
+    ConstexprAssertFalse(tree.RemoveString(vector[0]));
+    ConstexprAssertFalse(tree.FindMatch("kot m"_u8));
+}
+EndConstexprTest;
+
+BeginConstexprTest(HashBinaryTreeTest, SearchDepth) {
+    const std::vector<uint8_t> kSequence{{7, 7, 7, 7, 1, 7, 7, 7, 7, 2,
+                                          7, 7, 7, 7, 3, 7, 7, 7, 7, 4}};
+    std::vector<ViewableVector<uint8_t>> strings;
+    for (size_t i = 0; i + 5 <= kSequence.size(); i += 5) {
+        strings.push_back(ConvertToString(
+            std::ranges::subrange{&kSequence[i], &kSequence[i + 5]}));
+    }
+
+    koda::HashBinaryTree<uint8_t> tree{5};
+    for (auto const& string : strings) {
+        tree.AddString(string);
+    }
+    ConstexprAssertEqual(tree.FindMatch(strings[0]).match_length, 5);
+
+    tree.set_max_search_depth(1);
+    ConstexprAssertEqual(tree.max_search_depth(), 1);
+    ConstexprAssertEqual(tree.FindMatch(strings[0]).match_length, 4);
+}
+EndConstexprTest;
@@ -0,0 +1,152 @@
+#include <koda/collections/hash_chain.hpp>
+#include <koda/collections/search_binary_tree.hpp>
+#include <koda/tests/tests.hpp>
+#include <koda/tests/viewable_vector.hpp>
+
+#include <array>
+#include <vector>
+
+using namespace koda::tests;
+
+static_assert(koda::MatchFinder<koda::HashChain<uint8_t>, uint8_t>);
+static_assert(koda::MatchFinder<koda::SearchBinaryTree<uint8_t>, uint8_t>);
+
+namespace {
+
+template <size_t Window, size_t Length>
+    requires(Length >= Window)
+constexpr std::array<ViewableVector<uint8_t>, Length - Window>
+BuildSamplesFromString(const char (&sentence)[Length]) {
+    std::array<ViewableVector<uint8_t>, Length - Window> result;
+    for (size_t i = 0; i < result.size(); ++i) {
+        result[i] = ConvertToString(
+            std::ranges::subrange{&sentence[i], &sentence[i + Window]});
+    }
+    return result;
+}
+
+template <size_t Size>
+constexpr auto MakeSamples() {
+    return BuildSamplesFromString<Size>("ala ma kota a kot ma ale");
+}
+
+}  // namespace
+
+BeginConstexprTest(HashChainTest, Creation) {
+    auto vector = MakeSamples<4>();
+    koda::HashChain<uint8_t> chain{4};
+
+    for (auto const& element : vector) {
+        chain.AddString(element);
+    }
+
+    for (auto const& element : vector) {
+        ConstexprAssertEqual(chain.FindMatch(element).match_length, 4);
+    }
+
+    ConstexprAssertEqual(chain.size(), vector.size());
+    ConstexprAssertTrue(chain.FindMatch("ab"_u8));
+    ConstexprAssertTrue(chain.FindMatch("a"_u8));
+    ConstexprAssertFalse(chain.FindMatch("xyzo"_u8));
+    ConstexprAssertFalse(chain.FindMatch("xyz"_u8));
+    ConstexprAssertFalse(chain.FindMatch("x"_u8));
+}
+EndConstexprTest;
+
+BeginConstexprTest(HashChainTest, NewestMatch) {
+    using Marker = koda::HashChain<uint8_t>::RepeatitionMarker;
+
+    auto vector = MakeSamples<4>();
+    koda::HashChain<uint8_t> chain{4};
+
+    for (auto const& element : vector) {
+        chain.AddString(element);
+    }
+
+    // Among the equally long matches the nearest one is chosen
+    ConstexprAssertEqual(chain.FindMatch("ala"_u8), Marker(0, 3));
+    ConstexprAssertEqual(chain.FindMatch(" ale"_u8), Marker(20, 4));
+    ConstexprAssertEqual(chain.FindMatch("kot"_u8), Marker(14, 3));
+    ConstexprAssertEqual(chain.FindMatch("kota"_u8), Marker(7, 4));
+    ConstexprAssertEqual(chain.FindMatch(" ma"_u8), Marker(17, 3));
+    ConstexprAssertEqual(chain.FindMatch("al"_u8), Marker(0, 2));
+}
+EndConstexprTest;
+
+BeginConstexprTest(HashChainTest, Removal) {
+    using Marker = koda::HashChain<uint8_t>::RepeatitionMarker;
+
+    auto vector = MakeSamples<4>();
+    koda::HashChain<uint8_t> chain{4};
+
+    for (auto const& element : vector) {
+        chain.AddString(element);
+    }
+
+    for (size_t i = 0; i < 8; ++i) {
+        ConstexprAssertTrue(chain.RemoveString(vector[i]));
+    }
+
+    // Positions are relative to the oldest string left in the chain
+    ConstexprAssertEqual(chain.size(), vector.size() - 8);
+    ConstexprAssertEqual(chain.FindMatch("kota"_u8), Marker(6, 3));
+    ConstexprAssertEqual(chain.FindMatch("kot "_u8), Marker(6, 4));
+
+    for (size_t i = 8; i < vector.size(); ++i) {
+        ConstexprAssertTrue(chain.RemoveString(vector[i]));
+    }
+
+    for (auto const& element : vector) {
+        ConstexprAssertFalse(chain.RemoveString(element));
+        ConstexprAssertFalse(chain.FindMatch(element));
+    }
+}
+EndConstexprTest;
+
+BeginConstexprTest(HashChainTest, SlidingWindow) {
+    const std::vector<uint8_t> kSequence{
+        {1, 2, 3, 4, 1, 2, 3, 5, 1, 2, 3, 4, 1, 2, 3, 5, 1, 2, 3, 4}};
+    std::vector<ViewableVector<uint8_t>> strings;
+    for (size_t i = 0; i + 4 <= kSequence.size(); ++i) {
+        strings.push_back(ConvertToString(
+            std::ranges::subrange{&kSequence[i], &kSequence[i + 4]}));
+    }
+
+    // Window is smaller than the number of added strings so the chain links
+    // wrap around the circular array
+    koda::HashChain<uint8_t> chain{4};
+    for (size_t i = 0; i < strings.size(); ++i) {
+        if (chain.size() == 6) {
+            ConstexprAssertTrue(chain.RemoveString(strings[i - 6]));
+        }
+        chain.AddString(strings[i]);
+    }
+
+    ConstexprAssertEqual(chain.size(), 6);
+    const auto match = chain.FindMatch(strings[4]);
+    ConstexprAssertEqual(match.match_length, 4);
+    ConstexprAssertEqual(match.match_position, 1);
+}
+EndConstexprTest;
+
+BeginConstexprTest(HashChainTest, ChainDepth) {
+    const std::vector<uint8_t> kSequence{{7, 7, 7, 1, 7, 7, 7, 2, 7, 7, 7, 3,
+                                          7, 7, 7, 4, 7, 7, 7, 5}};
+    std::vector<ViewableVector<uint8_t>> strings;
+    for (size_t i = 0; i + 4 <= kSequence.size(); i += 4) {
+        strings.push_back(ConvertToString(
+            std::ranges::subrange{&kSequence[i], &kSequence[i + 4]}));
+    }
+
+    koda::HashChain<uint8_t> chain{4, 2};
+    for (auto const& string : strings) {
+        chain.AddString(string);
+    }
+
+    // Only the two newest strings of the chain are visited
+    ConstexprAssertEqual(chain.FindMatch(strings[0]).match_length, 3);
+
+    chain.set_max_chain_depth(strings.size());
+    ConstexprAssertEqual(chain.FindMatch(strings[0]).match_length, 4);
+}
+EndConstexprTest;
@@ -105,3 +105,58 @@ BeginConstexprTest(SearchBinaryTreeTest, Removal) {
     }
 }
 EndConstexprTest;
+
+BeginConstexprTest(SearchBinaryTreeTest, IndexedLayout) {
+    constexpr size_t kWindow = 8;
+
+    auto vector = MakeSamples<4>();
+    koda::SearchBinaryTree<uint8_t> pointer_tree{4};
+    koda::SearchBinaryTree<uint8_t, std::allocator<uint8_t>,
+                           koda::RedBlackTreeLayout::kIndexed>
+        indexed_tree{4};
+    indexed_tree.reserve(kWindow);
+
+    for (size_t i = 0; i < vector.size(); ++i) {
+        if (i >= kWindow) {
+            ConstexprAssertTrue(pointer_tree.RemoveString(vector[i - kWindow]));
+            ConstexprAssertTrue(indexed_tree.RemoveString(vector[i - kWindow]));
+        }
+        ConstexprAssertEqual(indexed_tree.FindMatch(vector[i]),
+                             pointer_tree.FindMatch(vector[i]));
+        pointer_tree.AddString(vector[i]);
+        indexed_tree.AddString(vector[i]);
+    }
+
+    ConstexprAssertEqual(indexed_tree.size(), kWindow);
+    ConstexprAssertFalse(indexed_tree.RemoveString("xyzo"_u8));
+}
+EndConstexprTest;
+
+BeginConstexprTest(SearchBinaryTreeTest, LazyExpiry) {
+    constexpr size_t kWindow = 8;
+
+    auto vector = MakeSamples<4>();
+    koda::SearchBinaryTree<uint8_t> tree{4};
+    tree.set_expiry_period(3);
+
+    for (size_t i = 0; i < vector.size(); ++i) {
+        if (i >= kWindow) {
+            ConstexprAssertTrue(tree.RemoveString(vector[i - kWindow]));
+        }
+        tree.AddString(vector[i]);
+
+        // Expired strings are never reported even before they are pruned
+        const size_t start = i + 1 - tree.size();
+        for (size_t j = start; j <= i; ++j) {
+            const auto [position, length] = tree.FindMatch(vector[j]);
+            ConstexprAssertEqual(length, size_t{4});
+            ConstexprAssertTrue(position < tree.size());
+            ConstexprAssertTrue(vector[start + position] == vector[j]);
+        }
+    }
+
+    // "ala " appears only at the very beginning of the sentence
+    ConstexprAssertTrue(tree.FindMatch(vector[0]).match_length < 4);
+    ConstexprAssertEqual(tree.size(), kWindow);
+}
+EndConstexprTest;
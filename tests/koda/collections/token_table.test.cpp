@@ -0,0 +1,96 @@
+#include <koda/collections/token_table.hpp>
+#include <koda/tests/tests.hpp>
+
+#include <cinttypes>
+#include <string>
+#include <utility>
+
+static_assert(koda::TokenTable<uint8_t, int>::kCanBeDense);
+static_assert(koda::TokenTable<int16_t, int>::kCanBeDense);
+static_assert(koda::TokenTable<uint32_t, int>::kCanBeDense);
+static_assert(!koda::TokenTable<bool, int>::kCanBeDense);
+static_assert(!koda::TokenTable<std::string, int>::kCanBeDense);
+
+BeginConstexprTest(TokenTableTest, DenseTokens) {
+    koda::TokenTable<char, size_t> table{
+        std::vector<std::pair<char, size_t>>{{'a', 1}, {'z', 2}, {-5, 3}}};
+
+    ConstexprAssertTrue(table.is_dense());
+    ConstexprAssertTrue(table.Contains('a'));
+    ConstexprAssertTrue(table.Contains(-5));
+    ConstexprAssertFalse(table.Contains(-6));
+    ConstexprAssertFalse(table.Contains('z' + 1));
+    ConstexprAssertFalse(table.Contains('b'));
+    ConstexprAssertEqual(table.At('a'), 1);
+    ConstexprAssertEqual(table.At('z'), 2);
+    ConstexprAssertEqual(table.At(-5), 3);
+
+    table.Insert('b', 4);
+    ++table.At('a');
+    ++table['z'];
+
+    ConstexprAssertEqual(table.At('b'), 4);
+    ConstexprAssertEqual(table.At('a'), 2);
+    ConstexprAssertEqual(table['z'], 3);
+}
+EndConstexprTest;
+
+BeginConstexprTest(TokenTableTest, WideDenseTokens) {
+    koda::TokenTable<uint16_t, uint8_t> table;
+
+    table.Insert(0, 1);
+    table.Insert(0xFFFF, 2);
+
+    ConstexprAssertTrue(table.is_dense());
+    ConstexprAssertEqual(table.At(0), 1);
+    ConstexprAssertEqual(table.At(0xFFFF), 2);
+    ConstexprAssertFalse(table.Contains(0x7FFF));
+}
+EndConstexprTest;
+
+BeginConstexprTest(TokenTableTest, SparseTokens) {
+    koda::TokenTable<uint32_t, size_t> table{koda::Map<uint32_t, size_t>{
+        {1 << 20, 1}, {7, 2}, {0xFFFFFFFF, 3}}};
+
+    ConstexprAssertFalse(table.is_dense());
+    ConstexprAssertTrue(table.Contains(7));
+    ConstexprAssertFalse(table.Contains(8));
+    ConstexprAssertEqual(table.At(1 << 20), 1);
+    ConstexprAssertEqual(table.At(0xFFFFFFFF), 3);
+
+    table.Insert(7, 5);
+
+    ConstexprAssertEqual(table.At(7), 5);
+    ConstexprAssertEqual(table[7], 5);
+}
+EndConstexprTest;
+
+BeginConstexprTest(TokenTableTest, GrowingSpan) {
+    koda::TokenTable<int32_t, int> table;
+
+    table.Insert(100, 1);
+    table.Insert(90, 2);
+    table.Insert(110, 3);
+    table.Insert(-100, 4);
+
+    ConstexprAssertTrue(table.is_dense());
+    ConstexprAssertEqual(table.At(100), 1);
+    ConstexprAssertEqual(table.At(90), 2);
+    ConstexprAssertEqual(table[110], 3);
+    ConstexprAssertEqual(table[-100], 4);
+    ConstexprAssertFalse(table.Contains(0));
+    ConstexprAssertFalse(table.Contains(-101));
+    ConstexprAssertTrue(table.Find(111) == nullptr);
+
+    // Span reaching the limit moves the tokens to the sparse storage
+    table.Insert(-100 + koda::TokenTable<int32_t, int>::kMaxDenseSpan, 5);
+
+    ConstexprAssertFalse(table.is_dense());
+    ConstexprAssertEqual(table.At(100), 1);
+    ConstexprAssertEqual(table.At(90), 2);
+    ConstexprAssertEqual(table[110], 3);
+    ConstexprAssertEqual(table[-100], 4);
+    ConstexprAssertEqual(table.At(65436), 5);
+    ConstexprAssertFalse(table.Contains(0));
+}
+EndConstexprTest;
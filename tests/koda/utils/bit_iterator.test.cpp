@@ -113,3 +113,33 @@ BeginConstexprTest(BigEndianOutputBitIterIterTest, AppendBits) {
     ConstexprAssertEqual(result.front(), 0b10101101);
 }
 EndConstexprTest;
+
+BeginConstexprTest(LittleEndianOutputBitIterTest, WriteBits) {
+    std::vector<uint8_t> result;
+    koda::LittleEndianOutputBitIter iter{koda::BackInserterIterator{result}};
+
+    iter.WriteBits(0b101, 3);
+    ConstexprAssertEqual(iter.Position(), 3);
+    iter.WriteBits(0xFFFF'0AB6, 12);
+    ConstexprAssertEqual(iter.Position(), 7);
+    iter.Flush();
+
+    const std::vector<uint8_t> expected{{0b10110101, 0b01010101}};
+    ConstexprAssertEqual(result, expected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(WriteBitsTest, ResumesOnBoundedOutput) {
+    std::vector<uint8_t> result(1);
+    auto view = result | koda::views::LittleEndianOutput;
+
+    uint64_t value = 0b1100'0011'1010;
+    uint8_t count = 12;
+    auto iter = koda::WriteBits(view.begin(), view.end(), value, count);
+
+    ConstexprAssertEqual(iter, view.end());
+    ConstexprAssertEqual(count, 4);
+    ConstexprAssertEqual(value, 0b1100);
+    ConstexprAssertEqual(result.front(), 0b0011'1010);
+}
+EndConstexprTest;
@@ -0,0 +1,46 @@
+#include <koda/tests/tests.hpp>
+#include <koda/utils/utils.hpp>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <string_view>
+
+static constexpr std::string_view kPrefixString = "generalizing the ring";
+
+BeginConstexprTest(CommonPrefixLengthTest, ElementWise) {
+    std::string other{kPrefixString};
+    other[13] = 'T';
+
+    ConstexprAssertEqual(koda::CommonPrefixLength(kPrefixString.data(),
+                                                  other.data(), other.size()),
+                         13);
+    ConstexprAssertEqual(koda::CommonPrefixLength(kPrefixString.data(),
+                                                  other.data(), 13),
+                         13);
+}
+EndConstexprTest;
+
+// Whole words are compared only outside of the constant evaluation, hence
+// the runtime test
+TEST(CommonPrefixLengthTest, WordWise) {
+    static_assert(kPrefixString.size() > 16 && kPrefixString.size() % 8);
+
+    for (size_t mismatch = 0; mismatch < kPrefixString.size(); ++mismatch) {
+        std::string other{kPrefixString};
+        other[mismatch] ^= 0x20;
+
+        EXPECT_EQ(koda::CommonPrefixLength(kPrefixString.data(), other.data(),
+                                           other.size()),
+                  mismatch);
+        EXPECT_EQ(koda::CommonPrefixLength(kPrefixString.data(), other.data(),
+                                           mismatch),
+                  mismatch);
+    }
+
+    for (size_t length = 0; length <= kPrefixString.size(); ++length) {
+        EXPECT_EQ(koda::CommonPrefixLength(kPrefixString.data(),
+                                           kPrefixString.data(), length),
+                  length);
+    }
+}
@@ -0,0 +1,156 @@
+#include <koda/ranges/back_inserter_iterator.hpp>
+#include <koda/ranges/bit_iterator.hpp>
+#include <koda/ranges/word_bit_iterator.hpp>
+#include <koda/tests/tests.hpp>
+
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+static_assert(koda::BitWordOutputIterator<
+              koda::LittleEndianWordOutputBitIter<uint8_t*>>);
+
+BeginConstexprTest(LittleEndianWordOutputBitIterTest, AppendBits) {
+    std::vector<uint8_t> result;
+    koda::LittleEndianWordOutputBitIter iter{
+        koda::BackInserterIterator{result}};
+
+    for (bool bit : {1, 0, 1, 0, 1, 1, 0, 1, 1}) {
+        *iter++ = bit;
+    }
+    ConstexprAssertEqual(iter.Position(), 1);
+    ConstexprAssertTrue(result.empty());
+
+    iter.Flush();
+    const std::vector<uint8_t> expected{{0b10110101, 0b1}};
+    ConstexprAssertEqual(result, expected);
+}
+EndConstexprTest;
+
+BeginConstexprTest(LittleEndianWordOutputBitIterTest, WriteBitsAcrossWords) {
+    std::vector<uint8_t> words;
+    std::vector<uint8_t> bytes;
+    auto word_iter = (words | koda::views::InsertFromBack |
+                      koda::views::LittleEndianWordOutput)
+                         .begin();
+    auto byte_iter = (bytes | koda::views::InsertFromBack |
+                      koda::views::LittleEndianOutput)
+                         .begin();
+
+    uint64_t value = 0x0123'4567'89AB'CDEF;
+    for (uint8_t count = 0; count <= 64; ++count, value = value * 3 + 7) {
+        word_iter.WriteBits(value, count);
+        byte_iter.WriteBits(value, count);
+    }
+    word_iter.Flush();
+    byte_iter.Flush();
+
+    ConstexprAssertEqual(words, bytes);
+}
+EndConstexprTest;
+
+BeginConstexprTest(LittleEndianWordOutputBitIterTest, BoundedRange) {
+    std::vector<uint8_t> result(9);
+    auto view = result | koda::views::LittleEndianWordOutput;
+
+    ConstexprAssertEqual(view.end() - view.begin(), 72);
+
+    uint64_t value = ~uint64_t{0};
+    uint8_t count = 64;
+    auto iter = koda::WriteBits(view.begin(), view.end(), value, count);
+    ConstexprAssertEqual(count, 0);
+    ConstexprAssertEqual(view.end() - iter, 8);
+
+    value = 0;
+    count = 10;
+    iter = koda::WriteBits(std::move(iter), view.end(), value, count);
+    ConstexprAssertEqual(count, 2);
+    ConstexprAssertEqual(iter, view.end());
+    iter.Flush();
+
+    const std::vector<uint8_t> expected{
+        {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x00}};
+    ConstexprAssertEqual(result, expected);
+}
+EndConstexprTest;
+
+static_assert(koda::BitWordInputIterator<
+              koda::LittleEndianWordInputBitIter<const uint8_t*>>);
+
+BeginConstexprTest(LittleEndianWordInputBitIterTest, ReadBits) {
+    const std::vector<uint8_t> bytes{{0b10110101, 0b01010101}};
+    auto view = bytes | koda::views::LittleEndianWordInput;
+    auto iter = view.begin();
+
+    ConstexprAssertEqual(iter.Available(), 16);
+    ConstexprAssertEqual(iter.Peek(3), 0b101);
+    ConstexprAssertEqual(iter.ReadBits(3), 0b101);
+    ConstexprAssertEqual(iter.Position(), 3);
+    ConstexprAssertEqual(iter.ReadBits(12), 0xAB6);
+    ConstexprAssertEqual(iter.Available(), 1);
+    ConstexprAssertEqual(iter.Position(), 7);
+    ConstexprAssertTrue(iter.Base() == std::next(bytes.begin()));
+    ConstexprAssertFalse(*iter++);
+    ConstexprAssertTrue(iter == view.end());
+    ConstexprAssertTrue(iter.Base() == bytes.end());
+}
+EndConstexprTest;
+
+BeginConstexprTest(LittleEndianWordInputBitIterTest, MatchesBitIterator) {
+    std::vector<uint8_t> bytes;
+    for (uint8_t i = 0; i < 37; ++i) {
+        bytes.push_back(i * 73 + 11);
+    }
+    auto word_view = bytes | koda::views::LittleEndianWordInput;
+    auto bit_view = bytes | koda::views::LittleEndianInput;
+
+    ConstexprAssertEqual(word_view, bit_view);
+}
+EndConstexprTest;
+
+static_assert(
+    koda::BitWordInputIterator<koda::BackwardWordInputBitIter<const uint8_t*>>);
+
+BeginConstexprTest(BackwardWordInputBitIterTest, ReadBits) {
+    const std::vector<uint8_t> bytes{{0b10110101, 0b01010101}};
+    koda::ranges::BackwardWordInputView view{bytes, 3};
+    auto iter = view.begin();
+
+    ConstexprAssertEqual(iter.Available(), 13);
+    ConstexprAssertEqual(iter.Peek(5), 0b10101);
+    ConstexprAssertEqual(iter.ReadBits(5), 0b10101);
+    ConstexprAssertEqual(iter.ReadBits(7), 0b0101101);
+    ConstexprAssertEqual(iter.Available(), 1);
+    ConstexprAssertTrue(*iter++);
+    ConstexprAssertTrue(iter == view.end());
+}
+EndConstexprTest;
+
+BeginConstexprTest(BackwardWordInputBitIterTest, MatchesReversedBitIterator) {
+    std::vector<uint8_t> bytes;
+    for (uint8_t i = 0; i < 37; ++i) {
+        bytes.push_back(i * 73 + 11);
+    }
+    std::vector<bool> bits;
+    for (bool bit : bytes | koda::views::LittleEndianInput) {
+        bits.push_back(bit);
+    }
+
+    ConstexprAssertEqual(bytes | koda::views::BackwardWordInput,
+                         bits | std::views::reverse);
+}
+EndConstexprTest;
+
+BeginConstexprTest(ReadBitsTest, ResumesOnTruncatedInput) {
+    const std::vector<uint8_t> bytes{{0b1100'1010}};
+    auto view = bytes | koda::views::LittleEndianWordInput;
+
+    uint64_t value = 0;
+    uint8_t received = 0;
+    auto iter = koda::ReadBits(view.begin(), view.end(), value, received, 12);
+
+    ConstexprAssertTrue(iter == view.end());
+    ConstexprAssertEqual(received, 8);
+    ConstexprAssertEqual(value, 0b1100'1010);
+}
+EndConstexprTest;